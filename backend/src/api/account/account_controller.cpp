@@ -1,48 +1,96 @@
 #include "api/account/account_controller.h"
 #include "api/shared/error_response.h"
 #include "api/shared/auth_middleware.h"
+#include "api/shared/async_handler.h"
+#include "api/shared/response_cache.h"
+#include "db/read_snapshot.h"
 #include "domain/account/account_utils.h"
 #include <crow/json.h>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
 #include <ctime>
+#include <exception>
+#include <cctype>
 
-AccountController::AccountController(std::shared_ptr<Database> db) 
-    : db_(db),
+AccountController::AccountController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor) 
+    : executor_(executor),
+      db_(db),
       accountRepository_(std::make_unique<AccountRepository>(db)),
-      userRepository_(std::make_unique<UserRepository>(db)) {}
+      userRepository_(std::make_unique<UserRepository>(db)),
+      transactionRepository_(std::make_unique<TransactionRepository>(db)),
+      activityRepository_(std::make_unique<AccountActivityRepository>(db)),
+      accountNumberAllocator_(std::make_unique<AccountNumberAllocator>(db)) {}
 
 void AccountController::registerRoutes(crow::App<crow::CORSHandler>& app) {
     // Account routes
     CROW_ROUTE(app, "/api/v1/accounts")
         .methods("GET"_method)
-        ([this](const crow::request& req) { return getAccounts(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            if (ResponseCache::getInstance().serve(req, res)) {
+                return;
+            }
+            dispatchToDb(*executor_, req, res, [this, &req] { return getAccounts(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/accounts/<int>")
         .methods("GET"_method)
-        ([this](const crow::request& req, int accountId) { return getAccount(req, accountId); });
+        ([this](const crow::request& req, crow::response& res, int accountId) {
+            if (ResponseCache::getInstance().serve(req, res)) {
+                return;
+            }
+            dispatchToDb(*executor_, req, res, [this, &req, accountId] { return getAccount(req, accountId); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/accounts/<int>/balance")
+        .methods("GET"_method)
+        ([this](const crow::request& req, crow::response& res, int accountId) {
+            dispatchToDb(*executor_, req, res, [this, &req, accountId] { return getBalanceAt(req, accountId); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/accounts/<int>/summary")
+        .methods("GET"_method)
+        ([this](const crow::request& req, crow::response& res, int accountId) {
+            dispatchToDb(*executor_, req, res, [this, &req, accountId] { return getActivitySummary(req, accountId); });
+        });
     
     CROW_ROUTE(app, "/api/v1/accounts")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return createAccount(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return createAccount(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/accounts/<int>/transfer")
         .methods("POST"_method)
-        ([this](const crow::request& req, int accountId) { return transfer(req, accountId); });
+        ([this](const crow::request& req, crow::response& res, int accountId) {
+            dispatchToDb(*executor_, req, res, [this, &req, accountId] { return transfer(req, accountId); });
+        });
 }
 
 crow::response AccountController::getAccounts(const crow::request& req) {
     REQUIRE_AUTH(req)
     
+    // Versions as of before the read
+    auto& cache = ResponseCache::getInstance();
+    auto tag = session->isAdmin ? cache.allTag() : cache.userTag(session->userId);
+    
+    // Only committed balances may be cached: a write that rolls back bumps
+    // no tag, so a body read from it on the shared connection would stay
+    std::unique_ptr<ReadSnapshot> snapshot;
+    try {
+        snapshot = db_->openReadSnapshot();
+    } catch (const std::exception& e) {
+        return errorResponse(500, "Failed to read accounts");
+    }
+    
     std::vector<Account> accounts;
     
     // Admin can see all accounts
     if (session->isAdmin) {
-        accounts = accountRepository_->findAll();
+        accounts = accountRepository_->findAll(*snapshot);
     } else {
         // Regular users see only their accounts
-        accounts = accountRepository_->findByUserId(session->userId);
+        accounts = accountRepository_->findByUserId(*snapshot, session->userId);
     }
     
     crow::json::wvalue response;
@@ -59,23 +107,156 @@ crow::response AccountController::getAccounts(const crow::request& req) {
     }
     response["totalBalance"] = AccountUtils::roundToTwoDecimals(totalBalance);
     
-    return successResponse(response);
+    return cache.store(req, session->userId, tag, successResponse(response));
 }
 
 crow::response AccountController::getAccount(const crow::request& req, int accountId) {
     REQUIRE_AUTH(req)
     
-    auto account = accountRepository_->findById(accountId);
+    auto& cache = ResponseCache::getInstance();
+    auto tag = cache.accountTag(accountId);
+    
+    // Committed state only, as in getAccounts
+    std::unique_ptr<ReadSnapshot> snapshot;
+    try {
+        snapshot = db_->openReadSnapshot();
+    } catch (const std::exception& e) {
+        return errorResponse(500, "Failed to read account");
+    }
+    
+    auto account = accountRepository_->findById(*snapshot, accountId);
     if (!account) {
         return errorResponse(404, "Account not found");
     }
     
     // Check access rights
-    if (!session->isAdmin && account->getUserId() != session->userId) {
+    if (!session->isAdmin && !session->ownsAccount(account->getId())) {
         return errorResponse(403, "Access denied");
     }
     
     crow::json::wvalue response = accountToJson(*account);
+    return cache.store(req, session->userId, tag, successResponse(response));
+}
+
+crow::response AccountController::getBalanceAt(const crow::request& req, int accountId) {
+    REQUIRE_AUTH(req)
+    
+    // "YYYY-MM-DD" means the end of that day; a time may follow after a space or "T"
+    const char* atParam = req.url_params.get("at");
+    std::string at = atParam ? atParam : "";
+    if (at.size() == 10) {
+        at += " 23:59:59";
+    } else if (at.size() >= 19 && at[10] == 'T') {
+        at[10] = ' ';
+    }
+    
+    if (at.size() < 19 || at[4] != '-' || at[7] != '-' || at[10] != ' ' || at[13] != ':') {
+        return errorResponse(400, "Query parameter 'at' must be YYYY-MM-DD or YYYY-MM-DD HH:MM:SS");
+    }
+    at.resize(19);
+    
+    auto account = accountRepository_->findById(accountId);
+    if (!account) {
+        return errorResponse(404, "Account not found");
+    }
+    
+    if (!session->isAdmin && !session->ownsAccount(account->getId())) {
+        return errorResponse(403, "Access denied");
+    }
+    
+    // Before the account existed its balance was zero; with no recorded
+    // movement around the timestamp it is still the current balance
+    double balance = 0.0;
+    if (at >= account->getCreatedAt()) {
+        balance = transactionRepository_->findBalanceAt(accountId, at).value_or(account->getBalance());
+    }
+    
+    crow::json::wvalue response;
+    response["accountId"] = account->getId();
+    response["accountNumber"] = account->getAccountNumber();
+    response["at"] = at;
+    response["balance"] = AccountUtils::roundToTwoDecimals(balance);
+    response["formattedBalance"] = AccountUtils::formatCurrency(balance);
+    
+    return successResponse(response);
+}
+
+crow::response AccountController::getActivitySummary(const crow::request& req, int accountId) {
+    REQUIRE_AUTH(req)
+    
+    // Defaults: daily buckets for the year up to today (UTC)
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    char today[11];
+    std::strftime(today, sizeof(today), "%Y-%m-%d", &utc);
+    
+    const char* toParam = req.url_params.get("to");
+    std::string to = toParam ? toParam : today;
+    const char* fromParam = req.url_params.get("from");
+    std::string from = fromParam ? fromParam : "";
+    if (from.empty() && isValidDay(to)) {
+        from = std::to_string(std::stoi(to.substr(0, 4)) - 1) + to.substr(4);
+    }
+    const char* granularityParam = req.url_params.get("granularity");
+    auto granularity = stringToActivityGranularity(granularityParam ? granularityParam : "day");
+    
+    if (!isValidDay(from) || !isValidDay(to) || from > to) {
+        return errorResponse(400, "'from' and 'to' must be YYYY-MM-DD with from <= to");
+    }
+    
+    if (!granularity) {
+        return errorResponse(400, "'granularity' must be day or month");
+    }
+    
+    auto account = accountRepository_->findById(accountId);
+    if (!account) {
+        return errorResponse(404, "Account not found");
+    }
+    
+    if (!session->isAdmin && !session->ownsAccount(account->getId())) {
+        return errorResponse(403, "Access denied");
+    }
+    
+    auto buckets = activityRepository_->findBuckets(accountId, from, to, *granularity);
+    
+    crow::json::wvalue response;
+    response["accountId"] = account->getId();
+    response["accountNumber"] = account->getAccountNumber();
+    response["from"] = from;
+    response["to"] = to;
+    response["granularity"] = activityGranularityToString(*granularity);
+    response["buckets"] = crow::json::wvalue(crow::json::type::List);
+    
+    int64_t creditCents = 0;
+    int64_t debitCents = 0;
+    int creditCount = 0;
+    int debitCount = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        const auto& bucket = buckets[i];
+        auto& json = response["buckets"][i];
+        json["period"] = bucket.period;
+        json["credits"] = AccountUtils::fromCents(bucket.creditCents);
+        json["debits"] = AccountUtils::fromCents(bucket.debitCents);
+        json["net"] = AccountUtils::fromCents(bucket.netCents());
+        json["creditCount"] = bucket.creditCount;
+        json["debitCount"] = bucket.debitCount;
+        if (bucket.closingBalanceCents.has_value()) {
+            json["closingBalance"] = AccountUtils::fromCents(bucket.closingBalanceCents.value());
+        }
+        
+        creditCents += bucket.creditCents;
+        debitCents += bucket.debitCents;
+        creditCount += bucket.creditCount;
+        debitCount += bucket.debitCount;
+    }
+    
+    response["totals"]["credits"] = AccountUtils::fromCents(creditCents);
+    response["totals"]["debits"] = AccountUtils::fromCents(debitCents);
+    response["totals"]["net"] = AccountUtils::fromCents(creditCents - debitCents);
+    response["totals"]["creditCount"] = creditCount;
+    response["totals"]["debitCount"] = debitCount;
+    
     return successResponse(response);
 }
 
@@ -112,20 +293,24 @@ crow::response AccountController::createAccount(const crow::request& req) {
         }
     }
     
-    // Generate unique account number
-    std::string accountNumber;
-    do {
-        accountNumber = AccountUtils::generateAccountNumber();
-    } while (accountRepository_->existsByAccountNumber(accountNumber));
+    // Allocate a unique account number
+    auto accountNumber = accountNumberAllocator_->allocate();
+    if (!accountNumber) {
+        return errorResponse(500, "Failed to allocate account number");
+    }
     
     // Create account
-    Account newAccount(userId, accountNumber, accountType, initialBalance);
+    Account newAccount(userId, *accountNumber, accountType, initialBalance);
     auto createdAccount = accountRepository_->create(newAccount);
     
     if (!createdAccount) {
         return errorResponse(500, "Failed to create account");
     }
     
+    // Let the owner's live sessions see the new account without logging in again
+    AuthMiddleware::getInstance().grantAccount(userId, createdAccount->getId());
+    ResponseCache::getInstance().accountChanged(*createdAccount);
+    
     crow::json::wvalue response = accountToJson(*createdAccount);
     response["message"] = "Account created successfully";
     
@@ -155,7 +340,7 @@ crow::response AccountController::transfer(const crow::request& req, int account
     }
     
     // Check ownership
-    if (!session->isAdmin && fromAccount->getUserId() != session->userId) {
+    if (!session->isAdmin && !session->ownsAccount(fromAccount->getId())) {
         return errorResponse(403, "Access denied");
     }
     
@@ -177,43 +362,73 @@ crow::response AccountController::transfer(const crow::request& req, int account
         return crow::response(400, response);
     }
     
-    // Begin transaction
+    // Process transfer
+    auto updated = processTransfer(fromAccount->getId(), toAccount->getId(), amount, description);
+    if (!updated) {
+        return errorResponse(500, "Failed to complete transfer");
+    }
+    fromAccount = updated->first;
+    toAccount = updated->second;
+    
+    crow::json::wvalue response;
+    response["message"] = "Transfer completed successfully";
+    response["transferDetails"]["from"]["accountNumber"] = fromAccount->getAccountNumber();
+    response["transferDetails"]["from"]["newBalance"] = AccountUtils::roundToTwoDecimals(fromAccount->getBalance());
+    response["transferDetails"]["to"]["accountNumber"] = toAccount->getAccountNumber();
+    response["transferDetails"]["to"]["newBalance"] = AccountUtils::roundToTwoDecimals(toAccount->getBalance());
+    response["transferDetails"]["amount"] = AccountUtils::roundToTwoDecimals(amount);
+    response["transferDetails"]["description"] = description;
+    // Create timestamp
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    std::stringstream timestamp;
+    timestamp << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    
+    response["transferDetails"]["timestamp"] = timestamp.str();
+    
+    return successResponse(response);
+}
+
+std::optional<std::pair<Account, Account>> AccountController::processTransfer(int fromAccountId, int toAccountId,
+                                                                             double amount, const std::string& description) {
+    // Same write as the transactions API: balances and the ledger row commit
+    // together, so balance history, statements and sync see every transfer
     if (!db_->beginTransaction()) {
-        return errorResponse(500, "Failed to start transaction");
+        return std::nullopt;
+    }
+    
+    // Re-read both accounts inside the transaction
+    auto fromAccount = accountRepository_->findById(fromAccountId);
+    auto toAccount = accountRepository_->findById(toAccountId);
+    
+    if (!fromAccount || !toAccount || !fromAccount->canWithdraw(amount)) {
+        db_->rollback();
+        return std::nullopt;
     }
     
-    // Perform transfer
     fromAccount->withdraw(amount);
     toAccount->deposit(amount);
     
-    // Update both accounts
-    bool success = accountRepository_->update(*fromAccount) && 
-                   accountRepository_->update(*toAccount);
+    if (!accountRepository_->update(*fromAccount) || !accountRepository_->update(*toAccount)) {
+        db_->rollback();
+        return std::nullopt;
+    }
     
-    if (success) {
-        db_->commit();
-        
-        crow::json::wvalue response;
-        response["message"] = "Transfer completed successfully";
-        response["transferDetails"]["from"]["accountNumber"] = fromAccount->getAccountNumber();
-        response["transferDetails"]["from"]["newBalance"] = AccountUtils::roundToTwoDecimals(fromAccount->getBalance());
-        response["transferDetails"]["to"]["accountNumber"] = toAccount->getAccountNumber();
-        response["transferDetails"]["to"]["newBalance"] = AccountUtils::roundToTwoDecimals(toAccount->getBalance());
-        response["transferDetails"]["amount"] = AccountUtils::roundToTwoDecimals(amount);
-        response["transferDetails"]["description"] = description;
-        // Create timestamp
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream timestamp;
-        timestamp << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-        
-        response["transferDetails"]["timestamp"] = timestamp.str();
-        
-        return successResponse(response);
-    } else {
+    Transaction transaction(fromAccountId, toAccountId, amount, TransactionType::Transfer, description);
+    transaction.setBalancesAfter(fromAccount->getBalance(), toAccount->getBalance());
+    
+    if (!transactionRepository_->create(transaction)) {
         db_->rollback();
-        return errorResponse(500, "Failed to complete transfer");
+        return std::nullopt;
+    }
+    
+    if (!db_->commit()) {
+        db_->rollback();
+        return std::nullopt;
     }
+    ResponseCache::getInstance().accountChanged(*fromAccount);
+    ResponseCache::getInstance().accountChanged(*toAccount);
+    return std::make_pair(*fromAccount, *toAccount);
 }
 
 bool AccountController::validateTransferRequest(const crow::json::rvalue& body, 
@@ -252,3 +467,15 @@ crow::json::wvalue AccountController::accountToJson(const Account& account) {
     
     return json;
 }
+
+bool AccountController::isValidDay(const std::string& day) {
+    if (day.size() != 10 || day[4] != '-' || day[7] != '-') {
+        return false;
+    }
+    for (size_t i = 0; i < day.size(); ++i) {
+        if (i != 4 && i != 7 && !std::isdigit(static_cast<unsigned char>(day[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
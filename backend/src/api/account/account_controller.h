@@ -3,28 +3,48 @@
 #include <crow.h>
 #include <crow/middlewares/cors.h>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 #include "repository/account/account_repository.h"
 #include "repository/user/user_repository.h"
+#include "repository/transaction/transaction_repository.h"
+#include "repository/account/account_activity_repository.h"
+#include "repository/account/account_number_allocator.h"
 #include "db/db.h"
+#include "db/db_executor.h"
 
 class AccountController {
 public:
-    AccountController(std::shared_ptr<Database> db);
+    AccountController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor);
     
     void registerRoutes(crow::App<crow::CORSHandler>& app);
     
 private:
+    std::shared_ptr<DbExecutor> executor_;
     std::shared_ptr<Database> db_;
     std::unique_ptr<AccountRepository> accountRepository_;
     std::unique_ptr<UserRepository> userRepository_;
+    std::unique_ptr<TransactionRepository> transactionRepository_;
+    std::unique_ptr<AccountActivityRepository> activityRepository_;
+    std::unique_ptr<AccountNumberAllocator> accountNumberAllocator_;
     
     // Account endpoints
     crow::response getAccounts(const crow::request& req);
     crow::response getAccount(const crow::request& req, int accountId);
+    crow::response getBalanceAt(const crow::request& req, int accountId);
+    crow::response getActivitySummary(const crow::request& req, int accountId);
     crow::response createAccount(const crow::request& req);
     crow::response transfer(const crow::request& req, int accountId);
     
+    // Move amount between two accounts and record the transfer on the
+    // ledger in one DB transaction; the updated accounts, or nothing if
+    // it failed
+    std::optional<std::pair<Account, Account>> processTransfer(int fromAccountId, int toAccountId, double amount,
+                                                               const std::string& description);
+    
     // Helper methods
     bool validateTransferRequest(const crow::json::rvalue& body, double& amount, std::string& toAccountNumber, std::string& description);
     crow::json::wvalue accountToJson(const Account& account);
+    static bool isValidDay(const std::string& day);
 };
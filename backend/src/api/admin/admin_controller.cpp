@@ -1,13 +1,23 @@
 #include "api/admin/admin_controller.h"
 #include "api/shared/error_response.h"
 #include "api/shared/auth_middleware.h"
+#include "api/shared/account_event_bus.h"
+#include "api/shared/async_handler.h"
+#include "api/shared/response_cache.h"
 #include "domain/account/account_utils.h"
 #include "domain/transaction/transaction_utils.h"
+#include "repository/transaction/transaction_importer.h"
+#include "logging/logger.h"
+#include "utils/metrics.h"
 #include <crow/json.h>
 #include <iostream>
+#include <streambuf>
+#include <unordered_map>
+#include <unordered_set>
 
-AdminController::AdminController(std::shared_ptr<Database> db) 
-    : db_(db),
+AdminController::AdminController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor) 
+    : executor_(executor),
+      db_(db),
       userRepository_(std::make_unique<UserRepository>(db)),
       accountRepository_(std::make_unique<AccountRepository>(db)),
       transactionRepository_(std::make_unique<TransactionRepository>(db)) {}
@@ -16,19 +26,103 @@ void AdminController::registerRoutes(crow::App<crow::CORSHandler>& app) {
     // Admin routes
     CROW_ROUTE(app, "/api/v1/admin/users")
         .methods("GET"_method)
-        ([this](const crow::request& req) { return getUsersWithBalances(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return getUsersWithBalances(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/admin/deposit")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return adminDeposit(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return adminDeposit(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/admin/withdraw")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return adminWithdraw(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return adminWithdraw(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/admin/transfer")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return adminTransfer(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return adminTransfer(req); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/admin/disburse")
+        .methods("POST"_method)
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return disburse(req); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/admin/import")
+        .methods("POST"_method)
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return importTransactions(req); });
+        });
+    
+    // Served inline: reads only in-memory counters, so it stays available
+    // when the DB executor is saturated
+    CROW_ROUTE(app, "/api/v1/admin/metrics")
+        .methods("GET"_method)
+        ([this](const crow::request& req) {
+            return getMetrics(req);
+        });
+    
+    // Also inline: changing the log level must work on a saturated server
+    CROW_ROUTE(app, "/api/v1/admin/log-level")
+        .methods("GET"_method, "PUT"_method)
+        ([this](const crow::request& req) {
+            return req.method == crow::HTTPMethod::Put ? setLogLevel(req) : getLogLevel(req);
+        });
+}
+
+crow::response AdminController::getLogLevel(const crow::request& req) {
+    REQUIRE_ADMIN(req)
+    
+    crow::json::wvalue response;
+    response["level"] = std::string(kLogLevelCodec.name(Logger::getInstance().level()));
+    return successResponse(response);
+}
+
+crow::response AdminController::setLogLevel(const crow::request& req) {
+    REQUIRE_ADMIN(req)
+    
+    auto body = crow::json::load(req.body);
+    if (!body) {
+        return errorResponse(400, "Invalid JSON");
+    }
+    
+    if (!body.has("level")) {
+        return errorResponse(400, "Level is required");
+    }
+    
+    auto level = kLogLevelCodec.parse(std::string(body["level"].s()));
+    if (!level) {
+        return errorResponse(400, "Level must be one of debug, info, warn, error, off");
+    }
+    
+    Logger::getInstance().setLevel(*level);
+    LOG_INFO("Log level changed", "level", kLogLevelCodec.name(*level), "by", session->username);
+    
+    crow::json::wvalue response;
+    response["level"] = std::string(kLogLevelCodec.name(*level));
+    return successResponse(response);
+}
+
+crow::response AdminController::getMetrics(const crow::request& req) {
+    REQUIRE_ADMIN(req)
+    
+    auto& metrics = Metrics::getInstance();
+    crow::json::wvalue response;
+    for (size_t i = 0; i < static_cast<size_t>(Counter::Count); ++i) {
+        auto counter = static_cast<Counter>(i);
+        response["counters"][counterName(counter)] = metrics.get(counter);
+    }
+    response["queue_depth"]["read"] = executor_->queueDepth(DbLane::Read);
+    response["queue_depth"]["write"] = executor_->queueDepth(DbLane::Write);
+    response["stream_subscribers"] = AccountEventBus::getInstance().subscriberCount();
+    
+    return successResponse(response);
 }
 
 crow::response AdminController::getUsersWithBalances(const crow::request& req) {
@@ -91,17 +185,18 @@ crow::response AdminController::adminDeposit(const crow::request& req) {
         return errorResponse(404, "Account not found");
     }
     
+    // Get user info
+    auto user = userRepository_->findById(account->getUserId());
+    if (!user) {
+        return errorResponse(404, "Account owner not found");
+    }
+    
     // Process deposit
-    if (!processAdminDeposit(accountNumber, amount, description)) {
+    account = processAdminDeposit(accountNumber, amount, description);
+    if (!account) {
         return errorResponse(500, "Failed to process deposit");
     }
     
-    // Get updated account
-    account = accountRepository_->findByAccountNumber(accountNumber);
-    
-    // Get user info
-    auto user = userRepository_->findById(account->getUserId());
-    
     crow::json::wvalue response;
     response["message"] = "Admin deposit successful";
     response["transactionDetails"]["accountNumber"] = account->getAccountNumber();
@@ -157,17 +252,18 @@ crow::response AdminController::adminWithdraw(const crow::request& req) {
         return crow::response(400, error);
     }
     
+    // Get user info
+    auto user = userRepository_->findById(account->getUserId());
+    if (!user) {
+        return errorResponse(404, "Account owner not found");
+    }
+    
     // Process withdrawal
-    if (!processAdminWithdrawal(accountNumber, amount, description)) {
+    account = processAdminWithdrawal(accountNumber, amount, description);
+    if (!account) {
         return errorResponse(500, "Failed to process withdrawal");
     }
     
-    // Get updated account
-    account = accountRepository_->findByAccountNumber(accountNumber);
-    
-    // Get user info
-    auto user = userRepository_->findById(account->getUserId());
-    
     crow::json::wvalue response;
     response["message"] = "Admin withdrawal successful";
     response["transactionDetails"]["accountNumber"] = account->getAccountNumber();
@@ -234,18 +330,20 @@ crow::response AdminController::adminTransfer(const crow::request& req) {
         return crow::response(400, error);
     }
     
-    // Process transfer
-    if (!processAdminTransfer(fromAccountNumber, toAccountNumber, amount, description)) {
-        return errorResponse(500, "Failed to process transfer");
-    }
-    
-    // Get updated accounts
-    fromAccount = accountRepository_->findByAccountNumber(fromAccountNumber);
-    toAccount = accountRepository_->findByAccountNumber(toAccountNumber);
-    
     // Get user info
     auto fromUser = userRepository_->findById(fromAccount->getUserId());
     auto toUser = userRepository_->findById(toAccount->getUserId());
+    if (!fromUser || !toUser) {
+        return errorResponse(404, "Account owner not found");
+    }
+    
+    // Process transfer
+    auto updated = processAdminTransfer(fromAccountNumber, toAccountNumber, amount, description);
+    if (!updated) {
+        return errorResponse(500, "Failed to process transfer");
+    }
+    fromAccount = updated->first;
+    toAccount = updated->second;
     
     crow::json::wvalue response;
     response["message"] = "Admin transfer successful";
@@ -262,6 +360,235 @@ crow::response AdminController::adminTransfer(const crow::request& req) {
     return successResponse(response);
 }
 
+crow::response AdminController::disburse(const crow::request& req) {
+    REQUIRE_ADMIN(req)
+    
+    auto body = crow::json::load(req.body);
+    if (!body) {
+        return errorResponse(400, "Invalid JSON");
+    }
+    
+    if (!body.has("fromAccountNumber") || !body.has("credits") || body["credits"].t() != crow::json::type::List) {
+        return errorResponse(400, "From account number and credits array are required");
+    }
+    
+    std::string fromAccountNumber = body["fromAccountNumber"].s();
+    std::string description = body.has("description") ? 
+        std::string(body["description"].s()) : "Disbursement";
+    
+    const auto& credits = body["credits"];
+    if (credits.size() == 0) {
+        return errorResponse(400, "Credits array is empty");
+    }
+    if (credits.size() > kMaxDisbursementLines) {
+        return errorResponse(400, "Too many credit lines (max " + std::to_string(kMaxDisbursementLines) + ")");
+    }
+    
+    // Parse lines into flat arrays; amounts are kept as integer cents so the
+    // total is exact
+    std::vector<std::string> accountNumbers;
+    std::vector<int64_t> cents;
+    std::vector<std::string> descriptions;
+    accountNumbers.reserve(credits.size());
+    cents.reserve(credits.size());
+    descriptions.reserve(credits.size());
+    
+    crow::json::wvalue invalid;
+    size_t invalidCount = 0;
+    for (size_t i = 0; i < credits.size(); ++i) {
+        const auto& line = credits[i];
+        bool valid = line.t() == crow::json::type::Object && line.has("accountNumber") && line.has("amount") &&
+                     AccountUtils::isValidAmount(line["amount"].d());
+        if (!valid) {
+            if (invalidCount < 100) {
+                invalid[invalidCount] = i;
+            }
+            ++invalidCount;
+            continue;
+        }
+        
+        accountNumbers.push_back(line["accountNumber"].s());
+        cents.push_back(AccountUtils::toCents(line["amount"].d()));
+        descriptions.push_back(line.has("description") ? std::string(line["description"].s()) : description);
+    }
+    
+    if (invalidCount > 0) {
+        crow::json::wvalue error;
+        error["error"] = "Invalid credit lines (accountNumber and a positive amount with at most 2 decimals are required)";
+        error["invalidLineCount"] = invalidCount;
+        error["invalidLines"] = std::move(invalid);
+        return crow::response(400, error);
+    }
+    
+    int64_t totalCents = AccountUtils::sumCents(cents);
+    double total = AccountUtils::fromCents(totalCents);
+    
+    if (!db_->beginTransaction()) {
+        return errorResponse(500, "Failed to process disbursement");
+    }
+    
+    auto fromAccount = accountRepository_->findByAccountNumber(fromAccountNumber);
+    if (!fromAccount) {
+        db_->rollback();
+        return errorResponse(404, "Source account not found");
+    }
+    
+    // One funds check for the whole run
+    if (!fromAccount->canWithdraw(total)) {
+        db_->rollback();
+        crow::json::wvalue error;
+        error["error"] = "Insufficient funds";
+        error["currentBalance"] = fromAccount->getBalance();
+        error["requestedAmount"] = total;
+        if (fromAccount->getAccountType() == AccountType::Savings) {
+            error["minimumBalance"] = 25.0;
+        }
+        return crow::response(400, error);
+    }
+    
+    // Resolve every credit account in one pass
+    std::unordered_set<std::string> uniqueNumbers(accountNumbers.begin(), accountNumbers.end());
+    std::unordered_map<std::string, int> accountIds;
+    std::unordered_map<int, int64_t> runningCents;   // account id -> balance as lines are recorded
+    std::unordered_map<int, int> ownerIds;           // account id -> user id
+    for (const auto& account : accountRepository_->findByAccountNumbers(
+             std::vector<std::string>(uniqueNumbers.begin(), uniqueNumbers.end()))) {
+        accountIds.emplace(account.getAccountNumber(), account.getId());
+        runningCents.emplace(account.getId(), AccountUtils::toCents(account.getBalance()));
+        ownerIds.emplace(account.getId(), account.getUserId());
+    }
+    
+    std::vector<int> creditIds(accountNumbers.size());
+    std::unordered_map<int, int64_t> creditCents;
+    for (size_t i = 0; i < accountNumbers.size(); ++i) {
+        auto it = accountIds.find(accountNumbers[i]);
+        std::string lineError;
+        if (it == accountIds.end()) {
+            lineError = "Destination account not found";
+        } else if (it->second == fromAccount->getId()) {
+            lineError = "Cannot transfer to the same account";
+        }
+        
+        if (!lineError.empty()) {
+            db_->rollback();
+            crow::json::wvalue error;
+            error["error"] = "Line " + std::to_string(i) + ": " + lineError;
+            error["failedLine"] = i;
+            return crow::response(400, error);
+        }
+        
+        creditIds[i] = it->second;
+        creditCents[it->second] += cents[i];
+    }
+    
+    // Debit the source once, then credit each destination once
+    int64_t fromCents = AccountUtils::toCents(fromAccount->getBalance());
+    fromAccount->withdraw(total);
+    
+    std::vector<std::pair<int, double>> deltas;
+    deltas.reserve(creditCents.size());
+    for (const auto& [accountId, amountCents] : creditCents) {
+        deltas.emplace_back(accountId, AccountUtils::fromCents(amountCents));
+    }
+    
+    std::vector<Transaction> records;
+    records.reserve(accountNumbers.size());
+    for (size_t i = 0; i < accountNumbers.size(); ++i) {
+        records.emplace_back(fromAccount->getId(), creditIds[i], AccountUtils::fromCents(cents[i]),
+                             TransactionType::Transfer, descriptions[i]);
+        
+        // Each line records the balances as if the lines were applied one by one
+        fromCents -= cents[i];
+        int64_t& toCents = runningCents[creditIds[i]];
+        toCents += cents[i];
+        records.back().setBalancesAfter(AccountUtils::fromCents(fromCents), AccountUtils::fromCents(toCents));
+    }
+    
+    std::optional<std::vector<int>> ids;
+    if (accountRepository_->update(*fromAccount) && accountRepository_->adjustBalances(deltas)) {
+        ids = transactionRepository_->createBatch(records);
+    }
+    
+    if (!ids || !db_->commit()) {
+        db_->rollback();
+        return errorResponse(500, "Failed to process disbursement");
+    }
+    
+    auto& cache = ResponseCache::getInstance();
+    cache.accountChanged(*fromAccount);
+    for (const auto& [accountId, amountCents] : creditCents) {
+        cache.accountChanged(accountId, ownerIds.at(accountId));
+    }
+    
+    crow::json::wvalue response;
+    response["message"] = "Disbursement successful";
+    response["disbursement"]["fromAccountNumber"] = fromAccount->getAccountNumber();
+    response["disbursement"]["newBalance"] = AccountUtils::roundToTwoDecimals(fromAccount->getBalance());
+    response["disbursement"]["lineCount"] = records.size();
+    response["disbursement"]["total"] = total;
+    response["disbursement"]["firstTransactionId"] = ids->front();
+    response["disbursement"]["lastTransactionId"] = ids->back();
+    response["disbursement"]["description"] = description;
+    response["disbursement"]["adminUser"] = session->username;
+    
+    return successResponse(response);
+}
+
+crow::response AdminController::importTransactions(const crow::request& req) {
+    REQUIRE_ADMIN(req)
+    
+    ImportOptions options;
+    const char* formatParam = req.url_params.get("format");
+    auto format = stringToTransactionFileFormat(formatParam ? formatParam : "csv");
+    if (!format) {
+        return errorResponse(400, "Format must be 'csv' or 'ndjson'");
+    }
+    options.format = *format;
+    
+    // Over HTTP the import is all-or-nothing; very large migrations should
+    // use the novabank_import tool, which commits in batches. The server is
+    // live, so the transaction indexes stay in place: customer queries on
+    // the reader lanes share this connection and would see them dropped.
+    options.atomic = true;
+    options.deferIndexes = false;
+    
+    // Read the body in place rather than copying it into a stringstream
+    struct BodyBuffer : std::streambuf {
+        explicit BodyBuffer(const std::string& body) {
+            char* data = const_cast<char*>(body.data());
+            setg(data, data, data + body.size());
+        }
+    };
+    BodyBuffer buffer(req.body);
+    std::istream input(&buffer);
+    
+    TransactionImporter importer(db_, options);
+    ImportResult result = importer.run(input);
+    if (result.rowsImported > 0) {
+        ResponseCache::getInstance().clear();
+    }
+    
+    crow::json::wvalue response;
+    response["import"]["rowsRead"] = result.rowsRead;
+    response["import"]["rowsImported"] = result.rowsImported;
+    response["import"]["rowsRejected"] = result.rowsRejected;
+    response["import"]["accountsUpdated"] = result.accountsUpdated;
+    for (size_t i = 0; i < result.rejections.size(); ++i) {
+        response["import"]["rejections"][i] = result.rejections[i];
+    }
+    
+    // Bad input (nothing readable, or rows that failed validation, which
+    // roll back the whole import) is the client's to fix
+    if (!result.success) {
+        response["error"] = result.error;
+        return crow::response(result.rowsRead == 0 || result.rowsRejected > 0 ? 400 : 500, response);
+    }
+    
+    response["message"] = "Import complete";
+    response["import"]["adminUser"] = session->username;
+    return successResponse(response);
+}
+
 crow::json::wvalue AdminController::userWithBalanceToJson(const User& user) {
     crow::json::wvalue json;
     json["id"] = user.getId();
@@ -293,15 +620,15 @@ crow::json::wvalue AdminController::userWithBalanceToJson(const User& user) {
     return json;
 }
 
-bool AdminController::processAdminDeposit(const std::string& accountNumber, double amount, const std::string& description) {
+std::optional<Account> AdminController::processAdminDeposit(const std::string& accountNumber, double amount, const std::string& description) {
     auto account = accountRepository_->findByAccountNumber(accountNumber);
     if (!account) {
-        return false;
+        return std::nullopt;
     }
     
     // Begin transaction
     if (!db_->beginTransaction()) {
-        return false;
+        return std::nullopt;
     }
     
     try {
@@ -309,39 +636,42 @@ bool AdminController::processAdminDeposit(const std::string& accountNumber, doub
         account->deposit(amount);
         if (!accountRepository_->update(*account)) {
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         // Create transaction record
         Transaction transaction(std::nullopt, account->getId(), amount, 
                               TransactionType::Deposit, description);
+        transaction.setBalancesAfter(std::nullopt, account->getBalance());
         
         auto createdTransaction = transactionRepository_->create(transaction);
         if (!createdTransaction) {
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         if (!db_->commit()) {
-            return false;
+            db_->rollback();
+            return std::nullopt;
         }
         
-        return true;
+        ResponseCache::getInstance().accountChanged(*account);
+        return account;
     } catch (const std::exception& e) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
 }
 
-bool AdminController::processAdminWithdrawal(const std::string& accountNumber, double amount, const std::string& description) {
+std::optional<Account> AdminController::processAdminWithdrawal(const std::string& accountNumber, double amount, const std::string& description) {
     auto account = accountRepository_->findByAccountNumber(accountNumber);
     if (!account || !account->canWithdraw(amount)) {
-        return false;
+        return std::nullopt;
     }
     
     // Begin transaction
     if (!db_->beginTransaction()) {
-        return false;
+        return std::nullopt;
     }
     
     try {
@@ -349,43 +679,46 @@ bool AdminController::processAdminWithdrawal(const std::string& accountNumber, d
         account->withdraw(amount);
         if (!accountRepository_->update(*account)) {
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         // Create transaction record
         Transaction transaction(account->getId(), std::nullopt, amount, 
                               TransactionType::Withdrawal, description);
+        transaction.setBalancesAfter(account->getBalance(), std::nullopt);
         
         auto createdTransaction = transactionRepository_->create(transaction);
         if (!createdTransaction) {
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         if (!db_->commit()) {
-            return false;
+            db_->rollback();
+            return std::nullopt;
         }
         
-        return true;
+        ResponseCache::getInstance().accountChanged(*account);
+        return account;
     } catch (const std::exception& e) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
 }
 
-bool AdminController::processAdminTransfer(const std::string& fromAccountNumber, 
-                                          const std::string& toAccountNumber, 
-                                          double amount, const std::string& description) {
+std::optional<std::pair<Account, Account>> AdminController::processAdminTransfer(const std::string& fromAccountNumber, 
+                                                                                const std::string& toAccountNumber, 
+                                                                                double amount, const std::string& description) {
     auto fromAccount = accountRepository_->findByAccountNumber(fromAccountNumber);
     auto toAccount = accountRepository_->findByAccountNumber(toAccountNumber);
     
     if (!fromAccount || !toAccount || !fromAccount->canWithdraw(amount)) {
-        return false;
+        return std::nullopt;
     }
     
     // Begin transaction
     if (!db_->beginTransaction()) {
-        return false;
+        return std::nullopt;
     }
     
     try {
@@ -395,26 +728,30 @@ bool AdminController::processAdminTransfer(const std::string& fromAccountNumber,
         
         if (!accountRepository_->update(*fromAccount) || !accountRepository_->update(*toAccount)) {
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         // Create transaction record
         Transaction transaction(fromAccount->getId(), toAccount->getId(), amount, 
                               TransactionType::Transfer, description);
+        transaction.setBalancesAfter(fromAccount->getBalance(), toAccount->getBalance());
         
         auto createdTransaction = transactionRepository_->create(transaction);
         if (!createdTransaction) {
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         if (!db_->commit()) {
-            return false;
+            db_->rollback();
+            return std::nullopt;
         }
         
-        return true;
+        ResponseCache::getInstance().accountChanged(*fromAccount);
+        ResponseCache::getInstance().accountChanged(*toAccount);
+        return std::make_pair(*fromAccount, *toAccount);
     } catch (const std::exception& e) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
 }
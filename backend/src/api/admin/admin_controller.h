@@ -3,18 +3,23 @@
 #include <crow.h>
 #include <crow/middlewares/cors.h>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 #include "repository/user/user_repository.h"
 #include "repository/account/account_repository.h"
 #include "repository/transaction/transaction_repository.h"
 #include "db/db.h"
+#include "db/db_executor.h"
 
 class AdminController {
 public:
-    AdminController(std::shared_ptr<Database> db);
+    AdminController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor);
     
     void registerRoutes(crow::App<crow::CORSHandler>& app);
     
 private:
+    std::shared_ptr<DbExecutor> executor_;
     std::shared_ptr<Database> db_;
     std::unique_ptr<UserRepository> userRepository_;
     std::unique_ptr<AccountRepository> accountRepository_;
@@ -25,11 +30,21 @@ private:
     crow::response adminDeposit(const crow::request& req);
     crow::response adminWithdraw(const crow::request& req);
     crow::response adminTransfer(const crow::request& req);
+    crow::response disburse(const crow::request& req);
+    crow::response importTransactions(const crow::request& req);
+    crow::response getMetrics(const crow::request& req);
+    crow::response getLogLevel(const crow::request& req);
+    crow::response setLogLevel(const crow::request& req);
+    
+    // Upper bound on credit lines in one disbursement
+    static constexpr size_t kMaxDisbursementLines = 50000;
     
     // Helper methods
     crow::json::wvalue userWithBalanceToJson(const User& user);
-    bool processAdminDeposit(const std::string& accountNumber, double amount, const std::string& description);
-    bool processAdminWithdrawal(const std::string& accountNumber, double amount, const std::string& description);
-    bool processAdminTransfer(const std::string& fromAccountNumber, const std::string& toAccountNumber, 
-                             double amount, const std::string& description);
+    // Each returns the accounts as committed, or nothing if the write failed
+    std::optional<Account> processAdminDeposit(const std::string& accountNumber, double amount, const std::string& description);
+    std::optional<Account> processAdminWithdrawal(const std::string& accountNumber, double amount, const std::string& description);
+    std::optional<std::pair<Account, Account>> processAdminTransfer(const std::string& fromAccountNumber,
+                                                                    const std::string& toAccountNumber,
+                                                                    double amount, const std::string& description);
 };
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "api/shared/json_writer.h"
+#include "domain/account/account_utils.h"
+#include "domain/transaction/transaction.h"
+#include "domain/transaction/transaction_utils.h"
+#include "utils/metrics.h"
+#include "utils/timestamp.h"
+
+// In-process fan-out of committed money movements to live subscribers (the
+// /api/v1/stream websockets). AccountEventFeed publishes what change
+// capture reports as committed; each affected account's owner gets one JSON
+// message per account, built once and handed to every subscription of that
+// user.
+//
+// Sinks run on the publishing thread with the bus lock held, so they must be
+// cheap and must not call back into the bus; unsubscribe() waiting on that
+// lock is what makes it safe to destroy a sink's target once it returns.
+class AccountEventBus {
+public:
+    using Sink = std::function<void(const std::string& message)>;
+
+    static AccountEventBus& getInstance() {
+        static AccountEventBus instance;
+        return instance;
+    }
+
+    // Deliver the user's events to sink until unsubscribe(id)
+    uint64_t subscribe(int userId, Sink sink) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t id = nextId_++;
+        subscriptions_[userId].push_back(Subscription{ id, std::move(sink) });
+        userIds_.emplace(id, userId);
+        return id;
+    }
+
+    void unsubscribe(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto owner = userIds_.find(id);
+        if (owner == userIds_.end()) {
+            return;
+        }
+        auto user = subscriptions_.find(owner->second);
+        auto& list = user->second;
+        list.erase(std::find_if(list.begin(), list.end(),
+                                [id](const Subscription& subscription) { return subscription.id == id; }));
+        if (list.empty()) {
+            subscriptions_.erase(user);
+        }
+        userIds_.erase(owner);
+    }
+
+    // A committed transaction; the user ids own its from and to accounts
+    // (0 for a side it does not have). Its id and balance-after values must
+    // be set.
+    void publishTransaction(const Transaction& transaction, int fromUserId, int toUserId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto fromId = transaction.getFromAccountId(); fromId && hasSubscribers(fromUserId)) {
+            deliver(fromUserId, transactionMessage(transaction, fromId.value(),
+                                                   transaction.getFromBalanceAfter()));
+        }
+        if (auto toId = transaction.getToAccountId(); toId && hasSubscribers(toUserId)) {
+            deliver(toUserId, transactionMessage(transaction, toId.value(),
+                                                 transaction.getToBalanceAfter()));
+        }
+    }
+
+    // A balance that changed without a transaction record
+    void publishBalance(int accountId, int userId, double balance) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!hasSubscribers(userId)) {
+            return;
+        }
+        JsonWriter json;
+        json.beginObject();
+        json.key("event").value("balance");
+        json.key("accountId").value(accountId);
+        json.key("balance").value(AccountUtils::roundToTwoDecimals(balance));
+        json.endObject();
+        deliver(userId, std::string(json.view()));
+    }
+
+    size_t subscriberCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return userIds_.size();
+    }
+
+    AccountEventBus(const AccountEventBus&) = delete;
+    AccountEventBus& operator=(const AccountEventBus&) = delete;
+
+private:
+    struct Subscription {
+        uint64_t id;
+        Sink sink;
+    };
+
+    AccountEventBus() = default;
+
+    // Caller holds mutex_
+    bool hasSubscribers(int userId) const {
+        return userId > 0 && subscriptions_.count(userId) > 0;
+    }
+
+    // Caller holds mutex_
+    void deliver(int userId, const std::string& message) {
+        auto& list = subscriptions_.at(userId);
+        for (auto& subscription : list) {
+            subscription.sink(message);
+        }
+        Metrics::getInstance().increment(Counter::StreamMessagesSent, list.size());
+    }
+
+    // The movement as seen from one of its accounts
+    static std::string transactionMessage(const Transaction& transaction, int accountId,
+                                          std::optional<double> balanceAfter) {
+        double amount = transaction.getAmount();
+        int64_t createdAt = transaction.getCreatedAtSeconds() != Timestamp::kUnset
+            ? transaction.getCreatedAtSeconds()
+            : Timestamp::now();
+        char createdAtText[Timestamp::kFormattedSize];
+        char displayAmount[48];
+        std::snprintf(displayAmount, sizeof(displayAmount), "%s$%.2f",
+                      TransactionUtils::getAmountSign(transaction, accountId).c_str(), amount);
+
+        JsonWriter json;
+        json.beginObject();
+        json.key("event").value("transaction");
+        json.key("accountId").value(accountId);
+        if (balanceAfter.has_value()) {
+            json.key("balance").value(AccountUtils::roundToTwoDecimals(balanceAfter.value()));
+        }
+        json.key("transaction").beginObject();
+        json.key("id").value(transaction.getId());
+        json.key("type").value(kTransactionTypeCodec.name(transaction.getTransactionType()));
+        json.key("amount").value(AccountUtils::roundToTwoDecimals(amount));
+        json.key("direction").value(TransactionUtils::getTransactionDirection(transaction, accountId));
+        json.key("displayAmount").value(displayAmount);
+        json.key("description").value(transaction.getDescription());
+        json.key("createdAt").value(std::string_view(createdAtText, Timestamp::formatTo(createdAt, createdAtText)));
+        json.endObject();
+        json.endObject();
+        return std::string(json.view());
+    }
+
+    mutable std::mutex mutex_;
+    uint64_t nextId_ = 1;
+    std::unordered_map<int, std::vector<Subscription>> subscriptions_;   // by user id
+    std::unordered_map<uint64_t, int> userIds_;                          // subscription id -> user id
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <crow.h>
+#include <exception>
+#include <string>
+#include <utility>
+#include "api/shared/error_response.h"
+#include "api/shared/export_spool.h"
+#include "api/shared/request_class.h"
+#include "db/db_executor.h"
+#include "db/query_deadline.h"
+#include "utils/metrics.h"
+#include "utils/request_arena.h"
+
+// Run a synchronous controller method on the DB executor and complete the
+// Crow response when it finishes. The HTTP thread returns immediately; Crow
+// keeps the request alive until res.end() is called.
+//
+// The request's deadline starts counting at enqueue time. Work that is still
+// queued when it expires is answered with 503 without touching the database;
+// statements still running when it expires are interrupted and the request
+// is answered with 504. A successful commit disarms the deadline, so a write
+// that was saved is never reported as failed.
+//
+// The handler runs inside a RequestArena; its temporaries are released in
+// one step once the response is built (the response itself is heap-owned).
+template <typename Handler>
+void dispatchToDb(DbExecutor& executor, const RequestClass& cls, crow::response& res, Handler&& handler) {
+    auto budget = cls.budget.count() > 0 ? cls.budget : deadlineBudget(cls.priority);
+    auto deadline = QueryDeadline::Clock::now() + budget;
+
+    bool accepted = executor.submit(cls.lane, cls.priority,
+        [&res, deadline, handler = std::forward<Handler>(handler)]() mutable {
+            if (QueryDeadline::Clock::now() >= deadline) {
+                Metrics::getInstance().increment(Counter::DeadlineExpiredInQueue);
+                res = errorResponse(503, "Server busy, please retry");
+                res.set_header("Retry-After", "1");
+                res.end();
+                return;
+            }
+
+            {
+                QueryDeadline scope(deadline);
+                RequestArena arena;
+                try {
+                    res = handler();
+                } catch (const std::exception&) {
+                    res = errorResponse(500, "Internal server error");
+                }
+
+                if (QueryDeadline::aborted()) {
+                    Metrics::getInstance().increment(Counter::DeadlineExceeded);
+                    res = errorResponse(504, "Request deadline exceeded");
+                }
+            }
+
+            // Crow 1.0 writes a static file out in full inside end(), so a
+            // spooled export can be deleted as soon as it returns
+            std::string spooled = res.is_static_type() ? res.file_info.path : std::string();
+            res.end();
+            if (!spooled.empty()) {
+                ExportSpool::getInstance().release(spooled);
+            }
+        });
+
+    if (!accepted) {
+        Metrics::getInstance().increment(Counter::RequestsShed);
+        res = errorResponse(503, "Server busy, please retry");
+        res.set_header("Retry-After", "1");
+        res.end();
+    }
+}
+
+// Same as above, with the lane and priority derived from the route
+template <typename Handler>
+void dispatchToDb(DbExecutor& executor, const crow::request& req, crow::response& res, Handler&& handler) {
+    dispatchToDb(executor, classifyRequest(req), res, std::forward<Handler>(handler));
+}
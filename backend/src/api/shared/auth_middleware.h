@@ -3,6 +3,9 @@
 #include <crow.h>
 #include <crow/middlewares/cors.h>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <memory>
 #include <string>
 #include <chrono>
 #include <mutex>
@@ -16,6 +19,15 @@ struct Session {
     std::string username;
     bool isAdmin;
     std::chrono::steady_clock::time_point lastActivity;
+    
+    // Accounts the user owns, loaded at login. The set is never modified in
+    // place; account creation swaps in a new one, so copies of the session
+    // handed to request handlers stay valid.
+    std::shared_ptr<const std::unordered_set<int>> accountIds;
+    
+    bool ownsAccount(int accountId) const {
+        return accountIds && accountIds->count(accountId) > 0;
+    }
 };
 
 class AuthMiddleware {
@@ -25,7 +37,9 @@ public:
         return instance;
     }
     
-    // Generate a new session token
+    // Generate a new session token. The session starts with no accounts;
+    // callers grant them once it is registered, so an account created in
+    // between is not missed.
     std::string createSession(int userId, const std::string& username, bool isAdmin) {
         std::lock_guard<std::mutex> lock(mutex_);
         
@@ -34,7 +48,8 @@ public:
             userId,
             username,
             isAdmin,
-            std::chrono::steady_clock::now()
+            std::chrono::steady_clock::now(),
+            std::make_shared<const std::unordered_set<int>>()
         };
         
         return token;
@@ -63,12 +78,51 @@ public:
         return it->second;
     }
     
+    // Whether a session is live, without counting as activity (long-lived
+    // connections check this before pushing data)
+    bool hasSession(const std::string& token) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sessions_.find(token);
+        if (it == sessions_.end()) {
+            return false;
+        }
+        auto idle = std::chrono::steady_clock::now() - it->second.lastActivity;
+        return std::chrono::duration_cast<std::chrono::minutes>(idle).count() <= 30;
+    }
+    
     // Destroy session
     void destroySession(const std::string& token) {
         std::lock_guard<std::mutex> lock(mutex_);
         sessions_.erase(token);
     }
     
+    // Record a newly created account in every live session of its owner
+    void grantAccount(int userId, int accountId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        updateAccountIds(userId, [accountId](std::unordered_set<int>& ids) { ids.insert(accountId); });
+    }
+    
+    // Record accounts in every live session of their owner, keeping any
+    // already granted
+    void grantAccounts(int userId, const std::vector<int>& accountIds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        updateAccountIds(userId, [&accountIds](std::unordered_set<int>& ids) {
+            ids.insert(accountIds.begin(), accountIds.end());
+        });
+    }
+    
+    // Destroy every session of a user (the user was deleted)
+    void destroyUserSessions(int userId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            if (it->second.userId == userId) {
+                it = sessions_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
     // Extract token from request
     std::string extractToken(const crow::request& req) {
         auto auth_header = req.get_header_value("Authorization");
@@ -90,6 +144,26 @@ private:
     std::unordered_map<std::string, Session> sessions_;
     std::mutex mutex_;
     
+    // Apply a change to the user's account set once and share the result
+    // between all of the user's sessions. Caller holds mutex_.
+    template <typename Change>
+    void updateAccountIds(int userId, Change change) {
+        std::shared_ptr<const std::unordered_set<int>> updated;
+        for (auto& [token, session] : sessions_) {
+            if (session.userId != userId) {
+                continue;
+            }
+            if (!updated) {
+                auto ids = session.accountIds
+                    ? std::unordered_set<int>(*session.accountIds)
+                    : std::unordered_set<int>();
+                change(ids);
+                updated = std::make_shared<const std::unordered_set<int>>(std::move(ids));
+            }
+            session.accountIds = updated;
+        }
+    }
+    
     std::string generateToken() {
         std::random_device rd;
         std::mt19937 gen(rd());
@@ -2,6 +2,7 @@
 
 #include <crow.h>
 #include <string>
+#include <string_view>
 
 inline crow::response errorResponse(int statusCode, const std::string& message) {
     crow::json::wvalue response;
@@ -17,3 +18,11 @@ inline crow::response successResponse(const crow::json::wvalue& data, int status
     resp.body = jsonStr;
     return resp;
 }
+
+// Body already serialized as JSON (JsonWriter)
+inline crow::response successResponse(std::string_view json, int statusCode = 200) {
+    crow::response resp(statusCode);
+    resp.set_header("Content-Type", "application/json");
+    resp.body.assign(json.data(), json.size());
+    return resp;
+}
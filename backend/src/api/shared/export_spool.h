@@ -0,0 +1,100 @@
+#pragma once
+
+#include "logging/logger.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+// Temp files holding finished exports while Crow streams them to the client.
+// Crow 1.0 cannot send chunked responses from a generator, but it does send
+// static files in chunks, so an export is written here from the DB cursor
+// and then served as a file.
+//
+// Exports hold customer history, so the spool is a directory private to the
+// process (mkdtemp, mode 0700) and every file is created exclusively with
+// mode 0600. dispatchToDb releases a file as soon as Crow has sent it; a
+// sweep on the next export removes any left behind once older than
+// kRetention, and the directory goes away with the process.
+class ExportSpool {
+public:
+    static ExportSpool& getInstance() {
+        static ExportSpool instance;
+        return instance;
+    }
+    
+    // Prevent copying
+    ExportSpool(const ExportSpool&) = delete;
+    ExportSpool& operator=(const ExportSpool&) = delete;
+    
+    // Path of a new, empty file in the spool, sweeping expired files first;
+    // nothing if the file could not be created
+    std::optional<std::string> createFile(const std::string& extension) {
+        if (dir_.empty()) {
+            return std::nullopt;
+        }
+        sweep();
+        
+        std::string path = (dir_ / ("export-" + std::to_string(counter_.fetch_add(1)) + "." + extension)).string();
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            LOG_ERROR("Failed to create export file", "error", std::strerror(errno));
+            return std::nullopt;
+        }
+        ::close(fd);
+        return path;
+    }
+    
+    void remove(const std::string& path) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    
+    // Removes a file once it has been served; paths outside the spool are
+    // left alone
+    void release(const std::string& path) {
+        if (!dir_.empty() && std::filesystem::path(path).parent_path() == dir_) {
+            remove(path);
+        }
+    }
+    
+private:
+    static constexpr auto kRetention = std::chrono::minutes(10);
+    
+    std::filesystem::path dir_;
+    std::atomic<uint64_t> counter_{0};
+    
+    ExportSpool() {
+        std::error_code ec;
+        std::string pattern = (std::filesystem::temp_directory_path(ec) / "novabank-exports-XXXXXX").string();
+        if (!ec && ::mkdtemp(pattern.data())) {
+            dir_ = pattern;
+        } else {
+            LOG_ERROR("Failed to create export spool directory", "error", ec ? ec.message() : std::strerror(errno));
+        }
+    }
+    
+    ~ExportSpool() {
+        if (!dir_.empty()) {
+            std::error_code ec;
+            std::filesystem::remove_all(dir_, ec);
+        }
+    }
+    
+    void sweep() {
+        std::error_code ec;
+        auto cutoff = std::filesystem::file_time_type::clock::now() - kRetention;
+        for (const auto& entry : std::filesystem::directory_iterator(dir_, ec)) {
+            std::error_code entryEc;
+            if (entry.is_regular_file(entryEc) && entry.last_write_time(entryEc) < cutoff) {
+                std::filesystem::remove(entry.path(), entryEc);
+            }
+        }
+    }
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Streaming JSON output into a single string on a caller's memory resource,
+// for responses too large to build as a crow::json::wvalue tree (which
+// allocates a node, a map entry and a key string per field). Objects and
+// arrays are opened and closed explicitly; commas are inserted as needed.
+//
+//   JsonWriter json(RequestArena::current());
+//   json.beginObject().key("count").value(3).endObject();
+//   return successResponse(json.view());
+class JsonWriter {
+public:
+    explicit JsonWriter(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : out_(resource), hasMember_(resource) {}
+
+    void reserve(size_t bytes) { out_.reserve(bytes); }
+
+    JsonWriter& beginObject() { return open('{'); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray() { return open('['); }
+    JsonWriter& endArray() { return close(']'); }
+
+    // Member name; the next call writes its value
+    JsonWriter& key(std::string_view name) {
+        separate();
+        appendString(name);
+        out_ += ':';
+        afterKey_ = true;
+        return *this;
+    }
+
+    JsonWriter& value(std::string_view text) {
+        separate();
+        appendString(text);
+        return *this;
+    }
+
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+
+    JsonWriter& value(int64_t number) {
+        separate();
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        out_.append(buffer, result.ptr);
+        return *this;
+    }
+
+    JsonWriter& value(int number) { return value(static_cast<int64_t>(number)); }
+
+    // Non-finite values have no JSON form and are written as null
+    JsonWriter& value(double number) {
+        separate();
+        if (!std::isfinite(number)) {
+            out_ += "null";
+            return *this;
+        }
+        char buffer[32];
+        int length = std::snprintf(buffer, sizeof(buffer), "%.15g", number);
+        out_.append(buffer, static_cast<size_t>(length));
+        return *this;
+    }
+
+    JsonWriter& value(bool flag) {
+        separate();
+        out_ += flag ? "true" : "false";
+        return *this;
+    }
+
+    JsonWriter& null() {
+        separate();
+        out_ += "null";
+        return *this;
+    }
+
+    std::string_view view() const { return out_; }
+
+private:
+    JsonWriter& open(char bracket) {
+        separate();
+        out_ += bracket;
+        hasMember_.push_back(false);
+        return *this;
+    }
+
+    JsonWriter& close(char bracket) {
+        out_ += bracket;
+        hasMember_.pop_back();
+        return *this;
+    }
+
+    // Comma before every member or element but the first in its container
+    void separate() {
+        if (afterKey_) {
+            afterKey_ = false;
+            return;
+        }
+        if (!hasMember_.empty()) {
+            if (hasMember_.back()) {
+                out_ += ',';
+            }
+            hasMember_.back() = true;
+        }
+    }
+
+    void appendString(std::string_view text) {
+        out_ += '"';
+        size_t plain = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            out_.append(text.data() + plain, i - plain);
+            plain = i + 1;
+            switch (c) {
+                case '"': out_ += "\\\""; break;
+                case '\\': out_ += "\\\\"; break;
+                case '\n': out_ += "\\n"; break;
+                case '\r': out_ += "\\r"; break;
+                case '\t': out_ += "\\t"; break;
+                default: {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    out_ += escape;
+                }
+            }
+        }
+        out_.append(text.data() + plain, text.size() - plain);
+        out_ += '"';
+    }
+
+    std::pmr::string out_;
+    std::pmr::vector<bool> hasMember_;
+    bool afterKey_ = false;
+};
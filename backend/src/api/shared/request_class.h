@@ -0,0 +1,76 @@
+#pragma once
+
+#include <crow.h>
+#include <chrono>
+#include <string>
+#include "api/shared/auth_middleware.h"
+#include "db/db_executor.h"
+
+struct RequestClass {
+    DbLane lane;
+    DbPriority priority;
+    std::chrono::milliseconds budget{0};   // zero: use deadlineBudget(priority)
+};
+
+// Time budget from enqueue to response. Past it the client has most likely
+// given up, so queued work is dropped and running statements are interrupted.
+inline std::chrono::milliseconds deadlineBudget(DbPriority priority) {
+    switch (priority) {
+        case DbPriority::Critical: return std::chrono::milliseconds(2000);
+        case DbPriority::Interactive: return std::chrono::milliseconds(5000);
+        case DbPriority::Bulk: return std::chrono::milliseconds(30000);
+    }
+    return std::chrono::milliseconds(5000);
+}
+
+// Decide where a request's DB work is scheduled. All routing policy lives
+// here so controllers never pick lanes or priorities themselves:
+//   - auth and customer money movement are Critical
+//   - admin writes, batches and ordinary customer reads are Interactive
+//   - admin reports, imports, exports, month close and unscoped listings are Bulk
+inline RequestClass classifyRequest(const crow::request& req) {
+    const std::string& url = req.url;
+    auto startsWith = [&url](const char* prefix) {
+        return url.rfind(prefix, 0) == 0;
+    };
+
+    // Login only reads users, so keep it off the single writer thread
+    if (startsWith("/api/v1/auth/")) {
+        return { DbLane::Read, DbPriority::Critical };
+    }
+
+    if (req.method != crow::HTTPMethod::Get) {
+        if (url == "/api/v1/admin/import") {
+            return { DbLane::Write, DbPriority::Bulk };
+        }
+        // Month close builds every account's statement, committing as it goes
+        if (url == "/api/v1/admin/statements/close") {
+            return { DbLane::Write, DbPriority::Bulk, std::chrono::minutes(10) };
+        }
+        // Integration batches should not delay individual customer payments
+        if (startsWith("/api/v1/admin/") || startsWith("/api/v1/users") || url == "/api/v1/transactions/batch") {
+            return { DbLane::Write, DbPriority::Interactive };
+        }
+        return { DbLane::Write, DbPriority::Critical };
+    }
+
+    if (startsWith("/api/v1/admin/") || url == "/api/v1/users") {
+        return { DbLane::Read, DbPriority::Bulk };
+    }
+
+    // Exports scan a read snapshot and may legitimately run for minutes
+    if (url == "/api/v1/transactions/export") {
+        return { DbLane::Read, DbPriority::Bulk, std::chrono::minutes(10) };
+    }
+
+    // Admins listing accounts or transactions see every row (findAll)
+    if (url == "/api/v1/accounts" || url == "/api/v1/transactions") {
+        auto& auth = AuthMiddleware::getInstance();
+        auto session = auth.getSession(auth.extractToken(req));
+        if (session && session->isAdmin) {
+            return { DbLane::Read, DbPriority::Bulk };
+        }
+    }
+
+    return { DbLane::Read, DbPriority::Interactive };
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <crow.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "api/shared/auth_middleware.h"
+#include "domain/account/account.h"
+#include "utils/metrics.h"
+
+// Serialized bodies of hot GET responses, keyed by (user, URL with query).
+// Each entry carries a Tag: the version of the data it was built from (one
+// user's accounts, one account, or everything). Writers bump the versions of
+// what they touched once their commit is done; an entry whose tag no longer
+// matches is a miss. A handler takes its tag before reading, so a write that
+// lands during the read leaves the entry stale rather than wrong. Handlers
+// read through a ReadSnapshot: a write that rolls back bumps nothing, so a
+// body holding its uncommitted rows would otherwise stay current.
+//
+// Versions live in fixed arrays indexed by id, so two ids sharing a slot only
+// cost each other extra misses. Every entry also carries an ETag; a request
+// whose If-None-Match matches is answered 304 without a body. The cache is
+// per process: writes made by the command line tools are not seen.
+class ResponseCache {
+public:
+    enum class Scope : uint8_t { User, Account, All };
+
+    struct Tag {
+        Scope scope;
+        int id;
+        uint64_t version;
+        uint64_t epoch;
+    };
+
+    static ResponseCache& getInstance() {
+        static ResponseCache instance;
+        return instance;
+    }
+
+    Tag userTag(int userId) const { return tag(Scope::User, userId); }
+    Tag accountTag(int accountId) const { return tag(Scope::Account, accountId); }
+    Tag allTag() const { return tag(Scope::All, 0); }
+
+    // Answer from the cache when the caller's session is valid and a current
+    // entry exists; false means the request still needs its handler
+    bool serve(const crow::request& req, crow::response& res) {
+        auto& auth = AuthMiddleware::getInstance();
+        auto session = auth.getSession(auth.extractToken(req));
+        if (!session) {
+            return false;
+        }
+
+        std::shared_ptr<const Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key(session->userId, req));
+            if (it == entries_.end()) {
+                return false;
+            }
+            if (!isCurrent(it->second->entry->tag)) {
+                lru_.erase(it->second);
+                entries_.erase(it);
+                return false;
+            }
+            lru_.splice(lru_.begin(), lru_, it->second);
+            entry = it->second->entry;
+        }
+
+        Metrics::getInstance().increment(Counter::ResponseCacheHits);
+        res = respond(req, *entry);
+        res.end();
+        return true;
+    }
+
+    // Keep a handler's 200 response for the user under the tag taken before
+    // it read, and answer 304 instead if the client already has this body
+    crow::response store(const crow::request& req, int userId, const Tag& tag, crow::response response) {
+        if (response.code != 200) {
+            return response;
+        }
+
+        auto entry = std::make_shared<Entry>();
+        entry->tag = tag;
+        entry->etag = etagFor(response.body);
+        response.set_header("ETag", entry->etag);
+        response.set_header("Cache-Control", kCacheControl);
+
+        if (response.body.size() <= kMaxBodyBytes && isCurrent(tag)) {
+            entry->body = response.body;
+            std::lock_guard<std::mutex> lock(mutex_);
+            insert(key(userId, req), entry);
+        }
+
+        if (matches(req, entry->etag)) {
+            Metrics::getInstance().increment(Counter::ResponseCacheNotModified);
+            return notModified(entry->etag);
+        }
+        return response;
+    }
+
+    // An account's balance, transactions or existence changed (and with it
+    // its owner's account list)
+    void accountChanged(int accountId, int userId) {
+        bump(accountVersions_, accountId);
+        userChanged(userId);
+    }
+
+    void accountChanged(const Account& account) {
+        accountChanged(account.getId(), account.getUserId());
+    }
+
+    // A user's set of accounts changed
+    void userChanged(int userId) {
+        bump(userVersions_, userId);
+        allVersion_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Too many changes to name (imports, deleted users): drop everything
+    void clear() {
+        epoch_.fetch_add(1, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        lru_.clear();
+    }
+
+private:
+    static constexpr size_t kVersionSlots = 4096;
+    static constexpr size_t kMaxEntries = 4096;
+    static constexpr size_t kMaxBodyBytes = 256 * 1024;
+
+    // Clients may keep the body but must revalidate before each use
+    static constexpr const char* kCacheControl = "private, no-cache";
+
+    struct Entry {
+        Tag tag;
+        std::string etag;
+        std::string body;
+    };
+
+    struct Node {
+        std::string key;
+        std::shared_ptr<const Entry> entry;
+    };
+
+    using Versions = std::array<std::atomic<uint64_t>, kVersionSlots>;
+
+    ResponseCache() = default;
+
+    static size_t slot(int id) { return static_cast<size_t>(id) % kVersionSlots; }
+
+    static void bump(Versions& versions, int id) {
+        versions[slot(id)].fetch_add(1, std::memory_order_release);
+    }
+
+    uint64_t version(Scope scope, int id) const {
+        switch (scope) {
+            case Scope::User: return userVersions_[slot(id)].load(std::memory_order_acquire);
+            case Scope::Account: return accountVersions_[slot(id)].load(std::memory_order_acquire);
+            default: return allVersion_.load(std::memory_order_acquire);
+        }
+    }
+
+    Tag tag(Scope scope, int id) const {
+        return Tag{ scope, id, version(scope, id), epoch_.load(std::memory_order_acquire) };
+    }
+
+    bool isCurrent(const Tag& tag) const {
+        return tag.epoch == epoch_.load(std::memory_order_acquire) &&
+               tag.version == version(tag.scope, tag.id);
+    }
+
+    static std::string key(int userId, const crow::request& req) {
+        return std::to_string(userId) + ' ' + req.raw_url;
+    }
+
+    static std::string etagFor(std::string_view body) {
+        char etag[24];
+        std::snprintf(etag, sizeof(etag), "\"%016llx\"",
+                      static_cast<unsigned long long>(std::hash<std::string_view>{}(body)));
+        return etag;
+    }
+
+    static bool matches(const crow::request& req, const std::string& etag) {
+        const std::string& ifNoneMatch = req.get_header_value("If-None-Match");
+        return ifNoneMatch == "*" || ifNoneMatch.find(etag) != std::string::npos;
+    }
+
+    static crow::response notModified(const std::string& etag) {
+        crow::response res(304);
+        res.set_header("ETag", etag);
+        res.set_header("Cache-Control", kCacheControl);
+        return res;
+    }
+
+    static crow::response respond(const crow::request& req, const Entry& entry) {
+        if (matches(req, entry.etag)) {
+            Metrics::getInstance().increment(Counter::ResponseCacheNotModified);
+            return notModified(entry.etag);
+        }
+        crow::response res(200);
+        res.set_header("Content-Type", "application/json");
+        res.set_header("ETag", entry.etag);
+        res.set_header("Cache-Control", kCacheControl);
+        res.body = entry.body;
+        return res;
+    }
+
+    // Caller holds mutex_
+    void insert(std::string key, std::shared_ptr<const Entry> entry) {
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            it->second->entry = std::move(entry);
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return;
+        }
+        if (entries_.size() >= kMaxEntries) {
+            entries_.erase(lru_.back().key);
+            lru_.pop_back();
+        }
+        lru_.push_front(Node{ key, std::move(entry) });
+        entries_.emplace(std::move(key), lru_.begin());
+    }
+
+    Versions userVersions_{};
+    Versions accountVersions_{};
+    std::atomic<uint64_t> allVersion_{0};
+    std::atomic<uint64_t> epoch_{0};
+
+    std::mutex mutex_;
+    std::list<Node> lru_;   // most recently used first
+    std::unordered_map<std::string, std::list<Node>::iterator> entries_;
+};
@@ -0,0 +1,219 @@
+#include "api/statement/statement_controller.h"
+#include "api/statement/statement_serializer.h"
+#include "api/shared/error_response.h"
+#include "api/shared/auth_middleware.h"
+#include "api/shared/async_handler.h"
+#include <crow/json.h>
+#include "db/read_snapshot.h"
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+StatementController::StatementController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor)
+    : executor_(executor),
+      db_(db),
+      statementRepository_(std::make_unique<StatementRepository>(db)),
+      accountRepository_(std::make_unique<AccountRepository>(db)) {}
+
+void StatementController::registerRoutes(crow::App<crow::CORSHandler>& app) {
+    CROW_ROUTE(app, "/api/v1/accounts/<int>/statements")
+        .methods("GET"_method)
+        ([this](const crow::request& req, crow::response& res, int accountId) {
+            dispatchToDb(*executor_, req, res, [this, &req, accountId] { return getStatements(req, accountId); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/accounts/<int>/statements/<string>")
+        .methods("GET"_method)
+        ([this](const crow::request& req, crow::response& res, int accountId, const std::string& period) {
+            dispatchToDb(*executor_, req, res, [this, &req, accountId, period] { return getStatement(req, accountId, period); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/admin/statements/close")
+        .methods("POST"_method)
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return closePeriod(req); });
+        });
+}
+
+crow::response StatementController::getStatements(const crow::request& req, int accountId) {
+    REQUIRE_AUTH(req)
+    
+    auto account = accountRepository_->findById(accountId);
+    if (!account) {
+        return errorResponse(404, "Account not found");
+    }
+    
+    if (!session->isAdmin && !session->ownsAccount(account->getId())) {
+        return errorResponse(403, "Access denied");
+    }
+    
+    auto statements = statementRepository_->findByAccountId(accountId);
+    
+    crow::json::wvalue response;
+    response["statements"] = crow::json::wvalue(crow::json::type::List);
+    for (size_t i = 0; i < statements.size(); ++i) {
+        response["statements"][i] = StatementSerializer::toSummaryJson(statements[i]);
+    }
+    response["count"] = statements.size();
+    
+    return successResponse(response);
+}
+
+crow::response StatementController::getStatement(const crow::request& req, int accountId, const std::string& period) {
+    REQUIRE_AUTH(req)
+    
+    if (!StatementPeriod::isValid(period)) {
+        return errorResponse(400, "Period must be formatted as YYYY-MM");
+    }
+    
+    if (!StatementPeriod::isClosed(period)) {
+        return errorResponse(400, "Statements are only available for closed months");
+    }
+    
+    auto account = accountRepository_->findById(accountId);
+    if (!account) {
+        return errorResponse(404, "Account not found");
+    }
+    
+    if (!session->isAdmin && !session->ownsAccount(account->getId())) {
+        return errorResponse(403, "Access denied");
+    }
+    
+    auto body = statementRepository_->findBody(accountId, period);
+    if (!body) {
+        // Not generated at month close (e.g. the account was missed, the
+        // close has not run yet or an import replaced it): build it now from
+        // committed data
+        std::unique_ptr<ReadSnapshot> snapshot;
+        try {
+            snapshot = db_->openReadSnapshot();
+        } catch (const std::exception& e) {
+            return errorResponse(500, "Failed to build statement");
+        }
+        
+        auto statement = statementRepository_->build(*snapshot, accountId, period);
+        if (!statement) {
+            return errorResponse(404, "No statement for this period");
+        }
+        snapshot.reset();
+        
+        // Store it on the write lane and answer with the stored row: when a
+        // concurrent request stored its build first, that one is kept and
+        // every later request is served it
+        auto stored = std::make_shared<std::promise<std::optional<std::string>>>();
+        auto storedBody = stored->get_future();
+        bool queued = executor_->submit(DbLane::Write, DbPriority::Interactive,
+            [this, stored, statement = std::move(*statement)] {
+                std::optional<std::string> body;
+                if (statementRepository_->save(statement, StatementSerializer::toJson(statement).dump())) {
+                    body = statementRepository_->findBody(statement.accountId, statement.period);
+                }
+                stored->set_value(std::move(body));
+            });
+        if (!queued) {
+            auto busy = errorResponse(503, "Server busy, please retry");
+            busy.set_header("Retry-After", "1");
+            return busy;
+        }
+        
+        body = storedBody.get();
+        if (!body) {
+            return errorResponse(500, "Failed to store statement");
+        }
+    }
+    
+    // The stored body is the statement's version. It is replaced only when
+    // an import changes the month's history, so clients keep it and
+    // revalidate, which costs a 304.
+    std::string etag = statementETag(*body);
+    if (req.get_header_value("If-None-Match") == etag) {
+        crow::response notModified(304);
+        notModified.set_header("ETag", etag);
+        notModified.set_header("Cache-Control", "private, no-cache");
+        return notModified;
+    }
+    
+    crow::response response(200);
+    response.set_header("Content-Type", "application/json");
+    response.set_header("ETag", etag);
+    response.set_header("Cache-Control", "private, no-cache");
+    response.body = std::move(*body);
+    return response;
+}
+
+crow::response StatementController::closePeriod(const crow::request& req) {
+    REQUIRE_ADMIN(req)
+    
+    // Default to the month that just ended
+    std::string period = StatementPeriod::previous(StatementPeriod::current());
+    if (!req.body.empty()) {
+        auto body = crow::json::load(req.body);
+        if (!body) {
+            return errorResponse(400, "Invalid JSON");
+        }
+        if (body.has("period")) {
+            period = std::string(body["period"].s());
+        }
+    }
+    
+    if (!StatementPeriod::isValid(period)) {
+        return errorResponse(400, "Period must be formatted as YYYY-MM");
+    }
+    
+    if (!StatementPeriod::isClosed(period)) {
+        return errorResponse(400, "Only closed months can be materialized");
+    }
+    
+    // Accounts that already have a statement are skipped, so an interrupted
+    // close can simply be repeated
+    auto accountIds = statementRepository_->findAccountsWithoutStatement(period);
+    size_t generated = 0;
+    
+    // Every statement of the close is built from the same committed state
+    std::unique_ptr<ReadSnapshot> snapshot;
+    try {
+        snapshot = db_->openReadSnapshot();
+    } catch (const std::exception& e) {
+        return errorResponse(500, "Failed to generate statements");
+    }
+    
+    for (size_t start = 0; start < accountIds.size(); start += kStatementsPerCommit) {
+        size_t end = std::min(start + kStatementsPerCommit, accountIds.size());
+        
+        if (!db_->beginTransaction()) {
+            return errorResponse(500, "Failed to start transaction");
+        }
+        
+        bool ok = true;
+        for (size_t i = start; i < end && ok; ++i) {
+            auto statement = statementRepository_->build(*snapshot, accountIds[i], period);
+            ok = statement && statementRepository_->save(*statement, StatementSerializer::toJson(*statement).dump());
+        }
+        
+        if (!ok || !db_->commit()) {
+            db_->rollback();
+            return errorResponse(500, "Failed to generate statements");
+        }
+        generated += end - start;
+    }
+    
+    crow::json::wvalue response;
+    response["period"] = period;
+    response["statementsGenerated"] = generated;
+    response["message"] = "Statements generated";
+    
+    return successResponse(response);
+}
+
+std::string StatementController::statementETag(const std::string& body) {
+    char etag[24];
+    std::snprintf(etag, sizeof(etag), "\"%016llx\"",
+                  static_cast<unsigned long long>(std::hash<std::string_view>{}(body)));
+    return etag;
+}
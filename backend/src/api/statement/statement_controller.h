@@ -0,0 +1,35 @@
+#pragma once
+
+#include <crow.h>
+#include <crow/middlewares/cors.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include "repository/statement/statement_repository.h"
+#include "repository/account/account_repository.h"
+#include "db/db.h"
+#include "db/db_executor.h"
+
+class StatementController {
+public:
+    StatementController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor);
+    
+    void registerRoutes(crow::App<crow::CORSHandler>& app);
+    
+private:
+    std::shared_ptr<DbExecutor> executor_;
+    std::shared_ptr<Database> db_;
+    std::unique_ptr<StatementRepository> statementRepository_;
+    std::unique_ptr<AccountRepository> accountRepository_;
+    
+    // Statement endpoints
+    crow::response getStatements(const crow::request& req, int accountId);
+    crow::response getStatement(const crow::request& req, int accountId, const std::string& period);
+    crow::response closePeriod(const crow::request& req);
+    
+    // Accounts whose statements are generated per DB transaction at month close
+    static constexpr size_t kStatementsPerCommit = 500;
+    
+    // Helper methods
+    static std::string statementETag(const std::string& body);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <crow/json.h>
+#include "domain/statement/statement.h"
+#include "domain/transaction/transaction_status.h"
+#include "domain/account/account_utils.h"
+
+class StatementSerializer {
+public:
+    // Summary fields shared by the full statement and the statement list
+    static crow::json::wvalue toSummaryJson(const Statement& statement) {
+        crow::json::wvalue json;
+        json["accountId"] = statement.accountId;
+        json["accountNumber"] = statement.accountNumber;
+        json["period"] = statement.period;
+        json["openingBalance"] = AccountUtils::fromCents(statement.openingBalanceCents);
+        json["closingBalance"] = AccountUtils::fromCents(statement.closingBalanceCents);
+        json["totals"]["deposits"] = AccountUtils::fromCents(statement.depositsCents);
+        json["totals"]["withdrawals"] = AccountUtils::fromCents(statement.withdrawalsCents);
+        json["totals"]["transfersIn"] = AccountUtils::fromCents(statement.transfersInCents);
+        json["totals"]["transfersOut"] = AccountUtils::fromCents(statement.transfersOutCents);
+        json["entryCount"] = statement.entryCount;
+        
+        if (!statement.generatedAt.empty()) {
+            json["generatedAt"] = statement.generatedAt;
+        }
+        
+        return json;
+    }
+    
+    static crow::json::wvalue toJson(const Statement& statement) {
+        crow::json::wvalue json = toSummaryJson(statement);
+        json["entries"] = crow::json::wvalue(crow::json::type::List);
+        
+        for (size_t i = 0; i < statement.entries.size(); ++i) {
+            json["entries"][i] = entryToJson(statement.entries[i]);
+        }
+        
+        return json;
+    }
+    
+    static crow::json::wvalue entryToJson(const StatementEntry& entry) {
+        crow::json::wvalue json;
+        json["transactionId"] = entry.transactionId;
+        json["date"] = entry.createdAt;
+        json["type"] = transactionTypeToString(entry.type);
+        json["direction"] = entry.credit ? "credit" : "debit";
+        json["amount"] = AccountUtils::fromCents(entry.amountCents);
+        json["balance"] = AccountUtils::fromCents(entry.balanceAfterCents);
+        json["description"] = entry.description;
+        json["status"] = transactionStatusToString(entry.status);
+        
+        if (!entry.counterpartyAccountNumber.empty()) {
+            json["counterpartyAccountNumber"] = entry.counterpartyAccountNumber;
+        }
+        
+        return json;
+    }
+};
@@ -0,0 +1,92 @@
+#include "api/stream/account_event_feed.h"
+#include "api/shared/account_event_bus.h"
+#include "db/read_snapshot.h"
+#include "logging/logger.h"
+#include <algorithm>
+#include <exception>
+#include <unordered_map>
+#include <vector>
+
+AccountEventFeed::AccountEventFeed(std::shared_ptr<Database> db)
+    : db_(db),
+      accountRepository_(std::make_unique<AccountRepository>(db)),
+      transactionRepository_(std::make_unique<TransactionRepository>(db)) {}
+
+void AccountEventFeed::onCommit(const ChangeBatch& batch) {
+    auto& bus = AccountEventBus::getInstance();
+    
+    // Nobody to tell, or a commit too large to list (imports): nothing is
+    // read back
+    if (batch.overflowed || bus.subscriberCount() == 0) {
+        return;
+    }
+    
+    std::vector<int> transactionIds;
+    std::vector<int> updatedAccountIds;
+    for (const auto& change : batch.changes) {
+        if (change.table == ChangeTable::Transactions && change.op == ChangeOp::Insert) {
+            transactionIds.push_back(static_cast<int>(change.rowId));
+        } else if (change.table == ChangeTable::Accounts && change.op == ChangeOp::Update) {
+            updatedAccountIds.push_back(static_cast<int>(change.rowId));
+        }
+    }
+    if (transactionIds.empty() && updatedAccountIds.empty()) {
+        return;
+    }
+    
+    // The shared connection may be inside the next write transaction by
+    // now; a snapshot only shows committed rows and balances
+    std::unique_ptr<ReadSnapshot> snapshot;
+    try {
+        snapshot = db_->openReadSnapshot();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Account event feed could not read changes", "batch", batch.sequence, "error", e.what());
+        return;
+    }
+    
+    auto transactions = transactionRepository_->findByIds(*snapshot, transactionIds);
+    std::sort(transactions.begin(), transactions.end(),
+              [](const Transaction& a, const Transaction& b) { return a.getId() < b.getId(); });
+    
+    // Owners of both sides of every transaction, plus the updated accounts,
+    // in one lookup
+    std::pmr::vector<int> accountIds(updatedAccountIds.begin(), updatedAccountIds.end());
+    for (const auto& transaction : transactions) {
+        if (auto fromId = transaction.getFromAccountId()) {
+            accountIds.push_back(fromId.value());
+        }
+        if (auto toId = transaction.getToAccountId()) {
+            accountIds.push_back(toId.value());
+        }
+    }
+    std::sort(accountIds.begin(), accountIds.end());
+    accountIds.erase(std::unique(accountIds.begin(), accountIds.end()), accountIds.end());
+    
+    auto accounts = accountRepository_->findByIds(*snapshot, accountIds, std::pmr::get_default_resource());
+    std::unordered_map<int, const Account*> byId;
+    for (const auto& account : accounts) {
+        byId.emplace(account.getId(), &account);
+    }
+    auto ownerOf = [&byId](std::optional<int> accountId) {
+        auto it = accountId ? byId.find(accountId.value()) : byId.end();
+        return it != byId.end() ? it->second->getUserId() : 0;
+    };
+    
+    std::vector<int> coveredIds;   // accounts whose change a transaction event reports
+    for (const auto& transaction : transactions) {
+        bus.publishTransaction(transaction, ownerOf(transaction.getFromAccountId()),
+                               ownerOf(transaction.getToAccountId()));
+        coveredIds.push_back(transaction.getFromAccountId().value_or(0));
+        coveredIds.push_back(transaction.getToAccountId().value_or(0));
+    }
+    
+    std::sort(updatedAccountIds.begin(), updatedAccountIds.end());
+    updatedAccountIds.erase(std::unique(updatedAccountIds.begin(), updatedAccountIds.end()), updatedAccountIds.end());
+    for (int accountId : updatedAccountIds) {
+        auto it = byId.find(accountId);
+        if (it == byId.end() || std::find(coveredIds.begin(), coveredIds.end(), accountId) != coveredIds.end()) {
+            continue;
+        }
+        bus.publishBalance(accountId, it->second->getUserId(), it->second->getBalance());
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include "db/change_capture.h"
+#include "db/db.h"
+#include "repository/account/account_repository.h"
+#include "repository/transaction/transaction_repository.h"
+
+// Feeds AccountEventBus from change capture: every committed transaction row
+// becomes a transaction event for the owners of its accounts, and an account
+// whose balance changed without one (the legacy account transfer) a balance
+// event. Runs on the change dispatcher thread, so the money-movement paths
+// publish nothing themselves.
+//
+// Rows are read back through a ReadSnapshot taken after the commit, never
+// through the shared connection, so an event can only carry committed
+// state. A balance is the newest committed one, which may already include
+// later commits; their own events follow.
+class AccountEventFeed {
+public:
+    explicit AccountEventFeed(std::shared_ptr<Database> db);
+    
+    void onCommit(const ChangeBatch& batch);
+    
+private:
+    std::shared_ptr<Database> db_;
+    std::unique_ptr<AccountRepository> accountRepository_;
+    std::unique_ptr<TransactionRepository> transactionRepository_;
+};
@@ -0,0 +1,60 @@
+#include "api/stream/stream_controller.h"
+#include "api/shared/account_event_bus.h"
+#include "api/shared/auth_middleware.h"
+#include "logging/logger.h"
+
+void StreamController::registerRoutes(crow::App<crow::CORSHandler>& app) {
+    CROW_WEBSOCKET_ROUTE(app, "/api/v1/stream")
+        .onaccept([](const crow::request& req, void** userdata) {
+            std::string token = tokenFrom(req);
+            auto session = AuthMiddleware::getInstance().getSession(token);
+            if (!session) {
+                return false;
+            }
+            *userdata = new Subscriber{ session->userId, token };
+            return true;
+        })
+        .onopen([](crow::websocket::connection& conn) {
+            auto* subscriber = static_cast<Subscriber*>(conn.userdata());
+            crow::websocket::connection* target = &conn;
+            std::string token = subscriber->token;
+            
+            // Runs on the publishing thread; send_text only queues the frame.
+            // A session that ended (logout, timeout) closes the stream.
+            subscriber->subscriptionId = AccountEventBus::getInstance().subscribe(subscriber->userId,
+                [target, token](const std::string& message) {
+                    if (AuthMiddleware::getInstance().hasSession(token)) {
+                        target->send_text(message);
+                    } else {
+                        target->close("Session expired");
+                    }
+                });
+            
+            LOG_DEBUG("Stream opened", "user_id", subscriber->userId);
+            conn.send_text(R"({"event":"subscribed"})");
+        })
+        .onclose([](crow::websocket::connection& conn, const std::string& reason) {
+            auto* subscriber = static_cast<Subscriber*>(conn.userdata());
+            if (!subscriber) {
+                return;
+            }
+            
+            // Once unsubscribe returns no publisher can reach the connection
+            AccountEventBus::getInstance().unsubscribe(subscriber->subscriptionId);
+            LOG_DEBUG("Stream closed", "user_id", subscriber->userId, "reason", reason);
+            conn.userdata(nullptr);
+            delete subscriber;
+        })
+        .onmessage([](crow::websocket::connection&, const std::string&, bool) {
+            // Push only; messages from the client are ignored
+        });
+}
+
+std::string StreamController::tokenFrom(const crow::request& req) {
+    std::string token = AuthMiddleware::getInstance().extractToken(req);
+    if (token.empty()) {
+        const char* param = req.url_params.get("token");
+        token = param ? param : "";
+    }
+    return token;
+}
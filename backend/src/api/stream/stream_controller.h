@@ -0,0 +1,26 @@
+#pragma once
+
+#include <crow.h>
+#include <crow/middlewares/cors.h>
+#include <cstdint>
+#include <string>
+
+// Websocket push of account activity: an authenticated client connects to
+// /api/v1/stream and receives a JSON message for every committed movement
+// on any of its accounts, instead of polling accounts and history.
+class StreamController {
+public:
+    void registerRoutes(crow::App<crow::CORSHandler>& app);
+    
+private:
+    // Per-connection state, kept in the connection's userdata
+    struct Subscriber {
+        int userId;
+        std::string token;
+        uint64_t subscriptionId = 0;
+    };
+    
+    // Browsers cannot set headers on a websocket handshake, so the session
+    // token may also come as ?token=
+    static std::string tokenFrom(const crow::request& req);
+};
@@ -0,0 +1,107 @@
+#include "api/sync/sync_controller.h"
+#include "api/account/account_serializer.h"
+#include "api/transaction/transaction_serializer.h"
+#include "api/shared/error_response.h"
+#include "api/shared/auth_middleware.h"
+#include "api/shared/async_handler.h"
+#include "db/read_snapshot.h"
+#include "utils/request_arena.h"
+#include <crow/json.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <exception>
+
+SyncController::SyncController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor)
+    : executor_(executor),
+      db_(db),
+      accountRepository_(std::make_unique<AccountRepository>(db)),
+      transactionRepository_(std::make_unique<TransactionRepository>(db)) {}
+
+void SyncController::registerRoutes(crow::App<crow::CORSHandler>& app) {
+    CROW_ROUTE(app, "/api/v1/sync")
+        .methods("GET"_method)
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return getChanges(req); });
+        });
+}
+
+crow::response SyncController::getChanges(const crow::request& req) {
+    REQUIRE_AUTH(req)
+    
+    // No cursor is a first sync: everything the user has
+    std::optional<int64_t> since = 0;
+    if (const char* sinceStr = req.url_params.get("since")) {
+        since = parseSequence(sinceStr);
+    }
+    if (!since) {
+        return errorResponse(400, "since must be a cursor returned by a previous sync");
+    }
+    
+    int limit = kDefaultLimit;
+    if (const char* limitStr = req.url_params.get("limit")) {
+        auto parsed = parseSequence(limitStr);
+        if (!parsed || parsed.value() == 0) {
+            return errorResponse(400, "limit must be a positive integer");
+        }
+        limit = static_cast<int>(std::min<int64_t>(parsed.value(), kMaxLimit));
+    }
+    
+    // Every read goes through one snapshot of committed data. A sequence
+    // value taken by a write that is still open (or later rolls back) is
+    // never seen, so the cursor cannot move past a row that later appears
+    // below it; rows committed after the snapshot are left for the next sync.
+    std::unique_ptr<ReadSnapshot> snapshot;
+    try {
+        snapshot = db_->openReadSnapshot();
+    } catch (const std::exception& e) {
+        return errorResponse(500, "Failed to read changes");
+    }
+    int64_t latest = transactionRepository_->latestChangeSequence(*snapshot);
+    
+    // A cursor ahead of the database (restored from a backup) cannot be
+    // resumed; the client is told to drop its copy and start over
+    bool reset = since.value() > latest;
+    int64_t from = reset ? 0 : since.value();
+    
+    std::pmr::memory_resource* arena = RequestArena::current();
+    std::pmr::vector<int64_t> sequences(arena);
+    TransactionBatch transactions = transactionRepository_->findChangedByUserId(
+        *snapshot, session->userId, from, latest, limit + 1, sequences, arena);
+    
+    // The row past the limit only tells that there is more. A truncated
+    // response stops at its last transaction, and accounts are cut at the
+    // same point so nothing between the two cursors is skipped.
+    bool hasMore = transactions.size() > static_cast<size_t>(limit);
+    size_t count = hasMore ? static_cast<size_t>(limit) : transactions.size();
+    int64_t cursor = hasMore ? sequences[count - 1] : latest;
+    
+    auto accounts = accountRepository_->findChangedByUserId(*snapshot, session->userId, from, cursor);
+    
+    crow::json::wvalue response;
+    response["accounts"] = AccountSerializer::toJsonList(accounts);
+    response["transactions"] = crow::json::wvalue(crow::json::type::List);
+    for (size_t i = 0; i < count; ++i) {
+        response["transactions"][i] = TransactionSerializer::toJson(transactions.at(i));
+    }
+    response["cursor"] = cursor;
+    response["hasMore"] = hasMore;
+    if (reset) {
+        response["reset"] = true;
+    }
+    
+    return successResponse(response);
+}
+
+std::optional<int64_t> SyncController::parseSequence(const char* text) {
+    if (*text < '0' || *text > '9') {
+        return std::nullopt;
+    }
+    char* end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE) {
+        return std::nullopt;
+    }
+    return static_cast<int64_t>(value);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <crow.h>
+#include <crow/middlewares/cors.h>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "repository/account/account_repository.h"
+#include "repository/transaction/transaction_repository.h"
+#include "db/db.h"
+#include "db/db_executor.h"
+
+// Delta sync for clients that keep a local copy of their accounts and
+// history: GET /api/v1/sync?since=<cursor> returns only the rows created or
+// changed after the cursor, plus the cursor to send next time. Cursors are
+// positions in the change sequence the database stamps on every write.
+class SyncController {
+public:
+    SyncController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor);
+    
+    void registerRoutes(crow::App<crow::CORSHandler>& app);
+    
+private:
+    std::shared_ptr<DbExecutor> executor_;
+    std::shared_ptr<Database> db_;
+    std::unique_ptr<AccountRepository> accountRepository_;
+    std::unique_ptr<TransactionRepository> transactionRepository_;
+    
+    // Sync endpoints
+    crow::response getChanges(const crow::request& req);
+    
+    // Transactions per response; a client with more to fetch gets hasMore
+    static constexpr int kDefaultLimit = 500;
+    static constexpr int kMaxLimit = 1000;
+    
+    // Helper methods
+    static std::optional<int64_t> parseSequence(const char* text);
+};
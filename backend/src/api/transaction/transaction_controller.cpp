@@ -1,13 +1,27 @@
 #include "api/transaction/transaction_controller.h"
 #include "api/shared/error_response.h"
 #include "api/shared/auth_middleware.h"
+#include "api/shared/async_handler.h"
+#include "api/shared/export_spool.h"
+#include "api/shared/json_writer.h"
+#include "api/shared/response_cache.h"
+#include "db/read_snapshot.h"
 #include "domain/account/account_utils.h"
 #include "domain/transaction/transaction_utils.h"
+#include "logging/logger.h"
+#include "repository/transaction/transaction_exporter.h"
+#include "utils/request_arena.h"
 #include <crow/json.h>
-#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
 
-TransactionController::TransactionController(std::shared_ptr<Database> db) 
-    : db_(db),
+TransactionController::TransactionController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor) 
+    : executor_(executor),
+      db_(db),
       transactionRepository_(std::make_unique<TransactionRepository>(db)),
       accountRepository_(std::make_unique<AccountRepository>(db)) {}
 
@@ -15,23 +29,48 @@ void TransactionController::registerRoutes(crow::App<crow::CORSHandler>& app) {
     // Transaction routes
     CROW_ROUTE(app, "/api/v1/transactions")
         .methods("GET"_method)
-        ([this](const crow::request& req) { return getTransactions(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            if (isFirstPage(req) && ResponseCache::getInstance().serve(req, res)) {
+                return;
+            }
+            dispatchToDb(*executor_, req, res, [this, &req] { return getTransactions(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/transactions/<int>")
         .methods("GET"_method)
-        ([this](const crow::request& req, int id) { return getTransaction(req, id); });
+        ([this](const crow::request& req, crow::response& res, int id) {
+            dispatchToDb(*executor_, req, res, [this, &req, id] { return getTransaction(req, id); });
+        });
     
     CROW_ROUTE(app, "/api/v1/transactions/deposit")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return deposit(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return deposit(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/transactions/withdraw")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return withdraw(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return withdraw(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/transactions/transfer")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return transfer(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return transfer(req); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/transactions/batch")
+        .methods("POST"_method)
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return batch(req); });
+        });
+    
+    CROW_ROUTE(app, "/api/v1/transactions/export")
+        .methods("GET"_method)
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return exportTransactions(req); });
+        });
 }
 
 crow::response TransactionController::getTransactions(const crow::request& req) {
@@ -44,17 +83,15 @@ crow::response TransactionController::getTransactions(const crow::request& req)
     auto endDate = req.url_params.get("endDate");
     auto limitStr = req.url_params.get("limit");
     auto offsetStr = req.url_params.get("offset");
+    auto cursorStr = req.url_params.get("cursor");
     
     std::optional<int> accountId;
     if (accountIdStr) {
         accountId = std::stoi(accountIdStr);
         
         // Verify user owns this account (unless admin)
-        if (!session->isAdmin) {
-            auto account = accountRepository_->findById(accountId.value());
-            if (!account || account->getUserId() != session->userId) {
-                return errorResponse(403, "Access denied");
-            }
+        if (!session->isAdmin && !session->ownsAccount(accountId.value())) {
+            return errorResponse(403, "Access denied");
         }
     }
     
@@ -66,43 +103,90 @@ crow::response TransactionController::getTransactions(const crow::request& req)
     int limit = limitStr ? std::stoi(limitStr) : 100;
     int offset = offsetStr ? std::stoi(offsetStr) : 0;
     
-    // Get transactions
-    std::vector<Transaction> transactions;
+    // Versions as of before the read, for the response cache
+    auto& cache = ResponseCache::getInstance();
+    auto tag = accountId.has_value() ? cache.accountTag(accountId.value())
+             : session->isAdmin ? cache.allTag()
+             : cache.userTag(session->userId);
+    
+    // Read committed data only: a page read on the shared connection could
+    // include a write that later rolls back, and nothing would then bump the
+    // tag it is cached under
+    std::unique_ptr<ReadSnapshot> snapshot;
+    try {
+        snapshot = db_->openReadSnapshot();
+    } catch (const std::exception& e) {
+        return errorResponse(500, "Failed to read transactions");
+    }
+    
+    // Get transactions. The page, its accounts and the response body are
+    // request temporaries and live in the request's arena.
+    std::pmr::memory_resource* arena = RequestArena::current();
+    TransactionBatch transactions(arena);
     
     if (session->isAdmin && !accountId.has_value()) {
         // Admin can see all transactions if no account specified
         transactions = transactionRepository_->findWithFilters(
-            std::nullopt, type, 
+            *snapshot, std::nullopt, type, 
             startDate ? std::optional<std::string>(startDate) : std::nullopt,
             endDate ? std::optional<std::string>(endDate) : std::nullopt,
-            limit, offset
+            limit, offset, arena
         );
     } else if (accountId.has_value()) {
         // Get transactions for specific account
         transactions = transactionRepository_->findWithFilters(
-            accountId, type,
+            *snapshot, accountId, type,
             startDate ? std::optional<std::string>(startDate) : std::nullopt,
             endDate ? std::optional<std::string>(endDate) : std::nullopt,
-            limit, offset
+            limit, offset, arena
         );
     } else {
-        // Get all transactions for user
-        transactions = transactionRepository_->findByUserId(session->userId);
+        // All of the user's accounts: keyset pages instead of offsets
+        std::optional<TransactionCursor> after;
+        if (cursorStr) {
+            after = TransactionCursor::decode(cursorStr);
+            if (!after) {
+                return errorResponse(400, "Invalid cursor");
+            }
+        }
+        
+        limit = std::clamp(limit, 1, kMaxHistoryPage);
+        transactions = transactionRepository_->findByUserId(*snapshot, session->userId, limit, after, arena);
     }
     
-    crow::json::wvalue response;
-    response["transactions"] = crow::json::wvalue(crow::json::type::List);
+    bool userHistory = !session->isAdmin && !accountId.has_value();
+    int total = userHistory
+        ? transactionRepository_->countByUserId(*snapshot, session->userId)
+        : transactionRepository_->getTransactionCount(*snapshot, accountId);
     
-    for (size_t i = 0; i < transactions.size(); ++i) {
-        response["transactions"][i] = transactionToJson(transactions[i], session->userId);
-    }
+    JsonWriter json(arena);
+    json.reserve(transactions.size() * kJsonBytesPerTransaction + 256);
+    json.beginObject().key("transactions").beginArray();
+    writeTransactions(json, *snapshot, transactions, *session);
+    json.endArray();
     
-    response["count"] = static_cast<int>(transactions.size());
-    response["total"] = transactionRepository_->getTransactionCount(accountId);
-    response["limit"] = limit;
-    response["offset"] = offset;
+    json.key("count").value(static_cast<int>(transactions.size()));
+    json.key("total").value(total);
+    json.key("limit").value(limit);
+    json.key("offset").value(offset);
     
-    return successResponse(response);
+    if (userHistory && static_cast<int>(transactions.size()) == limit) {
+        size_t last = transactions.size() - 1;
+        json.key("nextCursor").value(TransactionCursor{
+            Timestamp::format(transactions.createdAt[last]), transactions.ids[last] }.encode());
+    }
+    json.endObject();
+    
+    // Only first pages are cached; deeper pages are rarely requested twice
+    if (isFirstPage(req)) {
+        return cache.store(req, session->userId, tag, successResponse(json.view()));
+    }
+    return successResponse(json.view());
+}
+
+bool TransactionController::isFirstPage(const crow::request& req) {
+    const char* offset = req.url_params.get("offset");
+    return !req.url_params.get("cursor") && (!offset || std::string_view(offset) == "0");
 }
 
 crow::response TransactionController::getTransaction(const crow::request& req, int id) {
@@ -113,32 +197,19 @@ crow::response TransactionController::getTransaction(const crow::request& req, i
         return errorResponse(404, "Transaction not found");
     }
     
-    // Check access rights
+    // Check access rights: the user must own the from or the to account
     if (!session->isAdmin) {
-        bool hasAccess = false;
-        
-        // Check if user owns the from account
-        if (transaction->getFromAccountId().has_value()) {
-            auto fromAccount = accountRepository_->findById(transaction->getFromAccountId().value());
-            if (fromAccount && fromAccount->getUserId() == session->userId) {
-                hasAccess = true;
-            }
-        }
-        
-        // Check if user owns the to account
-        if (!hasAccess && transaction->getToAccountId().has_value()) {
-            auto toAccount = accountRepository_->findById(transaction->getToAccountId().value());
-            if (toAccount && toAccount->getUserId() == session->userId) {
-                hasAccess = true;
-            }
-        }
+        auto fromId = transaction->getFromAccountId();
+        auto toId = transaction->getToAccountId();
+        bool hasAccess = (fromId.has_value() && session->ownsAccount(fromId.value())) ||
+                         (toId.has_value() && session->ownsAccount(toId.value()));
         
         if (!hasAccess) {
             return errorResponse(403, "Access denied");
         }
     }
     
-    crow::json::wvalue response = transactionToJson(*transaction, session->userId);
+    crow::json::wvalue response = transactionToJson(*transaction, &*session);
     return successResponse(response);
 }
 
@@ -172,18 +243,16 @@ crow::response TransactionController::deposit(const crow::request& req) {
     }
     
     // Check ownership (unless admin)
-    if (!session->isAdmin && account->getUserId() != session->userId) {
+    if (!session->isAdmin && !session->ownsAccount(account->getId())) {
         return errorResponse(403, "Access denied");
     }
     
     // Process deposit
-    if (!processDeposit(account->getId(), amount, description)) {
+    account = processDeposit(account->getId(), amount, description);
+    if (!account) {
         return errorResponse(500, "Failed to process deposit");
     }
     
-    // Get updated account balance
-    account = accountRepository_->findById(account->getId());
-    
     crow::json::wvalue response;
     response["message"] = "Deposit successful";
     response["transactionDetails"]["accountNumber"] = account->getAccountNumber();
@@ -225,7 +294,7 @@ crow::response TransactionController::withdraw(const crow::request& req) {
     }
     
     // Check ownership (unless admin)
-    if (!session->isAdmin && account->getUserId() != session->userId) {
+    if (!session->isAdmin && !session->ownsAccount(account->getId())) {
         return errorResponse(403, "Access denied");
     }
     
@@ -242,13 +311,11 @@ crow::response TransactionController::withdraw(const crow::request& req) {
     }
     
     // Process withdrawal
-    if (!processWithdrawal(account->getId(), amount, description)) {
+    account = processWithdrawal(account->getId(), amount, description);
+    if (!account) {
         return errorResponse(500, "Failed to process withdrawal");
     }
     
-    // Get updated account balance
-    account = accountRepository_->findById(account->getId());
-    
     crow::json::wvalue response;
     response["message"] = "Withdrawal successful";
     response["transactionDetails"]["accountNumber"] = account->getAccountNumber();
@@ -291,7 +358,7 @@ crow::response TransactionController::transfer(const crow::request& req) {
     }
     
     // Check ownership (unless admin)
-    if (!session->isAdmin && fromAccount->getUserId() != session->userId) {
+    if (!session->isAdmin && !session->ownsAccount(fromAccount->getId())) {
         return errorResponse(403, "Access denied");
     }
     
@@ -319,13 +386,12 @@ crow::response TransactionController::transfer(const crow::request& req) {
     }
     
     // Process transfer
-    if (!processTransfer(fromAccount->getId(), toAccount->getId(), amount, description)) {
+    auto updated = processTransfer(fromAccount->getId(), toAccount->getId(), amount, description);
+    if (!updated) {
         return errorResponse(500, "Failed to process transfer");
     }
-    
-    // Get updated account balances
-    fromAccount = accountRepository_->findById(fromAccount->getId());
-    toAccount = accountRepository_->findById(toAccount->getId());
+    fromAccount = updated->first;
+    toAccount = updated->second;
     
     crow::json::wvalue response;
     response["message"] = "Transfer successful";
@@ -339,8 +405,321 @@ crow::response TransactionController::transfer(const crow::request& req) {
     return successResponse(response);
 }
 
+crow::response TransactionController::batch(const crow::request& req) {
+    REQUIRE_AUTH(req)
+    
+    auto body = crow::json::load(req.body);
+    if (!body) {
+        return errorResponse(400, "Invalid JSON");
+    }
+    
+    if (!body.has("operations") || body["operations"].t() != crow::json::type::List) {
+        return errorResponse(400, "Operations array is required");
+    }
+    
+    std::string mode = body.has("mode") ? std::string(body["mode"].s()) : "atomic";
+    if (mode != "atomic" && mode != "best_effort") {
+        return errorResponse(400, "Mode must be 'atomic' or 'best_effort'");
+    }
+    bool atomic = mode == "atomic";
+    
+    const auto& operations = body["operations"];
+    if (operations.size() == 0) {
+        return errorResponse(400, "Operations array is empty");
+    }
+    if (operations.size() > kMaxBatchOperations) {
+        return errorResponse(400, "Too many operations (max " + std::to_string(kMaxBatchOperations) + ")");
+    }
+    
+    // Parse and validate every operation before touching the database
+    struct Operation {
+        TransactionType type = TransactionType::Deposit;
+        std::string fromAccountNumber;
+        std::string toAccountNumber;
+        double amount = 0.0;
+        std::string description;
+        std::string error;
+    };
+    
+    std::vector<Operation> ops(operations.size());
+    std::vector<std::string> accountNumbers;
+    std::unordered_set<std::string> seenNumbers;
+    auto addAccountNumber = [&accountNumbers, &seenNumbers](const std::string& number) {
+        if (seenNumbers.insert(number).second) {
+            accountNumbers.push_back(number);
+        }
+    };
+    
+    for (size_t i = 0; i < operations.size(); ++i) {
+        const auto& item = operations[i];
+        Operation& op = ops[i];
+        
+        if (item.t() != crow::json::type::Object || !item.has("type") || !item.has("amount")) {
+            op.error = "Type and amount are required";
+            continue;
+        }
+        
+        std::string type = item["type"].s();
+        if (type == "deposit" || type == "withdraw") {
+            if (!item.has("accountNumber")) {
+                op.error = "Account number is required";
+                continue;
+            }
+            op.type = type == "deposit" ? TransactionType::Deposit : TransactionType::Withdrawal;
+            std::string accountNumber = item["accountNumber"].s();
+            (type == "deposit" ? op.toAccountNumber : op.fromAccountNumber) = accountNumber;
+            addAccountNumber(accountNumber);
+        } else if (type == "transfer") {
+            if (!item.has("fromAccountNumber") || !item.has("toAccountNumber")) {
+                op.error = "From account number and to account number are required";
+                continue;
+            }
+            op.type = TransactionType::Transfer;
+            op.fromAccountNumber = item["fromAccountNumber"].s();
+            op.toAccountNumber = item["toAccountNumber"].s();
+            if (op.fromAccountNumber == op.toAccountNumber) {
+                op.error = "Cannot transfer to the same account";
+                continue;
+            }
+            addAccountNumber(op.fromAccountNumber);
+            addAccountNumber(op.toAccountNumber);
+        } else {
+            op.error = "Type must be 'deposit', 'withdraw' or 'transfer'";
+            continue;
+        }
+        
+        op.amount = item["amount"].d();
+        if (!AccountUtils::isValidAmount(op.amount)) {
+            op.error = "Invalid amount";
+            continue;
+        }
+        op.amount = AccountUtils::roundToTwoDecimals(op.amount);
+        
+        if (item.has("description")) {
+            op.description = item["description"].s();
+        } else {
+            op.description = type == "deposit" ? "Deposit" : type == "withdraw" ? "Withdrawal" : "Transfer";
+        }
+    }
+    
+    auto validationFailure = [&ops]() -> std::optional<size_t> {
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (!ops[i].error.empty()) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    };
+    
+    // In atomic mode a malformed item rejects the whole batch up front
+    if (atomic) {
+        if (auto failed = validationFailure()) {
+            crow::json::wvalue error;
+            error["error"] = "Operation " + std::to_string(*failed) + ": " + ops[*failed].error;
+            error["failedIndex"] = *failed;
+            return crow::response(400, error);
+        }
+    }
+    
+    if (!db_->beginTransaction()) {
+        return errorResponse(500, "Failed to process batch");
+    }
+    
+    // Resolve every referenced account in one query and apply the operations
+    // to in-memory balances, in order
+    std::unordered_map<std::string, Account> accounts;
+    for (auto& account : accountRepository_->findByAccountNumbers(accountNumbers)) {
+        std::string number = account.getAccountNumber();
+        accounts.emplace(std::move(number), std::move(account));
+    }
+    
+    std::unordered_set<std::string> touched;
+    std::vector<Transaction> records;
+    std::vector<size_t> recordOps;
+    
+    for (size_t i = 0; i < ops.size(); ++i) {
+        Operation& op = ops[i];
+        if (!op.error.empty()) {
+            continue;
+        }
+        
+        Account* from = nullptr;
+        Account* to = nullptr;
+        if (!op.fromAccountNumber.empty()) {
+            auto it = accounts.find(op.fromAccountNumber);
+            from = it != accounts.end() ? &it->second : nullptr;
+        }
+        if (!op.toAccountNumber.empty()) {
+            auto it = accounts.find(op.toAccountNumber);
+            to = it != accounts.end() ? &it->second : nullptr;
+        }
+        
+        if ((!op.fromAccountNumber.empty() && !from) || (!op.toAccountNumber.empty() && !to)) {
+            op.error = "Account not found";
+        } else if (!session->isAdmin && !session->ownsAccount((from ? from : to)->getId())) {
+            // Customers may only move money out of, or deposit into, their own accounts
+            op.error = "Access denied";
+        } else if (from && !from->canWithdraw(op.amount)) {
+            op.error = "Insufficient funds";
+        }
+        
+        if (!op.error.empty()) {
+            if (atomic) {
+                db_->rollback();
+                crow::json::wvalue error;
+                error["error"] = "Operation " + std::to_string(i) + ": " + op.error;
+                error["failedIndex"] = i;
+                return crow::response(400, error);
+            }
+            continue;
+        }
+        
+        if (from) {
+            from->withdraw(op.amount);
+            touched.insert(op.fromAccountNumber);
+        }
+        if (to) {
+            to->deposit(op.amount);
+            touched.insert(op.toAccountNumber);
+        }
+        
+        records.emplace_back(from ? std::optional<int>(from->getId()) : std::nullopt,
+                             to ? std::optional<int>(to->getId()) : std::nullopt,
+                             op.amount, op.type, op.description);
+        records.back().setBalancesAfter(from ? std::optional<double>(from->getBalance()) : std::nullopt,
+                                        to ? std::optional<double>(to->getBalance()) : std::nullopt);
+        recordOps.push_back(i);
+    }
+    
+    std::vector<Account> updated;
+    updated.reserve(touched.size());
+    for (const auto& number : touched) {
+        updated.push_back(accounts.at(number));
+    }
+    
+    std::vector<int> ids;
+    if (!records.empty()) {
+        auto created = accountRepository_->updateBalances(updated)
+            ? transactionRepository_->createBatch(records)
+            : std::nullopt;
+        if (!created) {
+            db_->rollback();
+            return errorResponse(500, "Failed to process batch");
+        }
+        ids = std::move(*created);
+    }
+    
+    if (!db_->commit()) {
+        db_->rollback();
+        return errorResponse(500, "Failed to process batch");
+    }
+    
+    for (const auto& account : updated) {
+        ResponseCache::getInstance().accountChanged(account);
+    }
+    
+    std::vector<int> transactionIds(ops.size(), 0);
+    for (size_t r = 0; r < recordOps.size(); ++r) {
+        transactionIds[recordOps[r]] = ids[r];
+    }
+    
+    crow::json::wvalue response;
+    size_t succeeded = 0;
+    for (size_t i = 0; i < ops.size(); ++i) {
+        auto& result = response["results"][i];
+        result["index"] = i;
+        if (ops[i].error.empty()) {
+            result["status"] = "completed";
+            result["transactionId"] = transactionIds[i];
+            ++succeeded;
+        } else {
+            result["status"] = "failed";
+            result["error"] = ops[i].error;
+        }
+    }
+    
+    // Final balances of every account the batch changed
+    for (const auto& account : updated) {
+        response["balances"][account.getAccountNumber()] = AccountUtils::roundToTwoDecimals(account.getBalance());
+    }
+    
+    response["mode"] = mode;
+    response["succeeded"] = succeeded;
+    response["failed"] = ops.size() - succeeded;
+    
+    return successResponse(response);
+}
+
+crow::response TransactionController::exportTransactions(const crow::request& req) {
+    REQUIRE_AUTH(req)
+    
+    auto formatStr = req.url_params.get("format");
+    auto accountIdStr = req.url_params.get("accountId");
+    auto startDate = req.url_params.get("startDate");
+    auto endDate = req.url_params.get("endDate");
+    
+    auto format = stringToTransactionFileFormat(formatStr ? formatStr : "csv");
+    if (!format) {
+        return errorResponse(400, "Format must be 'csv' or 'ndjson'");
+    }
+    
+    // Customers export their own history; admins export everything
+    ExportFilter filter;
+    if (!session->isAdmin) {
+        filter.userId = session->userId;
+    }
+    
+    if (accountIdStr) {
+        filter.accountId = std::atoi(accountIdStr);
+        if (!session->isAdmin && !session->ownsAccount(filter.accountId.value())) {
+            return errorResponse(403, "Access denied");
+        }
+    }
+    if (startDate) {
+        filter.startDate = std::string(startDate);
+    }
+    if (endDate) {
+        filter.endDate = std::string(endDate);
+    }
+    
+    bool csv = format == TransactionFileFormat::Csv;
+    auto& spool = ExportSpool::getInstance();
+    auto created = spool.createFile(csv ? "csv" : "ndjson");
+    if (!created) {
+        return errorResponse(500, "Failed to create export file");
+    }
+    std::string path = std::move(*created);
+    
+    ExportResult result;
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            spool.remove(path);
+            return errorResponse(500, "Failed to create export file");
+        }
+        
+        TransactionExporter exporter(db_);
+        result = exporter.run(out, *format, filter);
+    }
+    
+    if (!result.success) {
+        LOG_ERROR("Export failed", "error", result.error);
+        spool.remove(path);
+        return errorResponse(500, "Failed to export transactions");
+    }
+    
+    // Crow streams the file to the client in chunks; dispatchToDb releases
+    // it from the spool once sent
+    crow::response res;
+    res.set_static_file_info_unsafe(path);
+    res.set_header("Content-Type", csv ? "text/csv" : "application/x-ndjson");
+    res.set_header("Content-Disposition", std::string("attachment; filename=\"transactions.") + (csv ? "csv" : "ndjson") + "\"");
+    res.set_header("X-Export-Rows", std::to_string(result.rows));
+    return res;
+}
+
 crow::json::wvalue TransactionController::transactionToJson(const Transaction& transaction, 
-                                                           std::optional<int> currentUserId) {
+                                                           const Session* viewer) {
     crow::json::wvalue json;
     json["id"] = transaction.getId();
     json["type"] = transactionTypeToString(transaction.getTransactionType());
@@ -350,6 +729,14 @@ crow::json::wvalue TransactionController::transactionToJson(const Transaction& t
     json["status"] = transactionStatusToString(transaction.getStatus());
     json["createdAt"] = transaction.getCreatedAt();
     
+    // Balances right after this transaction, when recorded
+    if (transaction.getFromBalanceAfter().has_value()) {
+        json["fromBalanceAfter"] = AccountUtils::roundToTwoDecimals(transaction.getFromBalanceAfter().value());
+    }
+    if (transaction.getToBalanceAfter().has_value()) {
+        json["toBalanceAfter"] = AccountUtils::roundToTwoDecimals(transaction.getToBalanceAfter().value());
+    }
+    
     // Add account details
     if (transaction.getFromAccountId().has_value()) {
         auto fromAccount = accountRepository_->findById(transaction.getFromAccountId().value());
@@ -370,118 +757,217 @@ crow::json::wvalue TransactionController::transactionToJson(const Transaction& t
     }
     
     // Add direction and sign for current user's perspective
-    if (currentUserId.has_value()) {
+    if (viewer) {
         // Find which account belongs to the current user
         int userAccountId = 0;
-        if (transaction.getFromAccountId().has_value()) {
-            auto account = accountRepository_->findById(transaction.getFromAccountId().value());
-            if (account && account->getUserId() == currentUserId.value()) {
-                userAccountId = account->getId();
-            }
-        }
-        if (userAccountId == 0 && transaction.getToAccountId().has_value()) {
-            auto account = accountRepository_->findById(transaction.getToAccountId().value());
-            if (account && account->getUserId() == currentUserId.value()) {
-                userAccountId = account->getId();
-            }
+        if (transaction.getFromAccountId().has_value() && viewer->ownsAccount(transaction.getFromAccountId().value())) {
+            userAccountId = transaction.getFromAccountId().value();
+        } else if (transaction.getToAccountId().has_value() && viewer->ownsAccount(transaction.getToAccountId().value())) {
+            userAccountId = transaction.getToAccountId().value();
         }
         
         if (userAccountId > 0) {
             json["direction"] = TransactionUtils::getTransactionDirection(transaction, userAccountId);
             std::string sign = TransactionUtils::getAmountSign(transaction, userAccountId);
             json["displayAmount"] = sign + AccountUtils::formatCurrency(transaction.getAmount());
+            
+            auto balanceAfter = transaction.getFromAccountId() == userAccountId
+                ? transaction.getFromBalanceAfter()
+                : transaction.getToBalanceAfter();
+            if (balanceAfter.has_value()) {
+                json["balanceAfter"] = AccountUtils::roundToTwoDecimals(balanceAfter.value());
+            }
         }
     }
     
     return json;
 }
 
-bool TransactionController::processDeposit(int accountId, double amount, const std::string& description) {
+void TransactionController::writeTransactions(JsonWriter& json, ReadSnapshot& snapshot,
+                                              const TransactionBatch& transactions, const Session& viewer) {
+    std::pmr::memory_resource* resource = transactions.ids.get_allocator().resource();
+    
+    // Every account on the page in one query, instead of two lookups per row
+    std::pmr::vector<int> accountIds(resource);
+    accountIds.reserve(transactions.size() * 2);
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (transactions.fromAccountIds[i] > 0) {
+            accountIds.push_back(transactions.fromAccountIds[i]);
+        }
+        if (transactions.toAccountIds[i] > 0) {
+            accountIds.push_back(transactions.toAccountIds[i]);
+        }
+    }
+    std::sort(accountIds.begin(), accountIds.end());
+    accountIds.erase(std::unique(accountIds.begin(), accountIds.end()), accountIds.end());
+    
+    std::pmr::vector<Account> accounts = accountRepository_->findByIds(snapshot, accountIds, resource);
+    std::sort(accounts.begin(), accounts.end(),
+              [](const Account& a, const Account& b) { return a.getId() < b.getId(); });
+    
+    auto writeAccount = [&](std::string_view key, std::optional<int> id) {
+        if (!id.has_value()) {
+            return;
+        }
+        auto it = std::lower_bound(accounts.begin(), accounts.end(), id.value(),
+                                   [](const Account& account, int value) { return account.getId() < value; });
+        if (it == accounts.end() || it->getId() != id.value()) {
+            return;
+        }
+        json.key(key).beginObject();
+        json.key("id").value(it->getId());
+        json.key("accountNumber").value(it->getAccountNumberView());
+        json.key("accountType").value(kAccountTypeCodec.name(it->getAccountType()));
+        json.endObject();
+    };
+    
+    // Same fields as transactionToJson, formatted into stack buffers
+    char createdAt[Timestamp::kFormattedSize];
+    char money[48];
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const Transaction transaction = transactions.at(i);
+        double amount = transaction.getAmount();
+        
+        json.beginObject();
+        json.key("id").value(transaction.getId());
+        json.key("type").value(kTransactionTypeCodec.name(transaction.getTransactionType()));
+        json.key("amount").value(AccountUtils::roundToTwoDecimals(amount));
+        std::snprintf(money, sizeof(money), "$%.2f", amount);
+        json.key("formattedAmount").value(money);
+        json.key("description").value(transaction.getDescription());
+        json.key("status").value(kTransactionStatusCodec.name(transaction.getStatus()));
+        json.key("createdAt").value(std::string_view(
+            createdAt, Timestamp::formatTo(transaction.getCreatedAtSeconds(), createdAt)));
+        
+        if (transaction.getFromBalanceAfter().has_value()) {
+            json.key("fromBalanceAfter").value(AccountUtils::roundToTwoDecimals(transaction.getFromBalanceAfter().value()));
+        }
+        if (transaction.getToBalanceAfter().has_value()) {
+            json.key("toBalanceAfter").value(AccountUtils::roundToTwoDecimals(transaction.getToBalanceAfter().value()));
+        }
+        
+        writeAccount("fromAccount", transaction.getFromAccountId());
+        writeAccount("toAccount", transaction.getToAccountId());
+        
+        // Direction and sign from the viewer's side
+        int userAccountId = 0;
+        if (transaction.getFromAccountId().has_value() && viewer.ownsAccount(transaction.getFromAccountId().value())) {
+            userAccountId = transaction.getFromAccountId().value();
+        } else if (transaction.getToAccountId().has_value() && viewer.ownsAccount(transaction.getToAccountId().value())) {
+            userAccountId = transaction.getToAccountId().value();
+        }
+        
+        if (userAccountId > 0) {
+            json.key("direction").value(TransactionUtils::getTransactionDirection(transaction, userAccountId));
+            std::snprintf(money, sizeof(money), "%s$%.2f",
+                          TransactionUtils::getAmountSign(transaction, userAccountId).c_str(), amount);
+            json.key("displayAmount").value(money);
+            
+            auto balanceAfter = transaction.getFromAccountId() == userAccountId
+                ? transaction.getFromBalanceAfter()
+                : transaction.getToBalanceAfter();
+            if (balanceAfter.has_value()) {
+                json.key("balanceAfter").value(AccountUtils::roundToTwoDecimals(balanceAfter.value()));
+            }
+        }
+        json.endObject();
+    }
+}
+
+std::optional<Account> TransactionController::processDeposit(int accountId, double amount, const std::string& description) {
     // Begin transaction
     if (!db_->beginTransaction()) {
-        std::cerr << "Failed to begin transaction for deposit" << std::endl;
-        return false;
+        LOG_ERROR("Failed to begin transaction for deposit", "account_id", accountId);
+        return std::nullopt;
     }
     
     try {
         // Get account
         auto account = accountRepository_->findById(accountId);
         if (!account) {
-            std::cerr << "Account not found: " << accountId << std::endl;
+            LOG_WARN("Account not found", "account_id", accountId);
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         // Update account balance
         account->deposit(amount);
         if (!accountRepository_->update(*account)) {
-            std::cerr << "Failed to update account balance" << std::endl;
+            LOG_ERROR("Failed to update account balance", "account_id", accountId);
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         // Create transaction record
         Transaction transaction(std::nullopt, accountId, amount, 
                               TransactionType::Deposit, description);
+        transaction.setBalancesAfter(std::nullopt, account->getBalance());
         
         auto createdTransaction = transactionRepository_->create(transaction);
         if (!createdTransaction) {
-            std::cerr << "Failed to create transaction record" << std::endl;
+            LOG_ERROR("Failed to create transaction record", "account_id", accountId);
             db_->rollback();
-            return false;
+            return std::nullopt;
         }
         
         if (!db_->commit()) {
-            std::cerr << "Failed to commit transaction" << std::endl;
-            return false;
+            LOG_ERROR("Failed to commit transaction", "account_id", accountId);
+            db_->rollback();
+            return std::nullopt;
         }
         
-        return true;
+        ResponseCache::getInstance().accountChanged(*account);
+        return account;
     } catch (const std::exception& e) {
-        std::cerr << "Exception in processDeposit: " << e.what() << std::endl;
+        LOG_ERROR("Exception in processDeposit", "error", e.what());
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
 }
 
-bool TransactionController::processWithdrawal(int accountId, double amount, const std::string& description) {
+std::optional<Account> TransactionController::processWithdrawal(int accountId, double amount, const std::string& description) {
     // Begin transaction
     if (!db_->beginTransaction()) {
-        return false;
+        return std::nullopt;
     }
     
     // Get account
     auto account = accountRepository_->findById(accountId);
     if (!account || !account->canWithdraw(amount)) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
     
     // Update account balance
     account->withdraw(amount);
     if (!accountRepository_->update(*account)) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
     
     // Create transaction record
     Transaction transaction(accountId, std::nullopt, amount, 
                           TransactionType::Withdrawal, description);
+    transaction.setBalancesAfter(account->getBalance(), std::nullopt);
     
     if (!transactionRepository_->create(transaction)) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
     
-    db_->commit();
-    return true;
+    if (!db_->commit()) {
+        db_->rollback();
+        return std::nullopt;
+    }
+    ResponseCache::getInstance().accountChanged(*account);
+    return account;
 }
 
-bool TransactionController::processTransfer(int fromAccountId, int toAccountId, 
-                                          double amount, const std::string& description) {
+std::optional<std::pair<Account, Account>> TransactionController::processTransfer(int fromAccountId, int toAccountId, 
+                                                                                 double amount, const std::string& description) {
     // Begin transaction
     if (!db_->beginTransaction()) {
-        return false;
+        return std::nullopt;
     }
     
     // Get both accounts
@@ -490,7 +976,7 @@ bool TransactionController::processTransfer(int fromAccountId, int toAccountId,
     
     if (!fromAccount || !toAccount || !fromAccount->canWithdraw(amount)) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
     
     // Update account balances
@@ -499,18 +985,24 @@ bool TransactionController::processTransfer(int fromAccountId, int toAccountId,
     
     if (!accountRepository_->update(*fromAccount) || !accountRepository_->update(*toAccount)) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
     
     // Create transaction record
     Transaction transaction(fromAccountId, toAccountId, amount, 
                           TransactionType::Transfer, description);
+    transaction.setBalancesAfter(fromAccount->getBalance(), toAccount->getBalance());
     
     if (!transactionRepository_->create(transaction)) {
         db_->rollback();
-        return false;
+        return std::nullopt;
     }
     
-    db_->commit();
-    return true;
+    if (!db_->commit()) {
+        db_->rollback();
+        return std::nullopt;
+    }
+    ResponseCache::getInstance().accountChanged(*fromAccount);
+    ResponseCache::getInstance().accountChanged(*toAccount);
+    return std::make_pair(*fromAccount, *toAccount);
 }
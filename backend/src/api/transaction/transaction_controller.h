@@ -3,17 +3,25 @@
 #include <crow.h>
 #include <crow/middlewares/cors.h>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 #include "repository/transaction/transaction_repository.h"
 #include "repository/account/account_repository.h"
 #include "db/db.h"
+#include "db/db_executor.h"
+#include "api/shared/auth_middleware.h"
+#include "api/shared/json_writer.h"
 
 class TransactionController {
 public:
-    TransactionController(std::shared_ptr<Database> db);
+    TransactionController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor);
     
     void registerRoutes(crow::App<crow::CORSHandler>& app);
     
 private:
+    std::shared_ptr<DbExecutor> executor_;
     std::shared_ptr<Database> db_;
     std::unique_ptr<TransactionRepository> transactionRepository_;
     std::unique_ptr<AccountRepository> accountRepository_;
@@ -24,10 +32,26 @@ private:
     crow::response deposit(const crow::request& req);
     crow::response withdraw(const crow::request& req);
     crow::response transfer(const crow::request& req);
+    crow::response batch(const crow::request& req);
+    crow::response exportTransactions(const crow::request& req);
+    
+    // Upper bound on operations accepted by one batch request
+    static constexpr size_t kMaxBatchOperations = 1000;
+    
+    // Upper bound on one page of a user's history
+    static constexpr int kMaxHistoryPage = 1000;
+    
+    // Response bytes reserved per transaction when writing a page
+    static constexpr size_t kJsonBytesPerTransaction = 512;
     
     // Helper methods
-    crow::json::wvalue transactionToJson(const Transaction& transaction, std::optional<int> currentUserId = std::nullopt);
-    bool processDeposit(int accountId, double amount, const std::string& description);
-    bool processWithdrawal(int accountId, double amount, const std::string& description);
-    bool processTransfer(int fromAccountId, int toAccountId, double amount, const std::string& description);
+    crow::json::wvalue transactionToJson(const Transaction& transaction, const Session* viewer = nullptr);
+    void writeTransactions(JsonWriter& json, ReadSnapshot& snapshot, const TransactionBatch& transactions,
+                           const Session& viewer);
+    static bool isFirstPage(const crow::request& req);
+    // Each returns the accounts as committed, or nothing if the write failed
+    std::optional<Account> processDeposit(int accountId, double amount, const std::string& description);
+    std::optional<Account> processWithdrawal(int accountId, double amount, const std::string& description);
+    std::optional<std::pair<Account, Account>> processTransfer(int fromAccountId, int toAccountId, double amount,
+                                                               const std::string& description);
 };
@@ -25,6 +25,14 @@ public:
             json["toAccountId"] = transaction.getToAccountId().value();
         }
         
+        if (transaction.getFromBalanceAfter().has_value()) {
+            json["fromBalanceAfter"] = AccountUtils::roundToTwoDecimals(transaction.getFromBalanceAfter().value());
+        }
+        
+        if (transaction.getToBalanceAfter().has_value()) {
+            json["toBalanceAfter"] = AccountUtils::roundToTwoDecimals(transaction.getToBalanceAfter().value());
+        }
+        
         return json;
     }
     
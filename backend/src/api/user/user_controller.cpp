@@ -1,48 +1,69 @@
 #include "api/user/user_controller.h"
 #include "api/shared/error_response.h"
 #include "api/shared/auth_middleware.h"
+#include "api/shared/async_handler.h"
+#include "api/shared/response_cache.h"
 #include "domain/user/user_utils.h"
+#include "repository/account/account_number_filter.h"
 #include <crow/json.h>
 #include <crow/middlewares/cors.h>
 #include <iostream>
 
-UserController::UserController(std::shared_ptr<Database> db) 
-    : userRepository_(std::make_unique<UserRepository>(db)) {}
+UserController::UserController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor) 
+    : executor_(executor),
+      userRepository_(std::make_unique<UserRepository>(db)),
+      accountRepository_(std::make_unique<AccountRepository>(db)) {}
 
 void UserController::registerRoutes(crow::App<crow::CORSHandler>& app) {
     // Authentication routes
     CROW_ROUTE(app, "/api/v1/auth/login")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return login(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return login(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/auth/logout")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return logout(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return logout(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/auth/me")
         .methods("GET"_method)
-        ([this](const crow::request& req) { return getCurrentUser(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return getCurrentUser(req); });
+        });
     
     // User management routes
     CROW_ROUTE(app, "/api/v1/users")
         .methods("GET"_method)
-        ([this](const crow::request& req) { return getUsers(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return getUsers(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/users/<int>")
         .methods("GET"_method)
-        ([this](const crow::request& req, int id) { return getUser(req, id); });
+        ([this](const crow::request& req, crow::response& res, int id) {
+            dispatchToDb(*executor_, req, res, [this, &req, id] { return getUser(req, id); });
+        });
     
     CROW_ROUTE(app, "/api/v1/users")
         .methods("POST"_method)
-        ([this](const crow::request& req) { return createUser(req); });
+        ([this](const crow::request& req, crow::response& res) {
+            dispatchToDb(*executor_, req, res, [this, &req] { return createUser(req); });
+        });
     
     CROW_ROUTE(app, "/api/v1/users/<int>")
         .methods("PATCH"_method)
-        ([this](const crow::request& req, int id) { return updateUser(req, id); });
+        ([this](const crow::request& req, crow::response& res, int id) {
+            dispatchToDb(*executor_, req, res, [this, &req, id] { return updateUser(req, id); });
+        });
     
     CROW_ROUTE(app, "/api/v1/users/<int>")
         .methods("DELETE"_method)
-        ([this](const crow::request& req, int id) { return deleteUser(req, id); });
+        ([this](const crow::request& req, crow::response& res, int id) {
+            dispatchToDb(*executor_, req, res, [this, &req, id] { return deleteUser(req, id); });
+        });
 }
 
 crow::response UserController::login(const crow::request& req) {
@@ -70,9 +91,12 @@ crow::response UserController::login(const crow::request& req) {
         return errorResponse(401, "Invalid credentials");
     }
     
-    // Create session
+    // Create session, then carry the user's accounts for ownership checks.
+    // Loading them after the session is registered means an account created
+    // concurrently is either in this read or granted to the session.
     auto& auth = AuthMiddleware::getInstance();
     std::string token = auth.createSession(user->getId(), user->getUsername(), user->isAdmin());
+    auth.grantAccounts(user->getId(), accountRepository_->findIdsByUserId(user->getId()));
     
     crow::json::wvalue response;
     response["token"] = token;
@@ -224,7 +248,7 @@ crow::response UserController::updateUser(const crow::request& req, int id) {
     
     // Update user type if admin
     if (session->isAdmin && body.has("userType")) {
-        user->setUserType(stringToUserType(body["userType"].s()));
+        user->setUserType(stringToUserType(std::string(body["userType"].s())));
     }
     
     if (!userRepository_->update(*user)) {
@@ -244,10 +268,23 @@ crow::response UserController::deleteUser(const crow::request& req, int id) {
         return errorResponse(400, "Cannot delete your own account");
     }
     
+    auto accounts = accountRepository_->findByUserId(id);
+    
     if (!userRepository_->deleteById(id)) {
         return errorResponse(404, "User not found");
     }
     
+    // The user's accounts went with it
+    AuthMiddleware::getInstance().destroyUserSessions(id);
+    for (const auto& account : accounts) {
+        AccountNumberFilter::getInstance().remove(account.getAccountNumber());
+    }
+    
+    // Other users' histories refer to the removed accounts too
+    if (!accounts.empty()) {
+        ResponseCache::getInstance().clear();
+    }
+    
     crow::json::wvalue response;
     response["message"] = "User deleted successfully";
     return successResponse(response);
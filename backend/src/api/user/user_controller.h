@@ -4,16 +4,20 @@
 #include <crow/middlewares/cors.h>
 #include <memory>
 #include "repository/user/user_repository.h"
+#include "repository/account/account_repository.h"
 #include "db/db.h"
+#include "db/db_executor.h"
 
 class UserController {
 public:
-    UserController(std::shared_ptr<Database> db);
+    UserController(std::shared_ptr<Database> db, std::shared_ptr<DbExecutor> executor);
     
     void registerRoutes(crow::App<crow::CORSHandler>& app);
     
 private:
+    std::shared_ptr<DbExecutor> executor_;
     std::unique_ptr<UserRepository> userRepository_;
+    std::unique_ptr<AccountRepository> accountRepository_;
     
     // Auth endpoints
     crow::response login(const crow::request& req);
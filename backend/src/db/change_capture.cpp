@@ -0,0 +1,182 @@
+#include "db/change_capture.h"
+#include "logging/logger.h"
+#include "utils/metrics.h"
+#include <cstring>
+#include <exception>
+#include <string>
+
+ChangeCapture::ChangeCapture(std::shared_ptr<Database> db) : db_(db) {
+    std::string journalMode;
+    db_->query("PRAGMA journal_mode", [&journalMode](sqlite3_stmt* stmt) {
+        journalMode = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    });
+    if (journalMode != "wal") {
+        LOG_WARN("Change capture disabled: database is not in WAL mode", "journal_mode", journalMode);
+        return;
+    }
+    
+    pending_.reserve(kMaxChangesPerCommit);
+    sealed_.reserve(kMaxChangesPerCommit);
+    dispatcher_ = std::thread([this] { dispatchLoop(); });
+    
+    sqlite3* handle = db_->getHandle();
+    sqlite3_update_hook(handle, &ChangeCapture::onUpdate, this);
+    sqlite3_commit_hook(handle, &ChangeCapture::onCommit, this);
+    sqlite3_rollback_hook(handle, &ChangeCapture::onRollback, this);
+    sqlite3_wal_hook(handle, &ChangeCapture::onWalCommit, this);
+    attached_ = true;
+}
+
+ChangeCapture::~ChangeCapture() {
+    if (!attached_) {
+        return;
+    }
+    
+    // Back to SQLite's own checkpointing once no hook refers to this object
+    sqlite3* handle = db_->getHandle();
+    sqlite3_update_hook(handle, nullptr, nullptr);
+    sqlite3_commit_hook(handle, nullptr, nullptr);
+    sqlite3_rollback_hook(handle, nullptr, nullptr);
+    sqlite3_wal_autocheckpoint(handle, kAutoCheckpointPages);
+    
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex_);
+        stopping_ = true;
+    }
+    dispatchWake_.notify_one();
+    dispatcher_.join();
+}
+
+void ChangeCapture::subscribe(Subscriber subscriber) {
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    subscribers_.push_back(std::move(subscriber));
+}
+
+void ChangeCapture::onUpdate(void* self, int op, const char*, const char* table, sqlite3_int64 rowId) {
+    ChangeTable changed;
+    if (std::strcmp(table, "transactions") == 0) {
+        changed = ChangeTable::Transactions;
+    } else if (std::strcmp(table, "accounts") == 0) {
+        changed = ChangeTable::Accounts;
+    } else {
+        return;
+    }
+    
+    ChangeOp operation = op == SQLITE_INSERT ? ChangeOp::Insert
+                       : op == SQLITE_DELETE ? ChangeOp::Delete
+                       : ChangeOp::Update;
+    static_cast<ChangeCapture*>(self)->record(changed, operation, rowId);
+}
+
+int ChangeCapture::onCommit(void* self) {
+    auto* capture = static_cast<ChangeCapture*>(self);
+    capture->sealed_.swap(capture->pending_);
+    capture->sealedOverflowed_ = capture->pendingOverflowed_;
+    capture->pending_.clear();
+    capture->pendingOverflowed_ = false;
+    return 0;   // let the commit proceed
+}
+
+void ChangeCapture::onRollback(void* self) {
+    auto* capture = static_cast<ChangeCapture*>(self);
+    capture->pending_.clear();
+    capture->pendingOverflowed_ = false;
+    capture->sealed_.clear();
+    capture->sealedOverflowed_ = false;
+}
+
+int ChangeCapture::onWalCommit(void* self, sqlite3* handle, const char* database, int pages) {
+    static_cast<ChangeCapture*>(self)->publish();
+    if (pages >= kAutoCheckpointPages) {
+        sqlite3_wal_checkpoint_v2(handle, database, SQLITE_CHECKPOINT_PASSIVE, nullptr, nullptr);
+    }
+    return SQLITE_OK;
+}
+
+void ChangeCapture::record(ChangeTable table, ChangeOp op, int64_t rowId) {
+    if (pendingOverflowed_) {
+        return;
+    }
+    
+    // Triggers touch a row again right after the statement that changed it
+    // (updated_at, change_seq); fold those into the entry already there
+    if (!pending_.empty() && pending_.back().table == table && pending_.back().rowId == rowId) {
+        RowChange& last = pending_.back();
+        if (op == ChangeOp::Delete) {
+            last.op = ChangeOp::Delete;
+        } else if (last.op == ChangeOp::Delete) {
+            last.op = ChangeOp::Update;
+        }
+        return;
+    }
+    
+    if (pending_.size() == kMaxChangesPerCommit) {
+        pending_.clear();
+        pendingOverflowed_ = true;
+        return;
+    }
+    pending_.push_back(RowChange{ table, op, rowId });
+}
+
+void ChangeCapture::publish() {
+    if (sealed_.empty() && !sealedOverflowed_) {
+        return;
+    }
+    
+    ChangeBatch* batch = ring_.claim();
+    if (!batch) {
+        // The dispatcher is behind; the next batch tells subscribers so
+        Metrics::getInstance().increment(Counter::ChangeBatchesDropped);
+        dropped_ = true;
+        sealed_.clear();
+        sealedOverflowed_ = false;
+        return;
+    }
+    
+    // The slot's old vector comes back empty for reuse, so steady-state
+    // publishing does not allocate
+    batch->sequence = ++published_;
+    batch->overflowed = sealedOverflowed_ || dropped_;
+    batch->changes.swap(sealed_);
+    sealed_.clear();
+    sealedOverflowed_ = false;
+    dropped_ = false;
+    ring_.publish();
+    
+    if (!wakeRequested_.exchange(true, std::memory_order_relaxed)) {
+        dispatchWake_.notify_one();
+    }
+}
+
+void ChangeCapture::dispatchLoop() {
+    std::unique_lock<std::mutex> lock(dispatchMutex_);
+    while (true) {
+        bool stopping = stopping_;
+        lock.unlock();
+        
+        wakeRequested_.store(false, std::memory_order_relaxed);
+        while (const ChangeBatch* batch = ring_.front()) {
+            {
+                std::lock_guard<std::mutex> subscribersLock(subscribersMutex_);
+                for (auto& subscriber : subscribers_) {
+                    try {
+                        subscriber(*batch);
+                    } catch (const std::exception& e) {
+                        LOG_ERROR("Change subscriber failed", "batch", batch->sequence, "error", e.what());
+                    }
+                }
+            }
+            ring_.release();
+            Metrics::getInstance().increment(Counter::ChangeBatchesPublished);
+        }
+        
+        lock.lock();
+        if (stopping) {
+            return;
+        }
+        // A wake-up raced with the drain above is picked up by the timeout
+        dispatchWake_.wait_for(lock, kDispatchInterval, [this] {
+            return stopping_ || wakeRequested_.load(std::memory_order_relaxed);
+        });
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "db/db.h"
+#include "utils/spsc_ring.h"
+
+enum class ChangeTable : uint8_t { Accounts, Transactions };
+enum class ChangeOp : uint8_t { Insert, Update, Delete };
+
+struct RowChange {
+    ChangeTable table;
+    ChangeOp op;
+    int64_t rowId;
+};
+
+// The account and transaction rows one committed DB transaction touched, in
+// the order it touched them. A row changed several times (for example by
+// the statement and then by its triggers) appears once.
+struct ChangeBatch {
+    uint64_t sequence = 0;      // committed batches published before, plus one
+    // The commit changed too many rows to list, or earlier commits were
+    // dropped: subscribers cannot rely on changes and should recompute
+    bool overflowed = false;
+    std::vector<RowChange> changes;
+};
+
+// Change data capture on the Database connection. SQLite hooks record which
+// accounts and transactions rows each write transaction inserts, updates or
+// deletes; once the commit has reached the WAL, the batch is handed through
+// a lock-free ring to a dispatcher thread that passes it to every
+// subscriber. Subscribers therefore see only durable changes, in commit
+// order, off the request path.
+//
+// A listed row may have been removed again by a statement that failed inside
+// the transaction; subscribers that read rows back must skip missing ones.
+// Needs WAL mode. Only one instance may be attached to a connection, and
+// writes made by other processes are not seen.
+class ChangeCapture {
+public:
+    using Subscriber = std::function<void(const ChangeBatch& batch)>;
+    
+    explicit ChangeCapture(std::shared_ptr<Database> db);
+    ~ChangeCapture();
+    
+    // Prevent copying
+    ChangeCapture(const ChangeCapture&) = delete;
+    ChangeCapture& operator=(const ChangeCapture&) = delete;
+    
+    // Called on the dispatcher thread for every batch published after this
+    void subscribe(Subscriber subscriber);
+    
+    bool attached() const { return attached_; }
+    
+private:
+    static constexpr size_t kRingCapacity = 256;
+    static constexpr size_t kMaxChangesPerCommit = 4096;
+    static constexpr auto kDispatchInterval = std::chrono::milliseconds(20);
+    
+    // Installing a WAL hook replaces SQLite's automatic checkpoint, so the
+    // hook runs it itself at the default threshold
+    static constexpr int kAutoCheckpointPages = 1000;
+    
+    // SQLite callbacks. They run inside sqlite3_step under the connection's
+    // mutex, one at a time, which also makes the committing thread the
+    // ring's only producer at any moment.
+    static void onUpdate(void* self, int op, const char* database, const char* table, sqlite3_int64 rowId);
+    static int onCommit(void* self);
+    static void onRollback(void* self);
+    static int onWalCommit(void* self, sqlite3* handle, const char* database, int pages);
+    
+    void record(ChangeTable table, ChangeOp op, int64_t rowId);
+    void publish();
+    void dispatchLoop();
+    
+    std::shared_ptr<Database> db_;
+    bool attached_ = false;
+    
+    // Connection mutex only (hooks)
+    std::vector<RowChange> pending_;     // the open transaction
+    bool pendingOverflowed_ = false;
+    std::vector<RowChange> sealed_;      // committed, waiting for the WAL hook
+    bool sealedOverflowed_ = false;
+    bool dropped_ = false;               // a batch was lost since the last publish
+    uint64_t published_ = 0;
+    
+    SpscRing<ChangeBatch, kRingCapacity> ring_;
+    
+    std::mutex subscribersMutex_;
+    std::vector<Subscriber> subscribers_;
+    
+    std::mutex dispatchMutex_;
+    std::condition_variable dispatchWake_;
+    std::atomic<bool> wakeRequested_{false};
+    bool stopping_ = false;
+    std::thread dispatcher_;
+};
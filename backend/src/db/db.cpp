@@ -1,12 +1,15 @@
 #include "db/db.h"
-#include <iostream>
+#include "db/query_deadline.h"
+#include "db/read_snapshot.h"
+#include "db/schema_upgrades.h"
+#include "logging/logger.h"
 #include <fstream>
 #include <sstream>
 
-Database::Database(const std::string& dbPath) : db_(nullptr), inTransaction_(false) {
+Database::Database(const std::string& dbPath) : db_(nullptr), path_(dbPath), inTransaction_(false) {
     int rc = sqlite3_open(dbPath.c_str(), &db_);
     if (rc != SQLITE_OK) {
-        std::cerr << "Failed to open database: " << sqlite3_errmsg(db_) << std::endl;
+        LOG_ERROR("Failed to open database", "path", dbPath, "error", sqlite3_errmsg(db_));
         sqlite3_close(db_);
         db_ = nullptr;
         throw std::runtime_error("Failed to open database");
@@ -18,6 +21,9 @@ Database::Database(const std::string& dbPath) : db_(nullptr), inTransaction_(fal
     // Set journal mode for better transaction handling
     execute("PRAGMA journal_mode = WAL");
     
+    // Let per-request deadlines interrupt long-running statements
+    enableDeadlines(db_);
+    
     // Initialize schema
     if (!initializeSchema()) {
         throw std::runtime_error("Failed to initialize database schema");
@@ -39,7 +45,7 @@ bool Database::execute(const std::string& sql) {
     if (rc != SQLITE_OK) {
         std::string error = errMsg ? errMsg : "Unknown error";
         sqlite3_free(errMsg);
-        std::cerr << "SQL error: " << error << std::endl;
+        LOG_ERROR("SQL error", "error", error);
         return false;
     }
     
@@ -54,7 +60,7 @@ bool Database::query(const std::string& sql,
     int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
     
     if (rc != SQLITE_OK) {
-        std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db_) << std::endl;
+        LOG_ERROR("Failed to prepare statement", "error", sqlite3_errmsg(db_));
         return false;
     }
     
@@ -76,7 +82,7 @@ std::shared_ptr<sqlite3_stmt> Database::prepare(const std::string& sql) {
     int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
     
     if (rc != SQLITE_OK) {
-        std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db_) << std::endl;
+        LOG_ERROR("Failed to prepare statement", "error", sqlite3_errmsg(db_));
         return nullptr;
     }
     
@@ -87,7 +93,7 @@ bool Database::beginTransaction() {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (inTransaction_) {
-        std::cerr << "Already in transaction" << std::endl;
+        LOG_ERROR("Already in transaction");
         return false;
     }
     
@@ -97,7 +103,7 @@ bool Database::beginTransaction() {
     if (rc != SQLITE_OK) {
         std::string error = errMsg ? errMsg : "Unknown error";
         sqlite3_free(errMsg);
-        std::cerr << "Failed to begin transaction: " << error << std::endl;
+        LOG_ERROR("Failed to begin transaction", "error", error);
         return false;
     }
     
@@ -109,21 +115,23 @@ bool Database::commit() {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (!inTransaction_) {
-        std::cerr << "Not in transaction" << std::endl;
+        LOG_ERROR("Not in transaction");
         return false;
     }
     
+    QueryDeadline::Suspend noInterrupt;
     char* errMsg = nullptr;
     int rc = sqlite3_exec(db_, "COMMIT", nullptr, nullptr, &errMsg);
     
     if (rc != SQLITE_OK) {
         std::string error = errMsg ? errMsg : "Unknown error";
         sqlite3_free(errMsg);
-        std::cerr << "Failed to commit transaction: " << error << std::endl;
+        LOG_ERROR("Failed to commit transaction", "error", error);
         return false;
     }
     
     inTransaction_ = false;
+    QueryDeadline::disarm();
     return true;
 }
 
@@ -131,17 +139,24 @@ bool Database::rollback() {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (!inTransaction_) {
-        std::cerr << "Not in transaction" << std::endl;
+        LOG_ERROR("Not in transaction");
         return false;
     }
     
+    // An interrupted write statement makes SQLite roll back on its own
+    if (sqlite3_get_autocommit(db_)) {
+        inTransaction_ = false;
+        return true;
+    }
+    
+    QueryDeadline::Suspend noInterrupt;
     char* errMsg = nullptr;
     int rc = sqlite3_exec(db_, "ROLLBACK", nullptr, nullptr, &errMsg);
     
     if (rc != SQLITE_OK) {
         std::string error = errMsg ? errMsg : "Unknown error";
         sqlite3_free(errMsg);
-        std::cerr << "Failed to rollback transaction: " << error << std::endl;
+        LOG_ERROR("Failed to rollback transaction", "error", error);
         return false;
     }
     
@@ -149,6 +164,18 @@ bool Database::rollback() {
     return true;
 }
 
+void Database::enableDeadlines(sqlite3* handle) {
+    sqlite3_progress_handler(handle, kProgressHandlerOps, &Database::progressHandler, nullptr);
+}
+
+std::unique_ptr<ReadSnapshot> Database::openReadSnapshot() const {
+    return std::make_unique<ReadSnapshot>(path_);
+}
+
+int Database::progressHandler(void*) {
+    return QueryDeadline::shouldInterrupt() ? 1 : 0;
+}
+
 std::string Database::getLastError() const {
     return sqlite3_errmsg(db_);
 }
@@ -157,6 +184,96 @@ int64_t Database::getLastInsertId() const {
     return sqlite3_last_insert_rowid(db_);
 }
 
+std::vector<std::string> Database::dropIndexes(const std::string& table) {
+    std::vector<std::string> indexes;
+    std::vector<std::string> names;
+    
+    auto stmt = prepare("SELECT name, sql FROM sqlite_master "
+                        "WHERE type = 'index' AND tbl_name = ? AND sql IS NOT NULL");
+    if (!stmt) {
+        return indexes;
+    }
+    
+    sqlite3_bind_text(stmt.get(), 1, table.c_str(), -1, SQLITE_TRANSIENT);
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        names.push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0)));
+        indexes.push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 1)));
+    }
+    stmt.reset();
+    
+    // Each index is recorded in deferred_indexes in the same savepoint that
+    // drops it, so one left dropped by a crash is rebuilt on the next open
+    if (indexes.empty() || !execute("SAVEPOINT drop_indexes")) {
+        return {};
+    }
+    
+    auto record = prepare("INSERT OR REPLACE INTO deferred_indexes (name, sql) VALUES (?, ?)");
+    bool ok = record != nullptr;
+    for (size_t i = 0; ok && i < names.size(); ++i) {
+        sqlite3_reset(record.get());
+        sqlite3_bind_text(record.get(), 1, names[i].c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(record.get(), 2, indexes[i].c_str(), -1, SQLITE_TRANSIENT);
+        ok = sqlite3_step(record.get()) == SQLITE_DONE &&
+             execute("DROP INDEX IF EXISTS \"" + names[i] + "\"");
+    }
+    record.reset();
+    
+    if (!ok) {
+        LOG_ERROR("Failed to drop indexes", "table", table, "error", getLastError());
+        execute("ROLLBACK TO drop_indexes");
+        execute("RELEASE drop_indexes");
+        return {};
+    }
+    if (!execute("RELEASE drop_indexes")) {
+        return {};
+    }
+    return indexes;
+}
+
+bool Database::restoreIndexes(const std::vector<std::string>& createStatements) {
+    if (createStatements.empty()) {
+        return true;
+    }
+    if (!execute("SAVEPOINT restore_indexes")) {
+        return false;
+    }
+    
+    // A statement no longer recorded was already rebuilt (by a recovery on
+    // another open of the database) and is skipped
+    auto forget = prepare("DELETE FROM deferred_indexes WHERE sql = ?");
+    bool ok = forget != nullptr;
+    for (size_t i = 0; ok && i < createStatements.size(); ++i) {
+        sqlite3_reset(forget.get());
+        sqlite3_bind_text(forget.get(), 1, createStatements[i].c_str(), -1, SQLITE_TRANSIENT);
+        ok = sqlite3_step(forget.get()) == SQLITE_DONE;
+        if (ok && sqlite3_changes(db_) > 0) {
+            ok = execute(createStatements[i]);
+        }
+    }
+    forget.reset();
+    
+    if (!ok) {
+        LOG_ERROR("Failed to restore indexes", "error", getLastError());
+        execute("ROLLBACK TO restore_indexes");
+        execute("RELEASE restore_indexes");
+        return false;
+    }
+    return execute("RELEASE restore_indexes");
+}
+
+bool Database::restoreDeferredIndexes() {
+    std::vector<std::string> leftovers;
+    query("SELECT sql FROM deferred_indexes", [&leftovers](sqlite3_stmt* stmt) {
+        leftovers.push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+    });
+    if (leftovers.empty()) {
+        return true;
+    }
+    
+    LOG_WARN("Rebuilding indexes left dropped by an interrupted bulk load", "count", leftovers.size());
+    return restoreIndexes(leftovers);
+}
+
 bool Database::initializeSchema() {
     // Check if tables exist
     bool tablesExist = false;
@@ -164,23 +281,36 @@ bool Database::initializeSchema() {
           [&tablesExist](sqlite3_stmt*) { tablesExist = true; });
     
     if (tablesExist) {
-        std::cout << "Database schema already initialized" << std::endl;
-        return true;
+        LOG_INFO("Database schema already initialized");
+    } else if (!createBaseSchema()) {
+        return false;
     }
     
-    std::cout << "Initializing database schema..." << std::endl;
+    return applySchemaUpgrades() && restoreDeferredIndexes();
+}
+
+bool Database::createBaseSchema() {
+    LOG_INFO("Initializing database schema");
     
     // Try to read migrations.sql file
     std::ifstream migrationFile("migrations.sql");
     if (!migrationFile.is_open()) {
         // If file not found, use embedded schema
         const char* schema = R"(
+            -- Current schema as of upgrade step 6 (see schema_upgrades.h): a new
+            -- database starts here and applies only the later steps. Enum columns hold
+            -- the integer codes of the domain enums:
+            --   user_type         0 standard, 1 admin
+            --   account_type      0 checking, 1 savings
+            --   transaction_type  0 deposit, 1 withdrawal, 2 transfer
+            --   status            0 pending, 1 completed, 2 failed
+
             -- Users table
             CREATE TABLE IF NOT EXISTS users (
                 id INTEGER PRIMARY KEY AUTOINCREMENT,
                 username TEXT UNIQUE NOT NULL,
                 pin_hash TEXT NOT NULL,
-                user_type TEXT NOT NULL CHECK(user_type IN ('standard', 'admin')),
+                user_type INTEGER NOT NULL CHECK(user_type IN (0, 1)),
                 created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
                 updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
             );
@@ -190,48 +320,253 @@ bool Database::initializeSchema() {
                 id INTEGER PRIMARY KEY AUTOINCREMENT,
                 user_id INTEGER NOT NULL,
                 account_number TEXT UNIQUE NOT NULL,
-                account_type TEXT NOT NULL CHECK(account_type IN ('checking', 'savings')),
+                account_type INTEGER NOT NULL CHECK(account_type IN (0, 1)),
                 balance REAL NOT NULL DEFAULT 0.0,
                 created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
                 updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
                 FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
             );
 
-            -- Transactions table
+            -- Transactions table, with the balance of each affected account right after
+            -- the row and the owning user of each side
             CREATE TABLE IF NOT EXISTS transactions (
                 id INTEGER PRIMARY KEY AUTOINCREMENT,
                 from_account_id INTEGER,
                 to_account_id INTEGER,
                 amount REAL NOT NULL,
-                transaction_type TEXT NOT NULL CHECK(transaction_type IN ('deposit', 'withdrawal', 'transfer')),
+                transaction_type INTEGER NOT NULL CHECK(transaction_type IN (0, 1, 2)),
                 description TEXT,
-                status TEXT NOT NULL DEFAULT 'completed' CHECK(status IN ('pending', 'completed', 'failed')),
+                status INTEGER NOT NULL DEFAULT 1 CHECK(status IN (0, 1, 2)),
                 created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                from_balance_after REAL,
+                to_balance_after REAL,
+                from_user_id INTEGER,
+                to_user_id INTEGER,
                 FOREIGN KEY (from_account_id) REFERENCES accounts(id),
                 FOREIGN KEY (to_account_id) REFERENCES accounts(id),
                 CHECK (
-                    (transaction_type = 'deposit' AND from_account_id IS NULL AND to_account_id IS NOT NULL) OR
-                    (transaction_type = 'withdrawal' AND from_account_id IS NOT NULL AND to_account_id IS NULL) OR
-                    (transaction_type = 'transfer' AND from_account_id IS NOT NULL AND to_account_id IS NOT NULL)
+                    (transaction_type = 0 AND from_account_id IS NULL AND to_account_id IS NOT NULL) OR
+                    (transaction_type = 1 AND from_account_id IS NOT NULL AND to_account_id IS NULL) OR
+                    (transaction_type = 2 AND from_account_id IS NOT NULL AND to_account_id IS NOT NULL)
                 )
             );
 
+            -- Monthly account statements
+            CREATE TABLE IF NOT EXISTS account_statements (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                account_id INTEGER NOT NULL,
+                period TEXT NOT NULL,
+                opening_balance_cents INTEGER NOT NULL,
+                closing_balance_cents INTEGER NOT NULL,
+                deposits_cents INTEGER NOT NULL,
+                withdrawals_cents INTEGER NOT NULL,
+                transfers_in_cents INTEGER NOT NULL,
+                transfers_out_cents INTEGER NOT NULL,
+                entry_count INTEGER NOT NULL,
+                body TEXT NOT NULL,
+                generated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                UNIQUE (account_id, period),
+                FOREIGN KEY (account_id) REFERENCES accounts(id) ON DELETE CASCADE
+            );
+
+            -- Daily account activity rollup, maintained by the triggers below
+            CREATE TABLE IF NOT EXISTS account_daily_activity (
+                account_id INTEGER NOT NULL,
+                day TEXT NOT NULL,
+                credit_cents INTEGER NOT NULL DEFAULT 0,
+                debit_cents INTEGER NOT NULL DEFAULT 0,
+                credit_count INTEGER NOT NULL DEFAULT 0,
+                debit_count INTEGER NOT NULL DEFAULT 0,
+                closing_balance_cents INTEGER,
+                last_transaction_at TEXT NOT NULL,
+                last_transaction_id INTEGER NOT NULL,
+                PRIMARY KEY (account_id, day)
+            ) WITHOUT ROWID;
+
+            -- Account number allocator; the key is drawn once per database
+            CREATE TABLE IF NOT EXISTS account_number_allocator (
+                id INTEGER PRIMARY KEY CHECK (id = 1),
+                next_sequence INTEGER NOT NULL DEFAULT 0,
+                secret_key INTEGER NOT NULL
+            );
+
+            INSERT OR IGNORE INTO account_number_allocator (id, next_sequence, secret_key)
+            VALUES (1, 0, random());
+
             -- Create indexes
             CREATE INDEX idx_accounts_user_id ON accounts(user_id);
-            CREATE INDEX idx_transactions_from_account ON transactions(from_account_id);
-            CREATE INDEX idx_transactions_to_account ON transactions(to_account_id);
             CREATE INDEX idx_transactions_created_at ON transactions(created_at);
+            CREATE INDEX idx_transactions_from_account_created ON transactions(from_account_id, created_at);
+            CREATE INDEX idx_transactions_to_account_created ON transactions(to_account_id, created_at);
+            CREATE INDEX idx_transactions_from_user_created ON transactions(from_user_id, created_at);
+            CREATE INDEX idx_transactions_to_user_created ON transactions(to_user_id, created_at);
+
+            -- Triggers to update timestamp
+            CREATE TRIGGER update_users_timestamp
+            AFTER UPDATE ON users
+            BEGIN
+                UPDATE users SET updated_at = CURRENT_TIMESTAMP WHERE id = NEW.id;
+            END;
+
+            CREATE TRIGGER update_accounts_timestamp
+            AFTER UPDATE ON accounts
+            BEGIN
+                UPDATE accounts SET updated_at = CURRENT_TIMESTAMP WHERE id = NEW.id;
+            END;
+
+            CREATE TRIGGER accounts_owner_changed
+            AFTER UPDATE OF user_id ON accounts
+            BEGIN
+                UPDATE transactions SET from_user_id = NEW.user_id WHERE from_account_id = NEW.id;
+                UPDATE transactions SET to_user_id = NEW.user_id WHERE to_account_id = NEW.id;
+            END;
+
+            -- Rollup maintenance, on every write whichever code path inserts the row
+            CREATE TRIGGER transactions_daily_debit
+            AFTER INSERT ON transactions
+            WHEN NEW.status = 1 AND NEW.from_account_id IS NOT NULL
+            BEGIN
+                INSERT INTO account_daily_activity (account_id, day, debit_cents, debit_count,
+                                                    closing_balance_cents, last_transaction_at, last_transaction_id)
+                VALUES (NEW.from_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+                        CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+                ON CONFLICT (account_id, day) DO UPDATE SET
+                    debit_cents = debit_cents + excluded.debit_cents,
+                    debit_count = debit_count + 1,
+                    closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                                 THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+                    last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                               THEN excluded.last_transaction_id ELSE last_transaction_id END,
+                    last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+            END;
+
+            CREATE TRIGGER transactions_daily_credit
+            AFTER INSERT ON transactions
+            WHEN NEW.status = 1 AND NEW.to_account_id IS NOT NULL
+            BEGIN
+                INSERT INTO account_daily_activity (account_id, day, credit_cents, credit_count,
+                                                    closing_balance_cents, last_transaction_at, last_transaction_id)
+                VALUES (NEW.to_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+                        CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+                ON CONFLICT (account_id, day) DO UPDATE SET
+                    credit_cents = credit_cents + excluded.credit_cents,
+                    credit_count = credit_count + 1,
+                    closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                                 THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+                    last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                               THEN excluded.last_transaction_id ELSE last_transaction_id END,
+                    last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+            END;
+
+            CREATE TRIGGER transactions_daily_debit_balance
+            AFTER UPDATE OF from_balance_after ON transactions
+            WHEN NEW.status = 1 AND NEW.from_account_id IS NOT NULL
+            BEGIN
+                UPDATE account_daily_activity
+                SET closing_balance_cents = CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER)
+                WHERE account_id = NEW.from_account_id AND day = date(NEW.created_at)
+                  AND last_transaction_id = NEW.id;
+            END;
+
+            CREATE TRIGGER transactions_daily_credit_balance
+            AFTER UPDATE OF to_balance_after ON transactions
+            WHEN NEW.status = 1 AND NEW.to_account_id IS NOT NULL
+            BEGIN
+                UPDATE account_daily_activity
+                SET closing_balance_cents = CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER)
+                WHERE account_id = NEW.to_account_id AND day = date(NEW.created_at)
+                  AND last_transaction_id = NEW.id;
+            END;
 
             -- Insert default admin user (PIN: 0000)
-            INSERT INTO users (username, pin_hash, user_type) 
-            VALUES ('admin', '9af15b336e6a9619928537df30b2e6a2376569fcf9d7e773eccede65606529a0', 'admin');
+            INSERT INTO users (username, pin_hash, user_type)
+            VALUES ('admin', '9af15b336e6a9619928537df30b2e6a2376569fcf9d7e773eccede65606529a0', 1)
+            ON CONFLICT(username) DO NOTHING;
+
+            -- Steps up to 6 are already in place
+            PRAGMA user_version = 6;
         )";
         
-        return execute(schema);
+        return executeBaseSchema(schema);
     }
     
     // Read and execute migrations from file
     std::stringstream buffer;
     buffer << migrationFile.rdbuf();
-    return execute(buffer.str());
+    return executeBaseSchema(buffer.str());
+}
+
+bool Database::executeBaseSchema(const std::string& schema) {
+    // All or nothing: a half-created schema would be taken as version 0 on
+    // the next start and upgraded from there
+    if (!beginTransaction()) {
+        return false;
+    }
+    if (!execute(schema)) {
+        rollback();
+        return false;
+    }
+    return commit();
+}
+
+int Database::getSchemaVersion() {
+    int version = 0;
+    query("PRAGMA user_version", [&version](sqlite3_stmt* stmt) {
+        version = sqlite3_column_int(stmt, 0);
+    });
+    return version;
+}
+
+bool Database::foreignKeysConsistent() {
+    bool consistent = true;
+    query("PRAGMA foreign_key_check", [&consistent](sqlite3_stmt* stmt) {
+        if (consistent) {
+            LOG_ERROR("Foreign key violation", "table", reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+        }
+        consistent = false;
+    });
+    return consistent;
+}
+
+bool Database::applySchemaUpgrades() {
+    int version = getSchemaVersion();
+    
+    for (const auto& upgrade : schemaUpgrades()) {
+        if (upgrade.version <= version) {
+            continue;
+        }
+        
+        LOG_INFO("Upgrading database schema", "version", upgrade.version, "description", upgrade.description);
+        
+        // foreign_keys cannot change inside a transaction, and dropping a
+        // referenced table with it on would cascade into the referencing rows
+        if (upgrade.rebuildsTables && !execute("PRAGMA foreign_keys = OFF")) {
+            return false;
+        }
+        
+        // Each step and its version bump commit together, so an interrupted
+        // upgrade is simply retried on the next start
+        bool applied = beginTransaction();
+        if (applied) {
+            applied = execute(upgrade.sql) &&
+                      (!upgrade.rebuildsTables || foreignKeysConsistent()) &&
+                      execute("PRAGMA user_version = " + std::to_string(upgrade.version));
+            if (!applied) {
+                rollback();
+                LOG_ERROR("Schema upgrade failed", "version", upgrade.version);
+            } else {
+                applied = commit();
+            }
+        }
+        
+        if (upgrade.rebuildsTables) {
+            execute("PRAGMA foreign_keys = ON");
+        }
+        if (!applied) {
+            return false;
+        }
+        version = upgrade.version;
+    }
+    
+    return true;
 }
@@ -7,6 +7,8 @@
 #include <vector>
 #include <functional>
 
+class ReadSnapshot;
+
 class Database {
 public:
     explicit Database(const std::string& dbPath);
@@ -41,14 +43,49 @@ public:
     // Get last insert row ID
     int64_t getLastInsertId() const;
     
+    // Bulk load support: drop a table's secondary indexes, returning their
+    // CREATE statements so they can be rebuilt once the load is finished.
+    // Dropped indexes are recorded in deferred_indexes until restored, and
+    // any still recorded when the database is opened are rebuilt then.
+    std::vector<std::string> dropIndexes(const std::string& table);
+    bool restoreIndexes(const std::vector<std::string>& createStatements);
+    
+    // Open a separate read-only connection pinned to the current committed
+    // state. Long scans run there so they neither see later writes nor
+    // block writers (WAL mode).
+    std::unique_ptr<ReadSnapshot> openReadSnapshot() const;
+    
     // Direct SQLite handle access (for use within transactions)
     sqlite3* getHandle() const { return db_; }
     
+    const std::string& getPath() const { return path_; }
+    
+    // Let per-request deadlines interrupt statements on this connection
+    static void enableDeadlines(sqlite3* handle);
+    
 private:
     sqlite3* db_;
+    std::string path_;
     mutable std::mutex mutex_;
     bool inTransaction_ = false;
     
-    // Initialize database schema
+    // VM instructions between deadline checks
+    static constexpr int kProgressHandlerOps = 1000;
+    static int progressHandler(void*);
+    
+    // Initialize database schema: the base schema (migrations.sql) on a new
+    // database, which sets PRAGMA user_version to the upgrade step it already
+    // includes, then any upgrades newer than that
     bool initializeSchema();
+    bool createBaseSchema();
+    bool executeBaseSchema(const std::string& schema);
+    bool applySchemaUpgrades();
+    int getSchemaVersion();
+    
+    // Rebuild indexes a bulk load dropped and never restored (it crashed or
+    // was killed)
+    bool restoreDeferredIndexes();
+    
+    // True when PRAGMA foreign_key_check finds no dangling references
+    bool foreignKeysConsistent();
 };
@@ -0,0 +1,146 @@
+#include "db/db_executor.h"
+#include "logging/logger.h"
+#include <algorithm>
+
+namespace {
+constexpr uint64_t kStrideScale = 1 << 20;
+constexpr size_t kBulk = static_cast<size_t>(DbPriority::Bulk);
+}
+
+DbExecutor::DbExecutor(const DbExecutorConfig& config) {
+    startLane(readLane_, std::max<size_t>(config.readerThreads, 1), config);
+    startLane(writeLane_, std::max<size_t>(config.writerThreads, 1), config);
+}
+
+DbExecutor::~DbExecutor() {
+    shutdown();
+}
+
+bool DbExecutor::submit(DbLane lane, DbPriority priority, std::function<void()> task) {
+    Lane& target = laneFor(lane);
+    size_t p = static_cast<size_t>(priority);
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        auto& queue = target.queues[p];
+        if (target.stopping || queue.size() >= target.maxQueueDepth) {
+            return false;
+        }
+
+        // A class that was idle starts at the current virtual time rather
+        // than cashing in credit it accumulated while it had nothing to run
+        if (queue.empty()) {
+            target.pass[p] = std::max(target.pass[p], target.virtualTime);
+        }
+        queue.push_back(std::move(task));
+    }
+    target.ready.notify_one();
+    return true;
+}
+
+void DbExecutor::shutdown() {
+    stopLane(readLane_);
+    stopLane(writeLane_);
+}
+
+size_t DbExecutor::queueDepth(DbLane lane) const {
+    const Lane& target = laneFor(lane);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    size_t depth = 0;
+    for (const auto& queue : target.queues) {
+        depth += queue.size();
+    }
+    return depth;
+}
+
+void DbExecutor::startLane(Lane& lane, size_t threads, const DbExecutorConfig& config) {
+    lane.maxQueueDepth = config.maxQueueDepth;
+    lane.maxBulkInFlight = std::max<size_t>(config.maxBulkInFlight, 1);
+    for (size_t p = 0; p < kDbPriorityCount; ++p) {
+        lane.stride[p] = kStrideScale / std::max(config.weights[p], 1u);
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        lane.threads.emplace_back([&lane]() { workerLoop(lane); });
+    }
+}
+
+void DbExecutor::stopLane(Lane& lane) {
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        lane.stopping = true;
+    }
+    lane.ready.notify_all();
+
+    for (auto& thread : lane.threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    lane.threads.clear();
+}
+
+int DbExecutor::pickNext(const Lane& lane) {
+    int best = -1;
+    for (size_t p = 0; p < kDbPriorityCount; ++p) {
+        if (lane.queues[p].empty()) {
+            continue;
+        }
+        if (p == kBulk && lane.bulkInFlight >= lane.maxBulkInFlight) {
+            continue;
+        }
+        if (best < 0 || lane.pass[p] < lane.pass[static_cast<size_t>(best)]) {
+            best = static_cast<int>(p);
+        }
+    }
+    return best;
+}
+
+bool DbExecutor::isEmpty(const Lane& lane) {
+    for (const auto& queue : lane.queues) {
+        if (!queue.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DbExecutor::workerLoop(Lane& lane) {
+    while (true) {
+        std::function<void()> task;
+        size_t picked;
+        {
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            int next = -1;
+            lane.ready.wait(lock, [&lane, &next] {
+                next = pickNext(lane);
+                return next >= 0 || (lane.stopping && isEmpty(lane));
+            });
+
+            // Drain remaining work before exiting so no response is left hanging
+            if (next < 0) {
+                return;
+            }
+            picked = static_cast<size_t>(next);
+            task = std::move(lane.queues[picked].front());
+            lane.queues[picked].pop_front();
+            lane.virtualTime = lane.pass[picked];
+            lane.pass[picked] += lane.stride[picked];
+            if (picked == kBulk) {
+                ++lane.bulkInFlight;
+            }
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Unhandled exception in DB executor task", "error", e.what());
+        }
+
+        if (picked == kBulk) {
+            {
+                std::lock_guard<std::mutex> lock(lane.mutex);
+                --lane.bulkInFlight;
+            }
+            lane.ready.notify_all();
+        }
+    }
+}
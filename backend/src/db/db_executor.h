@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Which pool a unit of database work runs on. Reads and writes get separate
+// threads so a burst of slow reads can never occupy the threads that money
+// movement needs, and vice versa.
+enum class DbLane {
+    Read,
+    Write
+};
+
+// Scheduling class within a lane. Critical work (customer money movement,
+// login) is picked first, interactive reads next, and bulk admin reports
+// only get a small weighted share plus a cap on concurrent executions.
+enum class DbPriority {
+    Critical,
+    Interactive,
+    Bulk
+};
+
+constexpr size_t kDbPriorityCount = 3;
+
+struct DbExecutorConfig {
+    size_t readerThreads = 4;
+    size_t writerThreads = 1;
+    size_t maxQueueDepth = 1024;                                 // per lane and priority
+    std::array<unsigned, kDbPriorityCount> weights = { 8, 4, 1 }; // Critical, Interactive, Bulk
+    size_t maxBulkInFlight = 1;                                  // per lane
+};
+
+// Bounded thread pools that run all blocking SQLite work off Crow's HTTP
+// threads. Handlers submit a task and complete their response from it; when
+// a queue is full, submit() refuses the task so the caller can shed load
+// instead of queueing without bound.
+class DbExecutor {
+public:
+    explicit DbExecutor(const DbExecutorConfig& config);
+    ~DbExecutor();
+
+    // Prevent copying
+    DbExecutor(const DbExecutor&) = delete;
+    DbExecutor& operator=(const DbExecutor&) = delete;
+
+    // Queue a task. Returns false if the queue is full or the executor is stopping.
+    bool submit(DbLane lane, DbPriority priority, std::function<void()> task);
+
+    // Stop accepting work, finish what is queued and join all threads
+    void shutdown();
+
+    size_t queueDepth(DbLane lane) const;
+
+private:
+    // Stride scheduling: each priority advances its pass by 1/weight per task
+    // and the non-empty queue with the lowest pass runs next, so under
+    // contention classes are served in proportion to their weights.
+    struct Lane {
+        std::array<std::deque<std::function<void()>>, kDbPriorityCount> queues;
+        std::array<uint64_t, kDbPriorityCount> pass{};
+        std::array<uint64_t, kDbPriorityCount> stride{};
+        uint64_t virtualTime = 0;
+        size_t bulkInFlight = 0;
+        size_t maxBulkInFlight = 1;
+        size_t maxQueueDepth = 0;
+        bool stopping = false;
+        mutable std::mutex mutex;
+        std::condition_variable ready;
+        std::vector<std::thread> threads;
+    };
+
+    Lane readLane_;
+    Lane writeLane_;
+
+    Lane& laneFor(DbLane lane) { return lane == DbLane::Read ? readLane_ : writeLane_; }
+    const Lane& laneFor(DbLane lane) const { return lane == DbLane::Read ? readLane_ : writeLane_; }
+
+    static void startLane(Lane& lane, size_t threads, const DbExecutorConfig& config);
+    static void stopLane(Lane& lane);
+    static void workerLoop(Lane& lane);
+    static int pickNext(const Lane& lane);
+    static bool isEmpty(const Lane& lane);
+};
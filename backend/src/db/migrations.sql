@@ -1,11 +1,19 @@
 -- NovaBank Database Schema
 
+-- Current schema as of upgrade step 6 (see schema_upgrades.h): a new
+-- database starts here and applies only the later steps. Enum columns hold
+-- the integer codes of the domain enums:
+--   user_type         0 standard, 1 admin
+--   account_type      0 checking, 1 savings
+--   transaction_type  0 deposit, 1 withdrawal, 2 transfer
+--   status            0 pending, 1 completed, 2 failed
+
 -- Users table
 CREATE TABLE IF NOT EXISTS users (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     username TEXT UNIQUE NOT NULL,
     pin_hash TEXT NOT NULL,
-    user_type TEXT NOT NULL CHECK(user_type IN ('standard', 'admin')),
+    user_type INTEGER NOT NULL CHECK(user_type IN (0, 1)),
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
     updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
@@ -15,37 +23,86 @@ CREATE TABLE IF NOT EXISTS accounts (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     user_id INTEGER NOT NULL,
     account_number TEXT UNIQUE NOT NULL,
-    account_type TEXT NOT NULL CHECK(account_type IN ('checking', 'savings')),
+    account_type INTEGER NOT NULL CHECK(account_type IN (0, 1)),
     balance REAL NOT NULL DEFAULT 0.0,
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
     updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
     FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
 );
 
--- Transactions table
+-- Transactions table, with the balance of each affected account right after
+-- the row and the owning user of each side
 CREATE TABLE IF NOT EXISTS transactions (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     from_account_id INTEGER,
     to_account_id INTEGER,
     amount REAL NOT NULL,
-    transaction_type TEXT NOT NULL CHECK(transaction_type IN ('deposit', 'withdrawal', 'transfer')),
+    transaction_type INTEGER NOT NULL CHECK(transaction_type IN (0, 1, 2)),
     description TEXT,
-    status TEXT NOT NULL DEFAULT 'completed' CHECK(status IN ('pending', 'completed', 'failed')),
+    status INTEGER NOT NULL DEFAULT 1 CHECK(status IN (0, 1, 2)),
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    from_balance_after REAL,
+    to_balance_after REAL,
+    from_user_id INTEGER,
+    to_user_id INTEGER,
     FOREIGN KEY (from_account_id) REFERENCES accounts(id),
     FOREIGN KEY (to_account_id) REFERENCES accounts(id),
     CHECK (
-        (transaction_type = 'deposit' AND from_account_id IS NULL AND to_account_id IS NOT NULL) OR
-        (transaction_type = 'withdrawal' AND from_account_id IS NOT NULL AND to_account_id IS NULL) OR
-        (transaction_type = 'transfer' AND from_account_id IS NOT NULL AND to_account_id IS NOT NULL)
+        (transaction_type = 0 AND from_account_id IS NULL AND to_account_id IS NOT NULL) OR
+        (transaction_type = 1 AND from_account_id IS NOT NULL AND to_account_id IS NULL) OR
+        (transaction_type = 2 AND from_account_id IS NOT NULL AND to_account_id IS NOT NULL)
     )
 );
 
+-- Monthly account statements
+CREATE TABLE IF NOT EXISTS account_statements (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    account_id INTEGER NOT NULL,
+    period TEXT NOT NULL,
+    opening_balance_cents INTEGER NOT NULL,
+    closing_balance_cents INTEGER NOT NULL,
+    deposits_cents INTEGER NOT NULL,
+    withdrawals_cents INTEGER NOT NULL,
+    transfers_in_cents INTEGER NOT NULL,
+    transfers_out_cents INTEGER NOT NULL,
+    entry_count INTEGER NOT NULL,
+    body TEXT NOT NULL,
+    generated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    UNIQUE (account_id, period),
+    FOREIGN KEY (account_id) REFERENCES accounts(id) ON DELETE CASCADE
+);
+
+-- Daily account activity rollup, maintained by the triggers below
+CREATE TABLE IF NOT EXISTS account_daily_activity (
+    account_id INTEGER NOT NULL,
+    day TEXT NOT NULL,
+    credit_cents INTEGER NOT NULL DEFAULT 0,
+    debit_cents INTEGER NOT NULL DEFAULT 0,
+    credit_count INTEGER NOT NULL DEFAULT 0,
+    debit_count INTEGER NOT NULL DEFAULT 0,
+    closing_balance_cents INTEGER,
+    last_transaction_at TEXT NOT NULL,
+    last_transaction_id INTEGER NOT NULL,
+    PRIMARY KEY (account_id, day)
+) WITHOUT ROWID;
+
+-- Account number allocator; the key is drawn once per database
+CREATE TABLE IF NOT EXISTS account_number_allocator (
+    id INTEGER PRIMARY KEY CHECK (id = 1),
+    next_sequence INTEGER NOT NULL DEFAULT 0,
+    secret_key INTEGER NOT NULL
+);
+
+INSERT OR IGNORE INTO account_number_allocator (id, next_sequence, secret_key)
+VALUES (1, 0, random());
+
 -- Create indexes for better performance
 CREATE INDEX idx_accounts_user_id ON accounts(user_id);
-CREATE INDEX idx_transactions_from_account ON transactions(from_account_id);
-CREATE INDEX idx_transactions_to_account ON transactions(to_account_id);
 CREATE INDEX idx_transactions_created_at ON transactions(created_at);
+CREATE INDEX idx_transactions_from_account_created ON transactions(from_account_id, created_at);
+CREATE INDEX idx_transactions_to_account_created ON transactions(to_account_id, created_at);
+CREATE INDEX idx_transactions_from_user_created ON transactions(from_user_id, created_at);
+CREATE INDEX idx_transactions_to_user_created ON transactions(to_user_id, created_at);
 
 -- Triggers to update timestamp
 CREATE TRIGGER update_users_timestamp 
@@ -60,9 +117,76 @@ BEGIN
     UPDATE accounts SET updated_at = CURRENT_TIMESTAMP WHERE id = NEW.id;
 END;
 
+CREATE TRIGGER accounts_owner_changed
+AFTER UPDATE OF user_id ON accounts
+BEGIN
+    UPDATE transactions SET from_user_id = NEW.user_id WHERE from_account_id = NEW.id;
+    UPDATE transactions SET to_user_id = NEW.user_id WHERE to_account_id = NEW.id;
+END;
+
+-- Rollup maintenance, on every write whichever code path inserts the row
+CREATE TRIGGER transactions_daily_debit
+AFTER INSERT ON transactions
+WHEN NEW.status = 1 AND NEW.from_account_id IS NOT NULL
+BEGIN
+    INSERT INTO account_daily_activity (account_id, day, debit_cents, debit_count,
+                                        closing_balance_cents, last_transaction_at, last_transaction_id)
+    VALUES (NEW.from_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+            CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+    ON CONFLICT (account_id, day) DO UPDATE SET
+        debit_cents = debit_cents + excluded.debit_cents,
+        debit_count = debit_count + 1,
+        closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                     THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+        last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                   THEN excluded.last_transaction_id ELSE last_transaction_id END,
+        last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+END;
+
+CREATE TRIGGER transactions_daily_credit
+AFTER INSERT ON transactions
+WHEN NEW.status = 1 AND NEW.to_account_id IS NOT NULL
+BEGIN
+    INSERT INTO account_daily_activity (account_id, day, credit_cents, credit_count,
+                                        closing_balance_cents, last_transaction_at, last_transaction_id)
+    VALUES (NEW.to_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+            CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+    ON CONFLICT (account_id, day) DO UPDATE SET
+        credit_cents = credit_cents + excluded.credit_cents,
+        credit_count = credit_count + 1,
+        closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                     THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+        last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                   THEN excluded.last_transaction_id ELSE last_transaction_id END,
+        last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+END;
+
+CREATE TRIGGER transactions_daily_debit_balance
+AFTER UPDATE OF from_balance_after ON transactions
+WHEN NEW.status = 1 AND NEW.from_account_id IS NOT NULL
+BEGIN
+    UPDATE account_daily_activity
+    SET closing_balance_cents = CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER)
+    WHERE account_id = NEW.from_account_id AND day = date(NEW.created_at)
+      AND last_transaction_id = NEW.id;
+END;
+
+CREATE TRIGGER transactions_daily_credit_balance
+AFTER UPDATE OF to_balance_after ON transactions
+WHEN NEW.status = 1 AND NEW.to_account_id IS NOT NULL
+BEGIN
+    UPDATE account_daily_activity
+    SET closing_balance_cents = CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER)
+    WHERE account_id = NEW.to_account_id AND day = date(NEW.created_at)
+      AND last_transaction_id = NEW.id;
+END;
+
 -- Insert default admin user
 -- PIN: 0000 (this should be changed on first login in production)
 -- Hash of '0000' using SHA256: 9af15b336e6a9619928537df30b2e6a2376569fcf9d7e773eccede65606529a0
 INSERT INTO users (username, pin_hash, user_type) 
-VALUES ('admin', '9af15b336e6a9619928537df30b2e6a2376569fcf9d7e773eccede65606529a0', 'admin')
+VALUES ('admin', '9af15b336e6a9619928537df30b2e6a2376569fcf9d7e773eccede65606529a0', 1)
 ON CONFLICT(username) DO NOTHING;
+
+-- Steps up to 6 are already in place
+PRAGMA user_version = 6;
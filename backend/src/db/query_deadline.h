@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include "utils/metrics.h"
+
+// Per-thread deadline for SQLite work. While an instance is alive, statements
+// run by the current thread are interrupted by the connection's progress
+// handler once the deadline passes, which releases the connection instead of
+// letting an abandoned query run to completion.
+class QueryDeadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit QueryDeadline(Clock::time_point deadline) {
+        State& s = state();
+        s.deadline = deadline;
+        s.armed = true;
+        s.aborted = false;
+    }
+
+    ~QueryDeadline() {
+        state() = State{};
+    }
+
+    // Prevent copying
+    QueryDeadline(const QueryDeadline&) = delete;
+    QueryDeadline& operator=(const QueryDeadline&) = delete;
+
+    // Whether a statement on this thread was interrupted by the deadline
+    static bool aborted() { return state().aborted; }
+
+    // Called once the request's write has committed. Whatever runs after it
+    // (re-reads for the response) completes, and the request is no longer
+    // reported as having missed its deadline: the change is already saved.
+    static void disarm() {
+        State& s = state();
+        s.armed = false;
+        s.aborted = false;
+    }
+
+    // Called from the SQLite progress handler; true interrupts the statement
+    static bool shouldInterrupt() {
+        State& s = state();
+        if (!s.armed || s.suspended > 0) {
+            return false;
+        }
+        if (s.aborted) {
+            return true;
+        }
+        if (Clock::now() >= s.deadline) {
+            s.aborted = true;
+            Metrics::getInstance().increment(Counter::QueriesAborted);
+            return true;
+        }
+        return false;
+    }
+
+    // COMMIT and ROLLBACK must run to completion once started
+    class Suspend {
+    public:
+        Suspend() { ++state().suspended; }
+        ~Suspend() { --state().suspended; }
+        Suspend(const Suspend&) = delete;
+        Suspend& operator=(const Suspend&) = delete;
+    };
+
+private:
+    struct State {
+        Clock::time_point deadline{};
+        bool armed = false;
+        bool aborted = false;
+        int suspended = 0;
+    };
+
+    static State& state() {
+        thread_local State s;
+        return s;
+    }
+};
@@ -0,0 +1,50 @@
+#include "db/read_snapshot.h"
+#include "db/db.h"
+#include "logging/logger.h"
+#include <stdexcept>
+
+ReadSnapshot::ReadSnapshot(const std::string& dbPath) : db_(nullptr) {
+    int rc = sqlite3_open_v2(dbPath.c_str(), &db_, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr);
+    if (rc != SQLITE_OK) {
+        LOG_ERROR("Failed to open read snapshot", "error", sqlite3_errmsg(db_));
+        sqlite3_close(db_);
+        db_ = nullptr;
+        throw std::runtime_error("Failed to open read snapshot");
+    }
+    
+    Database::enableDeadlines(db_);
+    
+    // BEGIN alone is lazy; the first SELECT fixes the snapshot
+    char* errMsg = nullptr;
+    rc = sqlite3_exec(db_, "BEGIN; SELECT 1 FROM sqlite_master LIMIT 1;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK) {
+        std::string error = errMsg ? errMsg : "Unknown error";
+        sqlite3_free(errMsg);
+        sqlite3_close(db_);
+        db_ = nullptr;
+        throw std::runtime_error("Failed to begin read snapshot: " + error);
+    }
+}
+
+ReadSnapshot::~ReadSnapshot() {
+    if (db_) {
+        sqlite3_exec(db_, "COMMIT", nullptr, nullptr, nullptr);
+        sqlite3_close(db_);
+    }
+}
+
+std::shared_ptr<sqlite3_stmt> ReadSnapshot::prepare(const std::string& sql) {
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+    
+    if (rc != SQLITE_OK) {
+        LOG_ERROR("Failed to prepare statement", "error", sqlite3_errmsg(db_));
+        return nullptr;
+    }
+    
+    return std::shared_ptr<sqlite3_stmt>(stmt, sqlite3_finalize);
+}
+
+std::string ReadSnapshot::getLastError() const {
+    return sqlite3_errmsg(db_);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <memory>
+#include <string>
+
+// A read-only connection holding an open read transaction. In WAL mode the
+// first read pins the snapshot: every statement sees the same committed
+// state for the lifetime of the object, and writers on other connections
+// are never blocked by it.
+class ReadSnapshot {
+public:
+    explicit ReadSnapshot(const std::string& dbPath);
+    ~ReadSnapshot();
+    
+    // Prevent copying
+    ReadSnapshot(const ReadSnapshot&) = delete;
+    ReadSnapshot& operator=(const ReadSnapshot&) = delete;
+    
+    std::shared_ptr<sqlite3_stmt> prepare(const std::string& sql);
+    
+    std::string getLastError() const;
+    
+private:
+    sqlite3* db_;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Typed, non-owning access to the current row of a stepped statement.
+// Text columns come back as string_views into SQLite's buffer, valid until
+// the statement is stepped, reset or finalized; copy what must outlive that.
+class RowView {
+public:
+    explicit RowView(sqlite3_stmt* stmt) : stmt_(stmt) {}
+
+    int columnCount() const { return sqlite3_column_count(stmt_); }
+    bool isNull(int column) const { return sqlite3_column_type(stmt_, column) == SQLITE_NULL; }
+
+    int getInt(int column) const { return sqlite3_column_int(stmt_, column); }
+    int64_t getInt64(int column) const { return sqlite3_column_int64(stmt_, column); }
+    double getDouble(int column) const { return sqlite3_column_double(stmt_, column); }
+
+    // Empty for NULL
+    std::string_view getText(int column) const {
+        const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt_, column));
+        if (!text) {
+            return {};
+        }
+        return std::string_view(text, static_cast<size_t>(sqlite3_column_bytes(stmt_, column)));
+    }
+
+    std::string getString(int column) const { return std::string(getText(column)); }
+
+    std::optional<int> getOptionalInt(int column) const {
+        return isNull(column) ? std::nullopt : std::optional<int>(getInt(column));
+    }
+
+    std::optional<double> getOptionalDouble(int column) const {
+        return isNull(column) ? std::nullopt : std::optional<double>(getDouble(column));
+    }
+
+    sqlite3_stmt* statement() const { return stmt_; }
+
+private:
+    sqlite3_stmt* stmt_;
+};
+
+// Step a prepared statement to the end, handing each row to visit. Returns
+// false if stepping stopped on an error rather than SQLITE_DONE.
+template <typename Visit>
+bool forEachRow(sqlite3_stmt* stmt, Visit&& visit) {
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        visit(RowView(stmt));
+    }
+    return rc == SQLITE_DONE;
+}
@@ -0,0 +1,477 @@
+#pragma once
+
+#include <vector>
+
+// Schema changes, applied once each and in order; PRAGMA user_version records
+// the last step applied. The base schema in migrations.sql (and its embedded
+// copy in db.cpp) already includes the steps up to the user_version it sets,
+// so a new database only runs the later ones. Never edit a released step,
+// append a new one; fold it into the base schema only together with its
+// user_version.
+struct SchemaUpgrade {
+    int version;
+    const char* description;
+    const char* sql;
+    // Rebuilds tables other tables reference (SQLite's create-copy-drop-rename
+    // procedure), so it runs with foreign key enforcement off and a
+    // foreign_key_check before commit
+    bool rebuildsTables = false;
+};
+
+inline const std::vector<SchemaUpgrade>& schemaUpgrades() {
+    static const std::vector<SchemaUpgrade> upgrades = {
+        { 1, "account statements", R"(
+            -- One row per account and closed month. Summary columns are in
+            -- cents; body is the rendered statement, served as stored.
+            CREATE TABLE IF NOT EXISTS account_statements (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                account_id INTEGER NOT NULL,
+                period TEXT NOT NULL,
+                opening_balance_cents INTEGER NOT NULL,
+                closing_balance_cents INTEGER NOT NULL,
+                deposits_cents INTEGER NOT NULL,
+                withdrawals_cents INTEGER NOT NULL,
+                transfers_in_cents INTEGER NOT NULL,
+                transfers_out_cents INTEGER NOT NULL,
+                entry_count INTEGER NOT NULL,
+                body TEXT NOT NULL,
+                generated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                UNIQUE (account_id, period),
+                FOREIGN KEY (account_id) REFERENCES accounts(id) ON DELETE CASCADE
+            );
+        )" },
+        { 2, "balance after each transaction", R"(
+            -- Balance of each affected account right after the row, so
+            -- point-in-time balances are one index seek
+            ALTER TABLE transactions ADD COLUMN from_balance_after REAL;
+            ALTER TABLE transactions ADD COLUMN to_balance_after REAL;
+
+            -- Backfill existing history: walking back from the current
+            -- balance, a row's balance-after is the balance minus every
+            -- completed movement that came after it
+            CREATE TEMP TABLE balance_backfill (
+                id INTEGER NOT NULL,
+                debit INTEGER NOT NULL,
+                balance_cents INTEGER NOT NULL,
+                PRIMARY KEY (id, debit)
+            ) WITHOUT ROWID;
+
+            INSERT INTO balance_backfill (id, debit, balance_cents)
+            SELECT m.id, m.debit,
+                   CAST(ROUND(a.balance * 100) AS INTEGER) - COALESCE(SUM(m.delta) OVER (
+                       PARTITION BY m.account_id ORDER BY m.created_at DESC, m.id DESC
+                       ROWS BETWEEN UNBOUNDED PRECEDING AND 1 PRECEDING), 0)
+            FROM (
+                SELECT id, created_at, from_account_id AS account_id, 1 AS debit,
+                       -CAST(ROUND(amount * 100) AS INTEGER) AS delta
+                FROM transactions WHERE status = 'completed' AND from_account_id IS NOT NULL
+                UNION ALL
+                SELECT id, created_at, to_account_id, 0,
+                       CAST(ROUND(amount * 100) AS INTEGER)
+                FROM transactions WHERE status = 'completed' AND to_account_id IS NOT NULL
+            ) m
+            JOIN accounts a ON a.id = m.account_id;
+
+            UPDATE transactions SET
+                from_balance_after = (SELECT balance_cents / 100.0 FROM balance_backfill b
+                                      WHERE b.id = transactions.id AND b.debit = 1),
+                to_balance_after = (SELECT balance_cents / 100.0 FROM balance_backfill b
+                                    WHERE b.id = transactions.id AND b.debit = 0)
+            WHERE status = 'completed';
+
+            DROP TABLE balance_backfill;
+
+            -- (account, created_at) serves both per-account history and
+            -- point-in-time seeks; it replaces the single-column indexes
+            CREATE INDEX IF NOT EXISTS idx_transactions_from_account_created ON transactions(from_account_id, created_at);
+            CREATE INDEX IF NOT EXISTS idx_transactions_to_account_created ON transactions(to_account_id, created_at);
+            DROP INDEX IF EXISTS idx_transactions_from_account;
+            DROP INDEX IF EXISTS idx_transactions_to_account;
+        )" },
+        { 3, "daily account activity rollup", R"(
+            -- One row per account and day with at least one completed
+            -- movement. Amounts are in cents; closing_balance_cents is the
+            -- balance after the day's last movement (by created_at, id).
+            CREATE TABLE IF NOT EXISTS account_daily_activity (
+                account_id INTEGER NOT NULL,
+                day TEXT NOT NULL,
+                credit_cents INTEGER NOT NULL DEFAULT 0,
+                debit_cents INTEGER NOT NULL DEFAULT 0,
+                credit_count INTEGER NOT NULL DEFAULT 0,
+                debit_count INTEGER NOT NULL DEFAULT 0,
+                closing_balance_cents INTEGER,
+                last_transaction_at TEXT NOT NULL,
+                last_transaction_id INTEGER NOT NULL,
+                PRIMARY KEY (account_id, day)
+            ) WITHOUT ROWID;
+
+            -- Backfill from existing history. With a single max() in the
+            -- aggregate, the bare balance/created_at/id come from the day's
+            -- last row.
+            INSERT INTO account_daily_activity (account_id, day, credit_cents, debit_cents, credit_count,
+                                                debit_count, closing_balance_cents, last_transaction_at,
+                                                last_transaction_id)
+            SELECT account_id, day, credit_cents, debit_cents, credit_count, debit_count,
+                   CAST(ROUND(balance * 100) AS INTEGER), created_at, id
+            FROM (
+                SELECT account_id, day, SUM(credit) AS credit_cents, SUM(debit) AS debit_cents,
+                       SUM(credit > 0) AS credit_count, SUM(debit > 0) AS debit_count,
+                       balance, created_at, id, MAX(created_at || '#' || printf('%020d', id)) AS latest
+                FROM (
+                    SELECT from_account_id AS account_id, date(created_at) AS day, 0 AS credit,
+                           CAST(ROUND(amount * 100) AS INTEGER) AS debit, from_balance_after AS balance,
+                           created_at, id
+                    FROM transactions WHERE status = 'completed' AND from_account_id IS NOT NULL
+                    UNION ALL
+                    SELECT to_account_id, date(created_at), CAST(ROUND(amount * 100) AS INTEGER), 0,
+                           to_balance_after, created_at, id
+                    FROM transactions WHERE status = 'completed' AND to_account_id IS NOT NULL
+                )
+                GROUP BY account_id, day
+            );
+
+            -- Maintained on every write, whichever code path inserts the row
+            CREATE TRIGGER transactions_daily_debit
+            AFTER INSERT ON transactions
+            WHEN NEW.status = 'completed' AND NEW.from_account_id IS NOT NULL
+            BEGIN
+                INSERT INTO account_daily_activity (account_id, day, debit_cents, debit_count,
+                                                    closing_balance_cents, last_transaction_at, last_transaction_id)
+                VALUES (NEW.from_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+                        CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+                ON CONFLICT (account_id, day) DO UPDATE SET
+                    debit_cents = debit_cents + excluded.debit_cents,
+                    debit_count = debit_count + 1,
+                    closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                                 THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+                    last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                               THEN excluded.last_transaction_id ELSE last_transaction_id END,
+                    last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+            END;
+
+            CREATE TRIGGER transactions_daily_credit
+            AFTER INSERT ON transactions
+            WHEN NEW.status = 'completed' AND NEW.to_account_id IS NOT NULL
+            BEGIN
+                INSERT INTO account_daily_activity (account_id, day, credit_cents, credit_count,
+                                                    closing_balance_cents, last_transaction_at, last_transaction_id)
+                VALUES (NEW.to_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+                        CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+                ON CONFLICT (account_id, day) DO UPDATE SET
+                    credit_cents = credit_cents + excluded.credit_cents,
+                    credit_count = credit_count + 1,
+                    closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                                 THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+                    last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                               THEN excluded.last_transaction_id ELSE last_transaction_id END,
+                    last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+            END;
+
+            -- Imported history gets its balances recomputed after insert;
+            -- keep the closing balance of the day's last row in step
+            CREATE TRIGGER transactions_daily_debit_balance
+            AFTER UPDATE OF from_balance_after ON transactions
+            WHEN NEW.status = 'completed' AND NEW.from_account_id IS NOT NULL
+            BEGIN
+                UPDATE account_daily_activity
+                SET closing_balance_cents = CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER)
+                WHERE account_id = NEW.from_account_id AND day = date(NEW.created_at)
+                  AND last_transaction_id = NEW.id;
+            END;
+
+            CREATE TRIGGER transactions_daily_credit_balance
+            AFTER UPDATE OF to_balance_after ON transactions
+            WHEN NEW.status = 'completed' AND NEW.to_account_id IS NOT NULL
+            BEGIN
+                UPDATE account_daily_activity
+                SET closing_balance_cents = CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER)
+                WHERE account_id = NEW.to_account_id AND day = date(NEW.created_at)
+                  AND last_transaction_id = NEW.id;
+            END;
+        )" },
+        { 4, "transaction owner columns", R"(
+            -- Owning user of each side, so a user's history is a range scan
+            -- on (user, created_at) instead of a join through accounts.
+            -- Inserts fill them from accounts in the same statement.
+            ALTER TABLE transactions ADD COLUMN from_user_id INTEGER;
+            ALTER TABLE transactions ADD COLUMN to_user_id INTEGER;
+
+            UPDATE transactions SET
+                from_user_id = (SELECT user_id FROM accounts WHERE id = transactions.from_account_id),
+                to_user_id = (SELECT user_id FROM accounts WHERE id = transactions.to_account_id);
+
+            CREATE INDEX IF NOT EXISTS idx_transactions_from_user_created ON transactions(from_user_id, created_at);
+            CREATE INDEX IF NOT EXISTS idx_transactions_to_user_created ON transactions(to_user_id, created_at);
+
+            -- Accounts do not change owner today; keep history right if they do
+            CREATE TRIGGER accounts_owner_changed
+            AFTER UPDATE OF user_id ON accounts
+            BEGIN
+                UPDATE transactions SET from_user_id = NEW.user_id WHERE from_account_id = NEW.id;
+                UPDATE transactions SET to_user_id = NEW.user_id WHERE to_account_id = NEW.id;
+            END;
+        )" },
+        { 5, "account number allocator", R"(
+            -- Account numbers are a sequence position passed through a keyed
+            -- permutation (see AccountNumber). The key is drawn once per
+            -- database and must never change.
+            CREATE TABLE IF NOT EXISTS account_number_allocator (
+                id INTEGER PRIMARY KEY CHECK (id = 1),
+                next_sequence INTEGER NOT NULL DEFAULT 0,
+                secret_key INTEGER NOT NULL
+            );
+
+            INSERT OR IGNORE INTO account_number_allocator (id, next_sequence, secret_key)
+            VALUES (1, 0, random());
+        )" },
+        { 6, "integer-coded enums", R"(
+            -- transaction_type, status, account_type and user_type become
+            -- small integer codes (the enum values in the domain headers):
+            --   user_type         0 standard, 1 admin
+            --   account_type      0 checking, 1 savings
+            --   transaction_type  0 deposit, 1 withdrawal, 2 transfer
+            --   status            0 pending, 1 completed, 2 failed
+            -- SQLite cannot change a column's type or CHECK in place, so each
+            -- table is copied into a new one and swapped in. Ids and the
+            -- AUTOINCREMENT high-water marks carry over.
+
+            -- Triggers would be left pointing at dropped tables mid-swap;
+            -- they are recreated below against the new codes
+            DROP TRIGGER IF EXISTS update_users_timestamp;
+            DROP TRIGGER IF EXISTS update_accounts_timestamp;
+            DROP TRIGGER IF EXISTS accounts_owner_changed;
+            DROP TRIGGER IF EXISTS transactions_daily_debit;
+            DROP TRIGGER IF EXISTS transactions_daily_credit;
+            DROP TRIGGER IF EXISTS transactions_daily_debit_balance;
+            DROP TRIGGER IF EXISTS transactions_daily_credit_balance;
+
+            CREATE TABLE users_new (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                username TEXT UNIQUE NOT NULL,
+                pin_hash TEXT NOT NULL,
+                user_type INTEGER NOT NULL CHECK(user_type IN (0, 1)),
+                created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+            );
+
+            INSERT INTO users_new (id, username, pin_hash, user_type, created_at, updated_at)
+            SELECT id, username, pin_hash, CASE user_type WHEN 'admin' THEN 1 ELSE 0 END,
+                   created_at, updated_at
+            FROM users;
+
+            CREATE TABLE accounts_new (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                user_id INTEGER NOT NULL,
+                account_number TEXT UNIQUE NOT NULL,
+                account_type INTEGER NOT NULL CHECK(account_type IN (0, 1)),
+                balance REAL NOT NULL DEFAULT 0.0,
+                created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
+            );
+
+            INSERT INTO accounts_new (id, user_id, account_number, account_type, balance, created_at, updated_at)
+            SELECT id, user_id, account_number, CASE account_type WHEN 'savings' THEN 1 ELSE 0 END,
+                   balance, created_at, updated_at
+            FROM accounts;
+
+            CREATE TABLE transactions_new (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                from_account_id INTEGER,
+                to_account_id INTEGER,
+                amount REAL NOT NULL,
+                transaction_type INTEGER NOT NULL CHECK(transaction_type IN (0, 1, 2)),
+                description TEXT,
+                status INTEGER NOT NULL DEFAULT 1 CHECK(status IN (0, 1, 2)),
+                created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                from_balance_after REAL,
+                to_balance_after REAL,
+                from_user_id INTEGER,
+                to_user_id INTEGER,
+                FOREIGN KEY (from_account_id) REFERENCES accounts(id),
+                FOREIGN KEY (to_account_id) REFERENCES accounts(id),
+                CHECK (
+                    (transaction_type = 0 AND from_account_id IS NULL AND to_account_id IS NOT NULL) OR
+                    (transaction_type = 1 AND from_account_id IS NOT NULL AND to_account_id IS NULL) OR
+                    (transaction_type = 2 AND from_account_id IS NOT NULL AND to_account_id IS NOT NULL)
+                )
+            );
+
+            INSERT INTO transactions_new (id, from_account_id, to_account_id, amount, transaction_type,
+                                          description, status, created_at, from_balance_after,
+                                          to_balance_after, from_user_id, to_user_id)
+            SELECT id, from_account_id, to_account_id, amount,
+                   CASE transaction_type WHEN 'deposit' THEN 0 WHEN 'withdrawal' THEN 1 ELSE 2 END,
+                   description,
+                   CASE status WHEN 'pending' THEN 0 WHEN 'failed' THEN 2 ELSE 1 END,
+                   created_at, from_balance_after, to_balance_after, from_user_id, to_user_id
+            FROM transactions;
+
+            -- Deleted rows may have left the high-water mark above max(id)
+            DELETE FROM sqlite_sequence WHERE name IN ('users_new', 'accounts_new', 'transactions_new');
+            INSERT INTO sqlite_sequence (name, seq)
+            SELECT name || '_new', seq FROM sqlite_sequence WHERE name IN ('users', 'accounts', 'transactions');
+
+            DROP TABLE transactions;
+            DROP TABLE accounts;
+            DROP TABLE users;
+            ALTER TABLE users_new RENAME TO users;
+            ALTER TABLE accounts_new RENAME TO accounts;
+            ALTER TABLE transactions_new RENAME TO transactions;
+
+            CREATE INDEX idx_accounts_user_id ON accounts(user_id);
+            CREATE INDEX idx_transactions_created_at ON transactions(created_at);
+            CREATE INDEX idx_transactions_from_account_created ON transactions(from_account_id, created_at);
+            CREATE INDEX idx_transactions_to_account_created ON transactions(to_account_id, created_at);
+            CREATE INDEX idx_transactions_from_user_created ON transactions(from_user_id, created_at);
+            CREATE INDEX idx_transactions_to_user_created ON transactions(to_user_id, created_at);
+
+            CREATE TRIGGER update_users_timestamp
+            AFTER UPDATE ON users
+            BEGIN
+                UPDATE users SET updated_at = CURRENT_TIMESTAMP WHERE id = NEW.id;
+            END;
+
+            CREATE TRIGGER update_accounts_timestamp
+            AFTER UPDATE ON accounts
+            BEGIN
+                UPDATE accounts SET updated_at = CURRENT_TIMESTAMP WHERE id = NEW.id;
+            END;
+
+            CREATE TRIGGER accounts_owner_changed
+            AFTER UPDATE OF user_id ON accounts
+            BEGIN
+                UPDATE transactions SET from_user_id = NEW.user_id WHERE from_account_id = NEW.id;
+                UPDATE transactions SET to_user_id = NEW.user_id WHERE to_account_id = NEW.id;
+            END;
+
+            CREATE TRIGGER transactions_daily_debit
+            AFTER INSERT ON transactions
+            WHEN NEW.status = 1 AND NEW.from_account_id IS NOT NULL
+            BEGIN
+                INSERT INTO account_daily_activity (account_id, day, debit_cents, debit_count,
+                                                    closing_balance_cents, last_transaction_at, last_transaction_id)
+                VALUES (NEW.from_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+                        CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+                ON CONFLICT (account_id, day) DO UPDATE SET
+                    debit_cents = debit_cents + excluded.debit_cents,
+                    debit_count = debit_count + 1,
+                    closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                                 THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+                    last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                               THEN excluded.last_transaction_id ELSE last_transaction_id END,
+                    last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+            END;
+
+            CREATE TRIGGER transactions_daily_credit
+            AFTER INSERT ON transactions
+            WHEN NEW.status = 1 AND NEW.to_account_id IS NOT NULL
+            BEGIN
+                INSERT INTO account_daily_activity (account_id, day, credit_cents, credit_count,
+                                                    closing_balance_cents, last_transaction_at, last_transaction_id)
+                VALUES (NEW.to_account_id, date(NEW.created_at), CAST(ROUND(NEW.amount * 100) AS INTEGER), 1,
+                        CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER), NEW.created_at, NEW.id)
+                ON CONFLICT (account_id, day) DO UPDATE SET
+                    credit_cents = credit_cents + excluded.credit_cents,
+                    credit_count = credit_count + 1,
+                    closing_balance_cents = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                                 THEN excluded.closing_balance_cents ELSE closing_balance_cents END,
+                    last_transaction_id = CASE WHEN (excluded.last_transaction_at, excluded.last_transaction_id) > (last_transaction_at, last_transaction_id)
+                                               THEN excluded.last_transaction_id ELSE last_transaction_id END,
+                    last_transaction_at = MAX(last_transaction_at, excluded.last_transaction_at);
+            END;
+
+            CREATE TRIGGER transactions_daily_debit_balance
+            AFTER UPDATE OF from_balance_after ON transactions
+            WHEN NEW.status = 1 AND NEW.from_account_id IS NOT NULL
+            BEGIN
+                UPDATE account_daily_activity
+                SET closing_balance_cents = CAST(ROUND(NEW.from_balance_after * 100) AS INTEGER)
+                WHERE account_id = NEW.from_account_id AND day = date(NEW.created_at)
+                  AND last_transaction_id = NEW.id;
+            END;
+
+            CREATE TRIGGER transactions_daily_credit_balance
+            AFTER UPDATE OF to_balance_after ON transactions
+            WHEN NEW.status = 1 AND NEW.to_account_id IS NOT NULL
+            BEGIN
+                UPDATE account_daily_activity
+                SET closing_balance_cents = CAST(ROUND(NEW.to_balance_after * 100) AS INTEGER)
+                WHERE account_id = NEW.to_account_id AND day = date(NEW.created_at)
+                  AND last_transaction_id = NEW.id;
+            END;
+        )", true },
+        { 7, "change sequence", R"(
+            -- Every insert or client-visible update of an account or
+            -- transaction stamps the row with the next value of one shared
+            -- counter, so "what changed since N" is a range scan. Writes are
+            -- serialized, so values become visible in increasing order.
+            CREATE TABLE IF NOT EXISTS change_sequence (
+                id INTEGER PRIMARY KEY CHECK (id = 1),
+                value INTEGER NOT NULL
+            );
+
+            ALTER TABLE accounts ADD COLUMN change_seq INTEGER NOT NULL DEFAULT 0;
+            ALTER TABLE transactions ADD COLUMN change_seq INTEGER NOT NULL DEFAULT 0;
+
+            -- Existing rows get distinct values: transactions their id,
+            -- accounts the range after the highest transaction id
+            UPDATE transactions SET change_seq = id;
+            UPDATE accounts SET change_seq = id + (SELECT COALESCE(MAX(id), 0) FROM transactions);
+            INSERT INTO change_sequence (id, value)
+            VALUES (1, (SELECT MAX((SELECT COALESCE(MAX(change_seq), 0) FROM transactions),
+                                   (SELECT COALESCE(MAX(change_seq), 0) FROM accounts))));
+
+            CREATE INDEX IF NOT EXISTS idx_accounts_user_change ON accounts(user_id, change_seq);
+            CREATE INDEX IF NOT EXISTS idx_transactions_from_user_change ON transactions(from_user_id, change_seq);
+            CREATE INDEX IF NOT EXISTS idx_transactions_to_user_change ON transactions(to_user_id, change_seq);
+
+            CREATE TRIGGER accounts_change_seq_insert
+            AFTER INSERT ON accounts
+            BEGIN
+                UPDATE change_sequence SET value = value + 1 WHERE id = 1;
+                UPDATE accounts SET change_seq = (SELECT value FROM change_sequence WHERE id = 1) WHERE id = NEW.id;
+            END;
+
+            -- Column lists keep the stamping update itself (and updated_at)
+            -- from counting as a change
+            CREATE TRIGGER accounts_change_seq_update
+            AFTER UPDATE OF balance, account_type, user_id ON accounts
+            WHEN NEW.balance IS NOT OLD.balance OR NEW.account_type IS NOT OLD.account_type
+              OR NEW.user_id IS NOT OLD.user_id
+            BEGIN
+                UPDATE change_sequence SET value = value + 1 WHERE id = 1;
+                UPDATE accounts SET change_seq = (SELECT value FROM change_sequence WHERE id = 1) WHERE id = NEW.id;
+            END;
+
+            CREATE TRIGGER transactions_change_seq_insert
+            AFTER INSERT ON transactions
+            BEGIN
+                UPDATE change_sequence SET value = value + 1 WHERE id = 1;
+                UPDATE transactions SET change_seq = (SELECT value FROM change_sequence WHERE id = 1) WHERE id = NEW.id;
+            END;
+
+            CREATE TRIGGER transactions_change_seq_update
+            AFTER UPDATE OF status, description, from_balance_after, to_balance_after,
+                            from_user_id, to_user_id ON transactions
+            WHEN NEW.status IS NOT OLD.status OR NEW.description IS NOT OLD.description
+              OR NEW.from_balance_after IS NOT OLD.from_balance_after
+              OR NEW.to_balance_after IS NOT OLD.to_balance_after
+              OR NEW.from_user_id IS NOT OLD.from_user_id OR NEW.to_user_id IS NOT OLD.to_user_id
+            BEGIN
+                UPDATE change_sequence SET value = value + 1 WHERE id = 1;
+                UPDATE transactions SET change_seq = (SELECT value FROM change_sequence WHERE id = 1) WHERE id = NEW.id;
+            END;
+        )" },
+        { 8, "deferred index ledger", R"(
+            -- Indexes a bulk load has dropped and not yet rebuilt, with their
+            -- CREATE statements. Rows left by an interrupted load are
+            -- rebuilt when the database is next opened.
+            CREATE TABLE IF NOT EXISTS deferred_indexes (
+                name TEXT PRIMARY KEY,
+                sql TEXT NOT NULL
+            );
+        )" },
+    };
+    return upgrades;
+}
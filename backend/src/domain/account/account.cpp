@@ -1,20 +1,16 @@
 #include "domain/account/account.h"
-#include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <cmath>
 
-Account::Account(int userId, const std::string& accountNumber, AccountType accountType, double balance)
-    : userId_(userId), accountNumber_(accountNumber), accountType_(accountType), balance_(balance) {
-    std::string timestamp = getCurrentTimestamp();
-    createdAt_ = timestamp;
-    updatedAt_ = timestamp;
+Account::Account(int userId, std::string_view accountNumber, AccountType accountType, double balance)
+    : userId_(userId), balance_(balance), createdAt_(Timestamp::now()), updatedAt_(createdAt_),
+      accountNumber_(accountNumber), accountType_(accountType) {
 }
 
-Account::Account(int id, int userId, const std::string& accountNumber, AccountType accountType, 
-                double balance, const std::string& createdAt, const std::string& updatedAt)
-    : id_(id), userId_(userId), accountNumber_(accountNumber), accountType_(accountType),
-      balance_(balance), createdAt_(createdAt), updatedAt_(updatedAt) {
+Account::Account(int id, int userId, std::string_view accountNumber, AccountType accountType, 
+                double balance, std::string_view createdAt, std::string_view updatedAt)
+    : id_(id), userId_(userId), balance_(balance),
+      createdAt_(Timestamp::parseOrUnset(createdAt)), updatedAt_(Timestamp::parseOrUnset(updatedAt)),
+      accountNumber_(accountNumber), accountType_(accountType) {
 }
 
 bool Account::canWithdraw(double amount) const {
@@ -57,12 +53,12 @@ bool Account::isValid() const {
     }
     
     // Account number validation
-    if (accountNumber_.empty() || accountNumber_.length() != 11) {
+    if (accountNumber_.empty() || accountNumber_.size() != 11) {
         return false;
     }
     
     // Account number should start with "ACC"
-    if (accountNumber_.substr(0, 3) != "ACC") {
+    if (accountNumber_.view().substr(0, 3) != "ACC") {
         return false;
     }
     
@@ -83,11 +79,11 @@ std::string Account::getValidationError() const {
         return "Account number cannot be empty";
     }
     
-    if (accountNumber_.length() != 11) {
+    if (accountNumber_.size() != 11) {
         return "Account number must be 11 characters long";
     }
     
-    if (accountNumber_.substr(0, 3) != "ACC") {
+    if (accountNumber_.view().substr(0, 3) != "ACC") {
         return "Account number must start with 'ACC'";
     }
     
@@ -97,12 +93,3 @@ std::string Account::getValidationError() const {
     
     return "";
 }
-
-std::string Account::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
-}
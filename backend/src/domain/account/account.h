@@ -1,28 +1,37 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <chrono>
+#include <string_view>
 #include "domain/account/account_type.h"
+#include "utils/inline_string.h"
+#include "utils/timestamp.h"
 
+// Kept small and allocation-free: the account number is stored inline,
+// timestamps as seconds since the epoch, and the type as one byte.
 class Account {
 public:
     Account() = default;
     
     // Constructor for creating new accounts
-    Account(int userId, const std::string& accountNumber, AccountType accountType, double balance = 0.0);
+    Account(int userId, std::string_view accountNumber, AccountType accountType, double balance = 0.0);
     
-    // Constructor for loading from database
-    Account(int id, int userId, const std::string& accountNumber, AccountType accountType, 
-            double balance, const std::string& createdAt, const std::string& updatedAt);
+    // Constructor for loading from database; nothing is kept as a string, so
+    // the text can be read straight from the statement
+    Account(int id, int userId, std::string_view accountNumber, AccountType accountType, 
+            double balance, std::string_view createdAt, std::string_view updatedAt);
     
     // Getters
     int getId() const { return id_; }
     int getUserId() const { return userId_; }
-    const std::string& getAccountNumber() const { return accountNumber_; }
+    std::string getAccountNumber() const { return accountNumber_.str(); }
+    std::string_view getAccountNumberView() const { return accountNumber_.view(); }
     AccountType getAccountType() const { return accountType_; }
     double getBalance() const { return balance_; }
-    const std::string& getCreatedAt() const { return createdAt_; }
-    const std::string& getUpdatedAt() const { return updatedAt_; }
+    std::string getCreatedAt() const { return Timestamp::format(createdAt_); }
+    std::string getUpdatedAt() const { return Timestamp::format(updatedAt_); }
+    int64_t getCreatedAtSeconds() const { return createdAt_; }
+    int64_t getUpdatedAtSeconds() const { return updatedAt_; }
     
     // Setters
     void setId(int id) { id_ = id; }
@@ -40,12 +49,9 @@ public:
 private:
     int id_ = 0;
     int userId_ = 0;
-    std::string accountNumber_;
-    AccountType accountType_ = AccountType::Checking;
     double balance_ = 0.0;
-    std::string createdAt_;
-    std::string updatedAt_;
-    
-    // Helper to get current timestamp
-    static std::string getCurrentTimestamp();
+    int64_t createdAt_ = Timestamp::kUnset;
+    int64_t updatedAt_ = Timestamp::kUnset;
+    InlineString<15> accountNumber_;
+    AccountType accountType_ = AccountType::Checking;
 };
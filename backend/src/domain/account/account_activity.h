@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+enum class ActivityGranularity {
+    Day,
+    Month
+};
+
+inline std::optional<ActivityGranularity> stringToActivityGranularity(const std::string& str) {
+    if (str == "day") return ActivityGranularity::Day;
+    if (str == "month") return ActivityGranularity::Month;
+    return std::nullopt;
+}
+
+inline std::string activityGranularityToString(ActivityGranularity granularity) {
+    return granularity == ActivityGranularity::Month ? "month" : "day";
+}
+
+// Completed movements of one account over a day ("YYYY-MM-DD") or month
+// ("YYYY-MM"), read from the daily rollup. Amounts are in cents.
+struct ActivityBucket {
+    std::string period;
+    int64_t creditCents = 0;
+    int64_t debitCents = 0;
+    int creditCount = 0;
+    int debitCount = 0;
+    std::optional<int64_t> closingBalanceCents;   // after the bucket's last movement
+    
+    int64_t netCents() const { return creditCents - debitCents; }
+};
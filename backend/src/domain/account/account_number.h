@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Account numbers are "ACC" followed by a 7-digit payload and a Luhn check
+// digit. The payload is a position in the allocation sequence passed through
+// a keyed permutation of [0, 10^7), so consecutive accounts get unrelated
+// looking numbers while distinct positions can never collide.
+class AccountNumber {
+public:
+    // Number of distinct payloads, and so of allocatable account numbers
+    static constexpr uint32_t kCapacity = 10000000;
+
+    // Account number for a sequence position (0 <= sequence < kCapacity)
+    static std::string fromSequence(uint32_t sequence, uint64_t key) {
+        return format(permute(sequence, key));
+    }
+
+    // "ACC" + zero-padded payload + check digit
+    static std::string format(uint32_t payload) {
+        std::string digits = std::to_string(payload);
+        digits.insert(0, 7 - digits.size(), '0');
+        digits += static_cast<char>('0' + luhnCheckDigit(digits));
+        return "ACC" + digits;
+    }
+
+    // "ACC" followed by eight digits. Only the shape is checked: numbers
+    // drawn at random before the allocator have the same shape without a
+    // check digit, so a failing check digit does not rule a number out.
+    static bool isWellFormed(std::string_view accountNumber) {
+        if (accountNumber.size() != 11 || accountNumber.compare(0, 3, "ACC") != 0) {
+            return false;
+        }
+        for (size_t i = 3; i < accountNumber.size(); ++i) {
+            if (accountNumber[i] < '0' || accountNumber[i] > '9') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Keyed bijection on [0, kCapacity): a 4-round Feistel network on 24 bits,
+    // cycle-walked until the result falls back inside the range
+    static uint32_t permute(uint32_t value, uint64_t key) {
+        do {
+            value = feistel(value, key);
+        } while (value >= kCapacity);
+        return value;
+    }
+
+private:
+    static constexpr int kRounds = 4;
+    static constexpr uint32_t kHalfBits = 12;
+    static constexpr uint32_t kHalfMask = (1u << kHalfBits) - 1;
+
+    static uint32_t feistel(uint32_t value, uint64_t key) {
+        uint32_t left = value >> kHalfBits;
+        uint32_t right = value & kHalfMask;
+        for (int round = 0; round < kRounds; ++round) {
+            uint32_t next = left ^ roundFunction(right, key, round);
+            left = right;
+            right = next;
+        }
+        return (left << kHalfBits) | right;
+    }
+
+    static uint32_t roundFunction(uint32_t half, uint64_t key, int round) {
+        uint64_t x = key ^ (static_cast<uint64_t>(round) << 32) ^ half;
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return static_cast<uint32_t>(x) & kHalfMask;
+    }
+
+    // Digit that makes the Luhn sum of digits + check digit a multiple of 10
+    static int luhnCheckDigit(const std::string& digits) {
+        int sum = 0;
+        bool doubled = true;
+        for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+            int digit = *it - '0';
+            if (doubled) {
+                digit *= 2;
+                digit = digit > 9 ? digit - 9 : digit;
+            }
+            sum += digit;
+            doubled = !doubled;
+        }
+        return (10 - sum % 10) % 10;
+    }
+};
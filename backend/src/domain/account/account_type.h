@@ -1,26 +1,30 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "utils/enum_codec.h"
 
-enum class AccountType {
-    Checking,
-    Savings
+// The values are the codes stored in the database; append, never renumber
+enum class AccountType : uint8_t {
+    Checking = 0,
+    Savings = 1
 };
 
+inline constexpr EnumCodec<AccountType, 2> kAccountTypeCodec({ "checking", "savings" });
+
+static_assert(kAccountTypeCodec.parse("savings") == AccountType::Savings,
+              "account type names out of step with the enum");
+
 inline std::string accountTypeToString(AccountType type) {
-    switch (type) {
-        case AccountType::Checking:
-            return "checking";
-        case AccountType::Savings:
-            return "savings";
-        default:
-            return "unknown";
-    }
+    return std::string(kAccountTypeCodec.name(type));
+}
+
+inline AccountType stringToAccountType(std::string_view str) {
+    return kAccountTypeCodec.parse(str).value_or(AccountType::Checking);
 }
 
-inline AccountType stringToAccountType(const std::string& str) {
-    if (str == "savings") {
-        return AccountType::Savings;
-    }
-    return AccountType::Checking;
+// Stored code (see schema upgrade 6)
+inline AccountType accountTypeFromCode(int code) {
+    return kAccountTypeCodec.fromCode(code).value_or(AccountType::Checking);
 }
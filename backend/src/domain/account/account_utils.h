@@ -1,23 +1,14 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
 #include <string>
-#include <random>
+#include <vector>
 #include <sstream>
 #include <iomanip>
 
 class AccountUtils {
 public:
-    // Generate a unique account number (format: ACC12345678)
-    static std::string generateAccountNumber() {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(10000000, 99999999);
-        
-        std::stringstream ss;
-        ss << "ACC" << dis(gen);
-        return ss.str();
-    }
-    
     // Format currency for display
     static std::string formatCurrency(double amount) {
         std::stringstream ss;
@@ -40,4 +31,23 @@ public:
     static double roundToTwoDecimals(double amount) {
         return std::round(amount * 100.0) / 100.0;
     }
+    
+    // Convert between validated amounts and integer cents
+    static int64_t toCents(double amount) {
+        return std::llround(amount * 100.0);
+    }
+    
+    static double fromCents(int64_t cents) {
+        return static_cast<double>(cents) / 100.0;
+    }
+    
+    // Exact total of many amounts. A plain loop over contiguous integers,
+    // which the compiler vectorizes for large payroll or import batches.
+    static int64_t sumCents(const std::vector<int64_t>& cents) {
+        int64_t total = 0;
+        for (int64_t value : cents) {
+            total += value;
+        }
+        return total;
+    }
 };
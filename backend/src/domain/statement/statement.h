@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+#include "domain/transaction/transaction_status.h"
+
+// One transaction as it appears on an account's statement. Amounts are in
+// cents; balanceAfter only moves for completed entries.
+struct StatementEntry {
+    int transactionId = 0;
+    std::string createdAt;
+    TransactionType type = TransactionType::Deposit;
+    TransactionStatus status = TransactionStatus::Completed;
+    bool credit = false;
+    int64_t amountCents = 0;
+    int64_t balanceAfterCents = 0;
+    std::string description;
+    std::string counterpartyAccountNumber;   // empty for deposits and withdrawals
+};
+
+// An account's activity for one calendar month (period "YYYY-MM", UTC).
+// Once the month has ended its statement never changes.
+struct Statement {
+    int accountId = 0;
+    std::string accountNumber;
+    std::string period;
+    int64_t openingBalanceCents = 0;
+    int64_t closingBalanceCents = 0;
+    int64_t depositsCents = 0;
+    int64_t withdrawalsCents = 0;
+    int64_t transfersInCents = 0;
+    int64_t transfersOutCents = 0;
+    int entryCount = 0;
+    std::string generatedAt;
+    std::vector<StatementEntry> entries;     // empty when loaded as a summary
+};
+
+class StatementPeriod {
+public:
+    // "YYYY-MM" with a month between 01 and 12
+    static bool isValid(const std::string& period) {
+        int year = 0;
+        int month = 0;
+        return parse(period, year, month);
+    }
+    
+    // First instant of the period, comparable with stored created_at values
+    static std::string startOf(const std::string& period) {
+        return period + "-01 00:00:00";
+    }
+    
+    // First instant of the following period
+    static std::string endOf(const std::string& period) {
+        return startOf(next(period));
+    }
+    
+    static std::string next(const std::string& period) {
+        int year = 0;
+        int month = 0;
+        parse(period, year, month);
+        return format(month == 12 ? year + 1 : year, month == 12 ? 1 : month + 1);
+    }
+    
+    static std::string previous(const std::string& period) {
+        int year = 0;
+        int month = 0;
+        parse(period, year, month);
+        return format(month == 1 ? year - 1 : year, month == 1 ? 12 : month - 1);
+    }
+    
+    // The month in progress (UTC); it and later months are still open
+    static std::string current() {
+        std::time_t now = std::time(nullptr);
+        std::tm utc{};
+        gmtime_r(&now, &utc);
+        return format(utc.tm_year + 1900, utc.tm_mon + 1);
+    }
+    
+    static bool isClosed(const std::string& period) {
+        return period < current();
+    }
+    
+private:
+    static bool parse(const std::string& period, int& year, int& month) {
+        if (period.size() != 7 || period[4] != '-') {
+            return false;
+        }
+        for (size_t i = 0; i < period.size(); ++i) {
+            if (i != 4 && (period[i] < '0' || period[i] > '9')) {
+                return false;
+            }
+        }
+        year = std::stoi(period.substr(0, 4));
+        month = std::stoi(period.substr(5, 2));
+        return month >= 1 && month <= 12;
+    }
+    
+    static std::string format(int year, int month) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d", year, month);
+        return buffer;
+    }
+};
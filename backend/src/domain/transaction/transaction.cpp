@@ -1,21 +1,20 @@
 #include "domain/transaction/transaction.h"
-#include <ctime>
-#include <iomanip>
-#include <sstream>
 
 Transaction::Transaction(std::optional<int> fromAccountId, std::optional<int> toAccountId,
-                        double amount, TransactionType type, const std::string& description,
+                        double amount, TransactionType type, std::string_view description,
                         TransactionStatus status)
-    : fromAccountId_(fromAccountId), toAccountId_(toAccountId), amount_(amount),
-      transactionType_(type), description_(description), status_(status) {
-    createdAt_ = getCurrentTimestamp();
+    : fromAccountId_(fromAccountId.value_or(0)), toAccountId_(toAccountId.value_or(0)),
+      transactionType_(type), status_(status), amount_(amount), createdAt_(Timestamp::now()),
+      description_(description) {
 }
 
 Transaction::Transaction(int id, std::optional<int> fromAccountId, std::optional<int> toAccountId,
-                        double amount, TransactionType type, const std::string& description,
-                        TransactionStatus status, const std::string& createdAt)
-    : id_(id), fromAccountId_(fromAccountId), toAccountId_(toAccountId), amount_(amount),
-      transactionType_(type), description_(description), status_(status), createdAt_(createdAt) {
+                        double amount, TransactionType type, std::string_view description,
+                        TransactionStatus status, std::string_view createdAt)
+    : id_(id), fromAccountId_(fromAccountId.value_or(0)), toAccountId_(toAccountId.value_or(0)),
+      transactionType_(type), status_(status), amount_(amount),
+      createdAt_(Timestamp::parseOrUnset(createdAt)),
+      description_(description) {
 }
 
 bool Transaction::isValid() const {
@@ -28,25 +27,25 @@ bool Transaction::isValid() const {
     switch (transactionType_) {
         case TransactionType::Deposit:
             // Deposit: no from_account, must have to_account
-            if (fromAccountId_.has_value() || !toAccountId_.has_value()) {
+            if (fromAccountId_ != 0 || toAccountId_ == 0) {
                 return false;
             }
             break;
             
         case TransactionType::Withdrawal:
             // Withdrawal: must have from_account, no to_account
-            if (!fromAccountId_.has_value() || toAccountId_.has_value()) {
+            if (fromAccountId_ == 0 || toAccountId_ != 0) {
                 return false;
             }
             break;
             
         case TransactionType::Transfer:
             // Transfer: must have both accounts
-            if (!fromAccountId_.has_value() || !toAccountId_.has_value()) {
+            if (fromAccountId_ == 0 || toAccountId_ == 0) {
                 return false;
             }
             // Cannot transfer to same account
-            if (fromAccountId_.value() == toAccountId_.value()) {
+            if (fromAccountId_ == toAccountId_) {
                 return false;
             }
             break;
@@ -62,31 +61,31 @@ std::string Transaction::getValidationError() const {
     
     switch (transactionType_) {
         case TransactionType::Deposit:
-            if (fromAccountId_.has_value()) {
+            if (fromAccountId_ != 0) {
                 return "Deposit cannot have a source account";
             }
-            if (!toAccountId_.has_value()) {
+            if (toAccountId_ == 0) {
                 return "Deposit must have a destination account";
             }
             break;
             
         case TransactionType::Withdrawal:
-            if (!fromAccountId_.has_value()) {
+            if (fromAccountId_ == 0) {
                 return "Withdrawal must have a source account";
             }
-            if (toAccountId_.has_value()) {
+            if (toAccountId_ != 0) {
                 return "Withdrawal cannot have a destination account";
             }
             break;
             
         case TransactionType::Transfer:
-            if (!fromAccountId_.has_value()) {
+            if (fromAccountId_ == 0) {
                 return "Transfer must have a source account";
             }
-            if (!toAccountId_.has_value()) {
+            if (toAccountId_ == 0) {
                 return "Transfer must have a destination account";
             }
-            if (fromAccountId_.value() == toAccountId_.value()) {
+            if (fromAccountId_ == toAccountId_) {
                 return "Cannot transfer to the same account";
             }
             break;
@@ -94,12 +93,3 @@ std::string Transaction::getValidationError() const {
     
     return "";
 }
-
-std::string Transaction::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
-}
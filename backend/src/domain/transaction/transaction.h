@@ -1,39 +1,58 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <string>
-#include <chrono>
+#include <string_view>
 #include <optional>
 #include "domain/transaction/transaction_status.h"
+#include "utils/timestamp.h"
 
+// Laid out so the fixed fields fit one cache line ahead of the description:
+// account ids use 0 for "none", balances after use NaN for "not recorded",
+// the timestamp is seconds since the epoch and the enums are one byte each.
+// Short descriptions such as the default memos stay in the string's inline
+// buffer. The getters keep the optional/string interface.
 class Transaction {
 public:
     Transaction() = default;
     
     // Constructor for creating new transactions
     Transaction(std::optional<int> fromAccountId, std::optional<int> toAccountId,
-                double amount, TransactionType type, const std::string& description,
+                double amount, TransactionType type, std::string_view description,
                 TransactionStatus status = TransactionStatus::Completed);
     
-    // Constructor for loading from database
+    // Constructor for loading from database; the description is copied and
+    // the timestamp parsed, so the text can be read straight from the statement
     Transaction(int id, std::optional<int> fromAccountId, std::optional<int> toAccountId,
-                double amount, TransactionType type, const std::string& description,
-                TransactionStatus status, const std::string& createdAt);
+                double amount, TransactionType type, std::string_view description,
+                TransactionStatus status, std::string_view createdAt);
     
     // Getters
     int getId() const { return id_; }
-    std::optional<int> getFromAccountId() const { return fromAccountId_; }
-    std::optional<int> getToAccountId() const { return toAccountId_; }
+    std::optional<int> getFromAccountId() const { return optionalId(fromAccountId_); }
+    std::optional<int> getToAccountId() const { return optionalId(toAccountId_); }
     double getAmount() const { return amount_; }
     TransactionType getTransactionType() const { return transactionType_; }
     const std::string& getDescription() const { return description_; }
     TransactionStatus getStatus() const { return status_; }
-    const std::string& getCreatedAt() const { return createdAt_; }
+    std::string getCreatedAt() const { return Timestamp::format(createdAt_); }
+    int64_t getCreatedAtSeconds() const { return createdAt_; }
+    std::optional<double> getFromBalanceAfter() const { return optionalBalance(fromBalanceAfter_); }
+    std::optional<double> getToBalanceAfter() const { return optionalBalance(toBalanceAfter_); }
     
     // Setters
     void setId(int id) { id_ = id; }
     void setStatus(TransactionStatus status) { status_ = status; }
     void setDescription(const std::string& description) { description_ = description; }
     
+    // Resulting balances of the affected accounts, written with the balance update
+    void setBalancesAfter(std::optional<double> fromBalance, std::optional<double> toBalance) {
+        fromBalanceAfter_ = fromBalance.value_or(kNoBalance);
+        toBalanceAfter_ = toBalance.value_or(kNoBalance);
+    }
+    
     // Business logic
     bool isValid() const;
     std::string getValidationError() const;
@@ -44,15 +63,26 @@ public:
     bool isTransfer() const { return transactionType_ == TransactionType::Transfer; }
     
 private:
+    friend class TransactionBatch;
+    
+    static constexpr double kNoBalance = std::numeric_limits<double>::quiet_NaN();
+    
     int id_ = 0;
-    std::optional<int> fromAccountId_;
-    std::optional<int> toAccountId_;
+    int fromAccountId_ = 0;
+    int toAccountId_ = 0;
+    TransactionType transactionType_ = TransactionType::Deposit;
+    TransactionStatus status_ = TransactionStatus::Completed;
     double amount_ = 0.0;
-    TransactionType transactionType_;
+    double fromBalanceAfter_ = kNoBalance;
+    double toBalanceAfter_ = kNoBalance;
+    int64_t createdAt_ = Timestamp::kUnset;
     std::string description_;
-    TransactionStatus status_ = TransactionStatus::Completed;
-    std::string createdAt_;
     
-    // Helper to get current timestamp
-    static std::string getCurrentTimestamp();
+    static std::optional<int> optionalId(int id) {
+        return id != 0 ? std::optional<int>(id) : std::nullopt;
+    }
+    
+    static std::optional<double> optionalBalance(double balance) {
+        return std::isnan(balance) ? std::nullopt : std::optional<double>(balance);
+    }
 };
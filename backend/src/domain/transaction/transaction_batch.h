@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "domain/transaction/transaction.h"
+#include "domain/account/account_utils.h"
+
+// Column-wise (struct of arrays) form of a list of transactions for list and
+// aggregation paths: each field is one contiguous vector, so a pass that
+// only needs amounts and account ids streams through those columns alone.
+// Account ids use 0 for "none" and balances NaN for "not recorded", as in
+// Transaction.
+//
+// The columns live on the memory resource given at construction, so a batch
+// built for one request can sit in that request's arena; that includes the
+// description text, which the default memos keep inline.
+class TransactionBatch {
+public:
+    explicit TransactionBatch(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : ids(resource), fromAccountIds(resource), toAccountIds(resource), amountCents(resource),
+          types(resource), statuses(resource), createdAt(resource), fromBalancesAfter(resource),
+          toBalancesAfter(resource), descriptions(resource) {}
+
+    std::pmr::vector<int> ids;
+    std::pmr::vector<int> fromAccountIds;
+    std::pmr::vector<int> toAccountIds;
+    std::pmr::vector<int64_t> amountCents;
+    std::pmr::vector<TransactionType> types;
+    std::pmr::vector<TransactionStatus> statuses;
+    std::pmr::vector<int64_t> createdAt;            // seconds since the epoch
+    std::pmr::vector<double> fromBalancesAfter;
+    std::pmr::vector<double> toBalancesAfter;
+    std::pmr::vector<std::pmr::string> descriptions;
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+    void reserve(size_t count) {
+        ids.reserve(count);
+        fromAccountIds.reserve(count);
+        toAccountIds.reserve(count);
+        amountCents.reserve(count);
+        types.reserve(count);
+        statuses.reserve(count);
+        createdAt.reserve(count);
+        fromBalancesAfter.reserve(count);
+        toBalancesAfter.reserve(count);
+        descriptions.reserve(count);
+    }
+
+    void push_back(const Transaction& transaction) {
+        ids.push_back(transaction.id_);
+        fromAccountIds.push_back(transaction.fromAccountId_);
+        toAccountIds.push_back(transaction.toAccountId_);
+        amountCents.push_back(AccountUtils::toCents(transaction.amount_));
+        types.push_back(transaction.transactionType_);
+        statuses.push_back(transaction.status_);
+        createdAt.push_back(transaction.createdAt_);
+        fromBalancesAfter.push_back(transaction.fromBalanceAfter_);
+        toBalancesAfter.push_back(transaction.toBalanceAfter_);
+        descriptions.emplace_back(std::string_view(transaction.description_));
+    }
+
+    // Row i as a Transaction (no parsing; the description is copied)
+    Transaction at(size_t i) const {
+        Transaction transaction;
+        transaction.id_ = ids[i];
+        transaction.fromAccountId_ = fromAccountIds[i];
+        transaction.toAccountId_ = toAccountIds[i];
+        transaction.amount_ = AccountUtils::fromCents(amountCents[i]);
+        transaction.transactionType_ = types[i];
+        transaction.status_ = statuses[i];
+        transaction.createdAt_ = createdAt[i];
+        transaction.fromBalanceAfter_ = fromBalancesAfter[i];
+        transaction.toBalanceAfter_ = toBalancesAfter[i];
+        transaction.description_.assign(descriptions[i].data(), descriptions[i].size());
+        return transaction;
+    }
+
+    // Signed sum of completed movements on one account, in cents
+    int64_t netCents(int accountId) const {
+        int64_t net = 0;
+        for (size_t i = 0; i < size(); ++i) {
+            int64_t sign = (toAccountIds[i] == accountId) - (fromAccountIds[i] == accountId);
+            net += statuses[i] == TransactionStatus::Completed ? sign * amountCents[i] : 0;
+        }
+        return net;
+    }
+};
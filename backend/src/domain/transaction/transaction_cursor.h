@@ -0,0 +1,39 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+// Keyset position in history ordered newest first by (created_at, id).
+// Encoded for clients as "<created_at with T>~<id>" and treated as opaque.
+struct TransactionCursor {
+    std::string createdAt;
+    int id = 0;
+    
+    std::string encode() const {
+        std::string encoded = createdAt;
+        if (encoded.size() > 10 && encoded[10] == ' ') {
+            encoded[10] = 'T';
+        }
+        return encoded + "~" + std::to_string(id);
+    }
+    
+    static std::optional<TransactionCursor> decode(const std::string& encoded) {
+        auto separator = encoded.rfind('~');
+        if (separator == std::string::npos || separator + 1 >= encoded.size()) {
+            return std::nullopt;
+        }
+        
+        TransactionCursor cursor;
+        cursor.createdAt = encoded.substr(0, separator);
+        if (cursor.createdAt.size() > 10 && cursor.createdAt[10] == 'T') {
+            cursor.createdAt[10] = ' ';
+        }
+        
+        const std::string id = encoded.substr(separator + 1);
+        if (id.find_first_not_of("0123456789") != std::string::npos || id.size() > 9) {
+            return std::nullopt;
+        }
+        cursor.id = std::stoi(id);
+        return cursor;
+    }
+};
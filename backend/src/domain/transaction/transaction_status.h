@@ -1,59 +1,52 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "utils/enum_codec.h"
 
-enum class TransactionStatus {
-    Pending,
-    Completed,
-    Failed
+// The values are the codes stored in the database; append, never renumber
+enum class TransactionStatus : uint8_t {
+    Pending = 0,
+    Completed = 1,
+    Failed = 2
 };
 
-enum class TransactionType {
-    Deposit,
-    Withdrawal,
-    Transfer
+enum class TransactionType : uint8_t {
+    Deposit = 0,
+    Withdrawal = 1,
+    Transfer = 2
 };
 
+inline constexpr EnumCodec<TransactionStatus, 3> kTransactionStatusCodec({ "pending", "completed", "failed" });
+inline constexpr EnumCodec<TransactionType, 3> kTransactionTypeCodec({ "deposit", "withdrawal", "transfer" });
+
+static_assert(kTransactionStatusCodec.parse("completed") == TransactionStatus::Completed,
+              "status names out of step with the enum");
+static_assert(kTransactionTypeCodec.parse("transfer") == TransactionType::Transfer,
+              "type names out of step with the enum");
+
 inline std::string transactionStatusToString(TransactionStatus status) {
-    switch (status) {
-        case TransactionStatus::Pending:
-            return "pending";
-        case TransactionStatus::Completed:
-            return "completed";
-        case TransactionStatus::Failed:
-            return "failed";
-        default:
-            return "unknown";
-    }
+    return std::string(kTransactionStatusCodec.name(status));
 }
 
-inline TransactionStatus stringToTransactionStatus(const std::string& str) {
-    if (str == "pending") {
-        return TransactionStatus::Pending;
-    } else if (str == "failed") {
-        return TransactionStatus::Failed;
-    }
-    return TransactionStatus::Completed;
+inline TransactionStatus stringToTransactionStatus(std::string_view str) {
+    return kTransactionStatusCodec.parse(str).value_or(TransactionStatus::Completed);
 }
 
 inline std::string transactionTypeToString(TransactionType type) {
-    switch (type) {
-        case TransactionType::Deposit:
-            return "deposit";
-        case TransactionType::Withdrawal:
-            return "withdrawal";
-        case TransactionType::Transfer:
-            return "transfer";
-        default:
-            return "unknown";
-    }
+    return std::string(kTransactionTypeCodec.name(type));
+}
+
+inline TransactionType stringToTransactionType(std::string_view str) {
+    return kTransactionTypeCodec.parse(str).value_or(TransactionType::Transfer);
+}
+
+// Stored codes (see schema upgrade 6)
+inline TransactionStatus transactionStatusFromCode(int code) {
+    return kTransactionStatusCodec.fromCode(code).value_or(TransactionStatus::Completed);
 }
 
-inline TransactionType stringToTransactionType(const std::string& str) {
-    if (str == "deposit") {
-        return TransactionType::Deposit;
-    } else if (str == "withdrawal") {
-        return TransactionType::Withdrawal;
-    }
-    return TransactionType::Transfer;
+inline TransactionType transactionTypeFromCode(int code) {
+    return kTransactionTypeCodec.fromCode(code).value_or(TransactionType::Transfer);
 }
@@ -12,10 +12,10 @@ User::User(const std::string& username, const std::string& pinHash, UserType use
     updatedAt_ = timestamp;
 }
 
-User::User(int id, const std::string& username, const std::string& pinHash, 
-           UserType userType, const std::string& createdAt, const std::string& updatedAt)
-    : id_(id), username_(username), pinHash_(pinHash), userType_(userType),
-      createdAt_(createdAt), updatedAt_(updatedAt) {
+User::User(int id, std::string username, std::string pinHash, 
+           UserType userType, std::string createdAt, std::string updatedAt)
+    : id_(id), username_(std::move(username)), pinHash_(std::move(pinHash)), userType_(userType),
+      createdAt_(std::move(createdAt)), updatedAt_(std::move(updatedAt)) {
 }
 
 bool User::verifyPin(const std::string& pin) const {
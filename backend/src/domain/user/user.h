@@ -12,9 +12,9 @@ public:
     // Constructor for creating new users
     User(const std::string& username, const std::string& pinHash, UserType userType);
     
-    // Constructor for loading from database
-    User(int id, const std::string& username, const std::string& pinHash, 
-         UserType userType, const std::string& createdAt, const std::string& updatedAt);
+    // Constructor for loading from database (strings are moved in)
+    User(int id, std::string username, std::string pinHash, 
+         UserType userType, std::string createdAt, std::string updatedAt);
     
     // Getters
     int getId() const { return id_; }
@@ -1,26 +1,30 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "utils/enum_codec.h"
 
-enum class UserType {
-    Standard,
-    Admin
+// The values are the codes stored in the database; append, never renumber
+enum class UserType : uint8_t {
+    Standard = 0,
+    Admin = 1
 };
 
+inline constexpr EnumCodec<UserType, 2> kUserTypeCodec({ "standard", "admin" });
+
+static_assert(kUserTypeCodec.parse("admin") == UserType::Admin,
+              "user type names out of step with the enum");
+
 inline std::string userTypeToString(UserType type) {
-    switch (type) {
-        case UserType::Standard:
-            return "standard";
-        case UserType::Admin:
-            return "admin";
-        default:
-            return "unknown";
-    }
+    return std::string(kUserTypeCodec.name(type));
+}
+
+inline UserType stringToUserType(std::string_view str) {
+    return kUserTypeCodec.parse(str).value_or(UserType::Standard);
 }
 
-inline UserType stringToUserType(const std::string& str) {
-    if (str == "admin") {
-        return UserType::Admin;
-    }
-    return UserType::Standard;
+// Stored code (see schema upgrade 6)
+inline UserType userTypeFromCode(int code) {
+    return kUserTypeCodec.fromCode(code).value_or(UserType::Standard);
 }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <string>
-#include <random>
 #include <sstream>
 #include <iomanip>
 #include <openssl/sha.h>
@@ -39,15 +38,4 @@ public:
         
         return true;
     }
-    
-    // Generate a unique account number
-    static std::string generateAccountNumber() {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(10000000, 99999999);
-        
-        std::stringstream ss;
-        ss << "ACC" << dis(gen);
-        return ss.str();
-    }
 };
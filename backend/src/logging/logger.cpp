@@ -0,0 +1,202 @@
+#include "logging/logger.h"
+#include "utils/timestamp.h"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// Releases the thread's ring to the writer thread when the thread exits;
+// records still in it are written before it is discarded
+struct BufferHandle {
+    std::shared_ptr<void> owner;
+    std::atomic<bool>* retired = nullptr;
+
+    ~BufferHandle() {
+        if (retired) {
+            retired->store(true, std::memory_order_release);
+        }
+    }
+};
+
+bool needsQuotes(std::string_view text) {
+    if (text.empty()) {
+        return true;
+    }
+    for (char c : text) {
+        if (c == ' ' || c == '=' || c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void appendText(std::string& line, std::string_view text) {
+    if (!needsQuotes(text)) {
+        line += text;
+        return;
+    }
+    line += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': line += "\\\""; break;
+            case '\\': line += "\\\\"; break;
+            case '\n': line += "\\n"; break;
+            case '\r': line += "\\r"; break;
+            case '\t': line += "\\t"; break;
+            default: line += c;
+        }
+    }
+    line += '"';
+}
+
+void appendInt(std::string& line, int64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    line.append(digits, result.ptr);
+}
+
+}  // namespace
+
+Logger::Logger() {
+    if (const char* configured = std::getenv("NOVABANK_LOG_LEVEL")) {
+        level_.store(kLogLevelCodec.parse(configured).value_or(LogLevel::Info), std::memory_order_relaxed);
+    }
+    drainer_ = std::thread([this] { drainLoop(); });
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(drainMutex_);
+        stopping_ = true;
+    }
+    drainWake_.notify_one();
+    drainer_.join();
+}
+
+Logger::ThreadBuffer& Logger::localBuffer() {
+    thread_local BufferHandle handle;
+    thread_local ThreadBuffer* local = nullptr;
+
+    if (!local) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        {
+            std::lock_guard<std::mutex> lock(buffersMutex_);
+            buffer->threadId = nextThreadId_++;
+            buffers_.push_back(buffer);
+        }
+        handle.retired = &buffer->retired;
+        handle.owner = buffer;
+        local = buffer.get();
+    }
+    return *local;
+}
+
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(drainMutex_);
+    // A pass already under way may have missed records logged just now; wait
+    // for the next complete one
+    uint64_t target = drainPasses_ + 2;
+    drainWake_.notify_one();
+    drainDone_.wait(lock, [this, target] { return drainPasses_ >= target || stopping_; });
+}
+
+void Logger::drainLoop() {
+    std::string out;
+    std::unique_lock<std::mutex> lock(drainMutex_);
+    while (true) {
+        bool stopping = stopping_;
+        lock.unlock();
+        wakeRequested_.store(false, std::memory_order_relaxed);
+        drainOnce(out);
+        lock.lock();
+
+        ++drainPasses_;
+        drainDone_.notify_all();
+        if (stopping) {
+            return;
+        }
+        drainWake_.wait_for(lock, kDrainInterval);
+    }
+}
+
+void Logger::drainOnce(std::string& out) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        buffers = buffers_;
+    }
+
+    bool wrote = false;
+    for (const auto& buffer : buffers) {
+        // Read before draining: a ring retired after this point is drained
+        // once more on the next pass before it is dropped
+        bool retired = buffer->retired.load(std::memory_order_acquire);
+
+        while (const LogRecord* record = buffer->ring.front()) {
+            format(*record, out);
+            buffer->ring.release();
+            if (out.size() >= kWriteChunk) {
+                std::fwrite(out.data(), 1, out.size(), stderr);
+                out.clear();
+                wrote = true;
+            }
+        }
+
+        if (retired) {
+            std::lock_guard<std::mutex> lock(buffersMutex_);
+            buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+        }
+    }
+
+    if (!out.empty()) {
+        std::fwrite(out.data(), 1, out.size(), stderr);
+        out.clear();
+        wrote = true;
+    }
+    if (wrote) {
+        std::fflush(stderr);
+    }
+}
+
+void Logger::format(const LogRecord& record, std::string& out) {
+    // Records arrive mostly in time order; render each second once
+    int64_t seconds = record.timeNanos / 1000000000;
+    if (seconds != formattedSecond_) {
+        formattedSecond_ = seconds;
+        secondText_ = Timestamp::format(seconds);
+    }
+
+    char number[32];
+    std::snprintf(number, sizeof(number), ".%03d level=", static_cast<int>(record.timeNanos / 1000000 % 1000));
+    out += secondText_;
+    out += number;
+    out += kLogLevelCodec.name(record.level);
+    out += " thread=";
+    appendInt(out, record.threadId);
+    out += " msg=";
+    appendText(out, record.message);
+
+    for (size_t i = 0; i < record.fieldCount; ++i) {
+        const LogField& field = record.fields[i];
+        out += ' ';
+        out += field.key;
+        out += '=';
+        switch (field.type) {
+            case LogField::Type::Int:
+                appendInt(out, field.value.i);
+                break;
+            case LogField::Type::Double:
+                std::snprintf(number, sizeof(number), "%.15g", field.value.d);
+                out += number;
+                break;
+            case LogField::Type::Bool:
+                out += field.value.b ? "true" : "false";
+                break;
+            case LogField::Type::Text:
+                appendText(out, std::string_view(record.text + field.value.text.offset, field.value.text.length));
+                break;
+        }
+    }
+    out += '\n';
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "utils/enum_codec.h"
+#include "utils/metrics.h"
+#include "utils/spsc_ring.h"
+
+enum class LogLevel : uint8_t {
+    Debug = 0,
+    Info = 1,
+    Warn = 2,
+    Error = 3,
+    Off = 4
+};
+
+inline constexpr EnumCodec<LogLevel, 5> kLogLevelCodec({ "debug", "info", "warn", "error", "off" });
+
+// One key/value pair of a record. Keys are string literals and stored as
+// pointers; text values are copied into the record's text area.
+struct LogField {
+    enum class Type : uint8_t { Int, Double, Bool, Text };
+
+    const char* key;
+    Type type;
+    union {
+        int64_t i;
+        double d;
+        bool b;
+        struct {
+            uint16_t offset;
+            uint16_t length;
+        } text;
+    } value;
+};
+
+// A log call as it sits in a ring: raw values, formatted later by the
+// writer thread. Fields past kMaxFields are dropped and text past
+// kTextCapacity is truncated.
+struct LogRecord {
+    static constexpr size_t kMaxFields = 6;
+    static constexpr size_t kTextCapacity = 240;
+
+    int64_t timeNanos;          // system clock, since the epoch
+    const char* message;        // string literal
+    uint32_t threadId;
+    LogLevel level;
+    uint8_t fieldCount;
+    uint16_t textUsed;
+    std::array<LogField, kMaxFields> fields;
+    char text[kTextCapacity];
+};
+
+// Asynchronous structured logger. Each thread writes records into its own
+// lock-free ring; a background thread drains the rings, formats each record
+// as one "time level thread msg key=value..." line and writes it to stderr.
+// A call below the current level costs one relaxed load; an enabled call
+// costs a clock read and a copy of its values. The writer thread runs every
+// few milliseconds, or sooner once a ring is half full; if a ring fills
+// anyway the record is dropped and counted (log_records_dropped) rather than
+// blocking the caller.
+//
+// The level starts at NOVABANK_LOG_LEVEL (debug, info, warn, error, off;
+// default info) and can be changed at runtime.
+class Logger {
+public:
+    static Logger& getInstance() {
+        static Logger instance;
+        return instance;
+    }
+
+    bool enabled(LogLevel level) const {
+        return level >= level_.load(std::memory_order_relaxed) && level != LogLevel::Off;
+    }
+
+    LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+    void setLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+
+    // fields are alternating keys (string literals) and values (integers,
+    // floating point, bool or text)
+    template <typename... Fields>
+    void write(LogLevel level, const char* message, const Fields&... fields) {
+        static_assert(sizeof...(Fields) % 2 == 0, "log fields are key, value pairs");
+
+        ThreadBuffer& buffer = localBuffer();
+        LogRecord* record = buffer.ring.claim();
+        if (!record) {
+            Metrics::getInstance().increment(Counter::LogRecordsDropped);
+            return;
+        }
+
+        record->timeNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record->message = message;
+        record->threadId = buffer.threadId;
+        record->level = level;
+        record->fieldCount = 0;
+        record->textUsed = 0;
+        appendFields(*record, fields...);
+
+        buffer.ring.publish();
+        if (buffer.ring.backlog() >= kRingCapacity / 2 &&
+            !wakeRequested_.exchange(true, std::memory_order_relaxed)) {
+            drainWake_.notify_one();
+        }
+    }
+
+    // Block until every record logged before the call has been written
+    void flush();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    static constexpr size_t kRingCapacity = 512;
+    static constexpr auto kDrainInterval = std::chrono::milliseconds(5);
+    static constexpr size_t kWriteChunk = 64 * 1024;
+
+    struct ThreadBuffer {
+        SpscRing<LogRecord, kRingCapacity> ring;
+        uint32_t threadId = 0;
+        std::atomic<bool> retired{false};   // owning thread has exited
+    };
+
+    Logger();
+    ~Logger();
+
+    ThreadBuffer& localBuffer();
+    void drainLoop();
+    void drainOnce(std::string& out);
+    void format(const LogRecord& record, std::string& out);
+
+    static void appendFields(LogRecord&) {}
+
+    template <typename Value, typename... Rest>
+    static void appendFields(LogRecord& record, const char* key, const Value& value, const Rest&... rest) {
+        if (record.fieldCount < LogRecord::kMaxFields) {
+            LogField& field = record.fields[record.fieldCount++];
+            field.key = key;
+            setValue(record, field, value);
+        }
+        appendFields(record, rest...);
+    }
+
+    template <typename Value>
+    static void setValue(LogRecord& record, LogField& field, const Value& value) {
+        using T = std::decay_t<Value>;
+        if constexpr (std::is_same_v<T, bool>) {
+            field.type = LogField::Type::Bool;
+            field.value.b = value;
+        } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            field.type = LogField::Type::Int;
+            field.value.i = static_cast<int64_t>(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            field.type = LogField::Type::Double;
+            field.value.d = static_cast<double>(value);
+        } else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            setText(record, field, value ? std::string_view(value) : std::string_view());
+        } else {
+            setText(record, field, std::string_view(value));
+        }
+    }
+
+    static void setText(LogRecord& record, LogField& field, std::string_view text) {
+        size_t length = std::min(text.size(), LogRecord::kTextCapacity - record.textUsed);
+        std::memcpy(record.text + record.textUsed, text.data(), length);
+        field.type = LogField::Type::Text;
+        field.value.text.offset = record.textUsed;
+        field.value.text.length = static_cast<uint16_t>(length);
+        record.textUsed = static_cast<uint16_t>(record.textUsed + length);
+    }
+
+    std::atomic<LogLevel> level_{LogLevel::Info};
+
+    std::mutex buffersMutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    uint32_t nextThreadId_ = 1;
+
+    std::mutex drainMutex_;
+    std::condition_variable drainWake_;
+    std::condition_variable drainDone_;
+    std::atomic<bool> wakeRequested_{false};   // one early wake-up per pass
+    uint64_t drainPasses_ = 0;
+    bool stopping_ = false;
+    std::thread drainer_;
+
+    // Writer thread only
+    int64_t formattedSecond_ = -1;
+    std::string secondText_;
+};
+
+#define NOVABANK_LOG(level, ...)                                  \
+    do {                                                          \
+        Logger& novabankLogger = Logger::getInstance();           \
+        if (novabankLogger.enabled(level)) {                      \
+            novabankLogger.write(level, __VA_ARGS__);             \
+        }                                                         \
+    } while (0)
+
+// LOG_ERROR("Failed to create user", "username", name, "error", message);
+// Values are only evaluated when the level is enabled.
+#define LOG_DEBUG(...) NOVABANK_LOG(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) NOVABANK_LOG(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...) NOVABANK_LOG(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) NOVABANK_LOG(LogLevel::Error, __VA_ARGS__)
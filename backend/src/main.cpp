@@ -1,15 +1,54 @@
 #include <crow.h>
 #include <crow/middlewares/cors.h>
-#include <iostream>
 #include <memory>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
 
 // Include controllers
 #include "api/user/user_controller.h"
 #include "api/account/account_controller.h"
 #include "api/transaction/transaction_controller.h"
 #include "api/admin/admin_controller.h"
+#include "api/statement/statement_controller.h"
+#include "api/stream/account_event_feed.h"
+#include "api/stream/stream_controller.h"
+#include "api/sync/sync_controller.h"
+#include "api/shared/async_handler.h"
+#include "db/change_capture.h"
+#include "db/db_executor.h"
+#include "logging/logger.h"
+#include "repository/account/account_number_filter.h"
+#include "repository/account/account_repository.h"
+
+// Read a positive integer setting from the environment
+static int envInt(const char* name, int fallback) {
+    const char* value = std::getenv(name);
+    if (!value) {
+        return fallback;
+    }
+    int parsed = std::atoi(value);
+    return parsed > 0 ? parsed : fallback;
+}
 
 int main() {
+    // Thread pool sizing (HTTP I/O threads vs. DB reader/writer lanes)
+    int hardwareThreads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    int httpThreads = envInt("NOVABANK_HTTP_THREADS", hardwareThreads);
+    DbExecutorConfig dbConfig;
+    dbConfig.readerThreads = static_cast<size_t>(envInt("NOVABANK_DB_READERS", 4));
+    dbConfig.maxQueueDepth = static_cast<size_t>(envInt("NOVABANK_DB_QUEUE_DEPTH", 1024));
+    dbConfig.maxBulkInFlight = static_cast<size_t>(envInt("NOVABANK_DB_BULK_MAX_INFLIGHT", 1));
+    
+    // Writers share the one Database connection and its transaction, so a
+    // second writer would run inside (and commit or roll back) the first
+    // one's transaction
+    int writerThreads = envInt("NOVABANK_DB_WRITERS", 1);
+    if (writerThreads > 1) {
+        LOG_WARN("NOVABANK_DB_WRITERS above 1 is not supported; using 1", "requested", writerThreads);
+    }
+    dbConfig.writerThreads = 1;
+    
     // Initialize Crow app with CORS middleware
     crow::App<crow::CORSHandler> app;
     
@@ -43,6 +82,7 @@ int main() {
         response["endpoints"]["accounts"] = "/api/v1/accounts/*";
         response["endpoints"]["transactions"] = "/api/v1/transactions/*";
         response["endpoints"]["admin"] = "/api/v1/admin/*";
+        response["endpoints"]["sync"] = "/api/v1/sync";
         return crow::response(200, response);
     });
     
@@ -50,50 +90,84 @@ int main() {
     std::shared_ptr<Database> db;
     try {
         db = std::make_shared<Database>("novabank.db");
-        std::cout << "✅ Database initialized successfully" << std::endl;
+        LOG_INFO("Database initialized");
     } catch (const std::exception& e) {
-        std::cerr << "❌ Failed to initialize database: " << e.what() << std::endl;
+        LOG_ERROR("Failed to initialize database", "error", e.what());
         return 1;
     }
     
+    // Answer lookups of unknown account numbers without a query
+    {
+        AccountRepository accounts(db);
+        auto& filter = AccountNumberFilter::getInstance();
+        int accountCount = accounts.count();
+        filter.reset(static_cast<size_t>(accountCount));
+        accounts.forEachAccountNumber([&filter](std::string_view accountNumber) { filter.add(accountNumber); });
+        LOG_INFO("Account number filter loaded", "accounts", accountCount);
+    }
+    
+    // Committed account and transaction changes, delivered off the request
+    // path. The feed is declared first so it outlives the dispatcher thread.
+    AccountEventFeed accountEventFeed(db);
+    ChangeCapture changeCapture(db);
+    changeCapture.subscribe([&accountEventFeed](const ChangeBatch& batch) { accountEventFeed.onCommit(batch); });
+    LOG_INFO("Change capture started", "attached", changeCapture.attached());
+    
+    // All blocking SQLite work runs on these pools, never on Crow's I/O threads
+    auto executor = std::make_shared<DbExecutor>(dbConfig);
+    LOG_INFO("DB executor started", "readers", dbConfig.readerThreads, "writers", dbConfig.writerThreads);
+    
     // Test endpoint to verify database is working
     CROW_ROUTE(app, "/api/v1/test/db")
     .methods("GET"_method)
-    ([db](const crow::request&) {
-        crow::json::wvalue response;
-        bool dbWorking = false;
-        int userCount = 0;
+    ([db, executor](const crow::request& req, crow::response& res) {
+        dispatchToDb(*executor, req, res, [db] {
+            crow::json::wvalue response;
+            bool dbWorking = false;
+            int userCount = 0;
         
-        // Test database with a simple query
-        db->query("SELECT COUNT(*) FROM users", [&dbWorking, &userCount](sqlite3_stmt* stmt) {
-            dbWorking = true;
-            userCount = sqlite3_column_int(stmt, 0);
-        });
+            // Test database with a simple query
+            db->query("SELECT COUNT(*) FROM users", [&dbWorking, &userCount](sqlite3_stmt* stmt) {
+                dbWorking = true;
+                userCount = sqlite3_column_int(stmt, 0);
+            });
         
-        response["database_connected"] = dbWorking;
-        response["user_count"] = userCount;
-        response["message"] = dbWorking ? "Database is working" : "Database connection failed";
+            response["database_connected"] = dbWorking;
+            response["user_count"] = userCount;
+            response["message"] = dbWorking ? "Database is working" : "Database connection failed";
         
-        return crow::response(dbWorking ? 200 : 500, response);
+            return crow::response(dbWorking ? 200 : 500, response);
+        });
     });
     
     // Register controllers
-    UserController userController(db);
+    UserController userController(db, executor);
     userController.registerRoutes(app);
     
-    AccountController accountController(db);
+    AccountController accountController(db, executor);
     accountController.registerRoutes(app);
     
-    TransactionController transactionController(db);
+    TransactionController transactionController(db, executor);
     transactionController.registerRoutes(app);
     
-    AdminController adminController(db);
+    AdminController adminController(db, executor);
     adminController.registerRoutes(app);
     
+    StatementController statementController(db, executor);
+    statementController.registerRoutes(app);
+    
+    StreamController streamController;
+    streamController.registerRoutes(app);
+    
+    SyncController syncController(db, executor);
+    syncController.registerRoutes(app);
+    
     // Start server
     app.port(8080)
-       .multithreaded()
+       .concurrency(httpThreads)
        .run();
     
+    executor->shutdown();
+    
     return 0;
 }
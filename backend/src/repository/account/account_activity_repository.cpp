@@ -0,0 +1,48 @@
+#include "repository/account/account_activity_repository.h"
+#include <iostream>
+
+AccountActivityRepository::AccountActivityRepository(std::shared_ptr<Database> db) : db_(db) {}
+
+std::vector<ActivityBucket> AccountActivityRepository::findBuckets(int accountId,
+                                                                   const std::string& fromDay,
+                                                                   const std::string& toDay,
+                                                                   ActivityGranularity granularity) {
+    std::vector<ActivityBucket> buckets;
+    
+    // Months take the closing balance of their last active day (the bare
+    // column next to the single max())
+    const std::string sql = granularity == ActivityGranularity::Day
+        ? "SELECT day, credit_cents, debit_cents, credit_count, debit_count, closing_balance_cents "
+          "FROM account_daily_activity "
+          "WHERE account_id = ? AND day >= ? AND day <= ? "
+          "ORDER BY day"
+        : "SELECT substr(day, 1, 7), SUM(credit_cents), SUM(debit_cents), SUM(credit_count), "
+          "SUM(debit_count), closing_balance_cents, MAX(day) "
+          "FROM account_daily_activity "
+          "WHERE account_id = ? AND day >= ? AND day <= ? "
+          "GROUP BY substr(day, 1, 7) ORDER BY 1";
+    
+    auto stmt = db_->prepare(sql);
+    if (!stmt) {
+        return buckets;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, accountId);
+    sqlite3_bind_text(stmt.get(), 2, fromDay.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt.get(), 3, toDay.c_str(), -1, SQLITE_TRANSIENT);
+    
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        ActivityBucket bucket;
+        bucket.period = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+        bucket.creditCents = sqlite3_column_int64(stmt.get(), 1);
+        bucket.debitCents = sqlite3_column_int64(stmt.get(), 2);
+        bucket.creditCount = sqlite3_column_int(stmt.get(), 3);
+        bucket.debitCount = sqlite3_column_int(stmt.get(), 4);
+        if (sqlite3_column_type(stmt.get(), 5) != SQLITE_NULL) {
+            bucket.closingBalanceCents = sqlite3_column_int64(stmt.get(), 5);
+        }
+        buckets.push_back(std::move(bucket));
+    }
+    
+    return buckets;
+}
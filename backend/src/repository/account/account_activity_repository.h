@@ -0,0 +1,22 @@
+#pragma once
+
+#include "repository/account/account_activity_repository_interface.h"
+#include "db/db.h"
+#include <memory>
+
+// Reads account_daily_activity, which triggers on the transactions table keep
+// current on every insert, so range aggregates touch one row per active day
+// instead of every transaction.
+class AccountActivityRepository : public IAccountActivityRepository {
+public:
+    explicit AccountActivityRepository(std::shared_ptr<Database> db);
+    
+    // IAccountActivityRepository implementation
+    std::vector<ActivityBucket> findBuckets(int accountId,
+                                            const std::string& fromDay,
+                                            const std::string& toDay,
+                                            ActivityGranularity granularity) override;
+    
+private:
+    std::shared_ptr<Database> db_;
+};
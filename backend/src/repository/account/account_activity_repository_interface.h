@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "domain/account/account_activity.h"
+
+class IAccountActivityRepository {
+public:
+    virtual ~IAccountActivityRepository() = default;
+    
+    // Activity buckets between two days (inclusive, "YYYY-MM-DD"), oldest
+    // first; days without completed movements are omitted
+    virtual std::vector<ActivityBucket> findBuckets(int accountId,
+                                                    const std::string& fromDay,
+                                                    const std::string& toDay,
+                                                    ActivityGranularity granularity) = 0;
+};
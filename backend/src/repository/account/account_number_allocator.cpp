@@ -0,0 +1,56 @@
+#include "repository/account/account_number_allocator.h"
+#include "repository/account/account_number_filter.h"
+#include "domain/account/account_number.h"
+#include "logging/logger.h"
+#include <algorithm>
+
+AccountNumberAllocator::AccountNumberAllocator(std::shared_ptr<Database> db)
+    : db_(db), accountRepository_(db) {}
+
+std::optional<std::string> AccountNumberAllocator::allocate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    while (true) {
+        if (next_ == blockEnd_ && !reserveBlock()) {
+            return std::nullopt;
+        }
+        
+        std::string accountNumber = AccountNumber::fromSequence(next_++, key_);
+        
+        // Only a number drawn before the allocator existed can be taken
+        if (AccountNumberFilter::getInstance().mightExist(accountNumber) &&
+            accountRepository_.existsByAccountNumber(accountNumber)) {
+            continue;
+        }
+        return accountNumber;
+    }
+}
+
+bool AccountNumberAllocator::reserveBlock() {
+    auto update = db_->prepare(
+        "UPDATE account_number_allocator SET next_sequence = next_sequence + ? "
+        "WHERE id = 1 AND next_sequence < ?");
+    auto select = db_->prepare("SELECT next_sequence, secret_key FROM account_number_allocator WHERE id = 1");
+    if (!update || !select) {
+        return false;
+    }
+    
+    // The server is the only writer of the allocator row, and reservations
+    // are serialized by mutex_, so the row read back is the one just written
+    sqlite3_bind_int64(update.get(), 1, kBlockSize);
+    sqlite3_bind_int64(update.get(), 2, AccountNumber::kCapacity);
+    if (sqlite3_step(update.get()) != SQLITE_DONE || sqlite3_changes(db_->getHandle()) != 1) {
+        LOG_ERROR("Failed to reserve account numbers", "error", db_->getLastError());
+        return false;
+    }
+    
+    if (sqlite3_step(select.get()) != SQLITE_ROW) {
+        return false;
+    }
+    
+    int64_t reservedEnd = sqlite3_column_int64(select.get(), 0);
+    key_ = static_cast<uint64_t>(sqlite3_column_int64(select.get(), 1));
+    next_ = static_cast<uint32_t>(reservedEnd - kBlockSize);
+    blockEnd_ = static_cast<uint32_t>(std::min<int64_t>(reservedEnd, AccountNumber::kCapacity));
+    return true;
+}
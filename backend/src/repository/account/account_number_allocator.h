@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "db/db.h"
+#include "repository/account/account_repository.h"
+
+// Hands out account numbers from the persisted sequence in
+// account_number_allocator, mapped through AccountNumber's keyed permutation.
+// Distinct sequence positions give distinct numbers, so no existence query is
+// needed except for numbers that the account number filter cannot rule out
+// (randomly drawn numbers from before the allocator existed).
+//
+// Sequence positions are reserved from the database in blocks, one write per
+// block; positions reserved but not used before a restart are skipped.
+class AccountNumberAllocator {
+public:
+    explicit AccountNumberAllocator(std::shared_ptr<Database> db);
+
+    // Next free account number, or nullopt when the number space is exhausted
+    // or the sequence cannot be reserved
+    std::optional<std::string> allocate();
+
+private:
+    static constexpr uint32_t kBlockSize = 32;
+
+    std::shared_ptr<Database> db_;
+    AccountRepository accountRepository_;
+    std::mutex mutex_;
+    uint64_t key_ = 0;
+    uint32_t next_ = 0;       // next unused position of the reserved block
+    uint32_t blockEnd_ = 0;   // one past the reserved block
+
+    bool reserveBlock();
+};
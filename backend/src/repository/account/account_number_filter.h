@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include "utils/counting_bloom_filter.h"
+#include "utils/metrics.h"
+
+// In-memory front for account number lookups. Built once at server startup
+// from every account number, then kept current by AccountRepository on
+// create and delete, so lookups of numbers that do not exist (mistyped
+// transfer targets, candidate numbers for new accounts) are answered without
+// a query.
+//
+// Until load() has run every number "might exist", so processes that never
+// load it (the command line tools) always go to the database. Accounts
+// inserted by another process while the server runs are only seen after a
+// restart.
+class AccountNumberFilter {
+public:
+    static AccountNumberFilter& getInstance() {
+        static AccountNumberFilter instance;
+        return instance;
+    }
+
+    // Start over with an empty filter sized for expectedCount accounts, then
+    // add() every account number. Call before serving requests.
+    void reset(size_t expectedCount) {
+        size_t capacity = std::max(kMinCapacity, expectedCount * 2);
+        filter_ = std::make_unique<CountingBloomFilter>(capacity, kFalsePositiveRate);
+        loaded_.store(true, std::memory_order_release);
+    }
+
+    bool isLoaded() const { return loaded_.load(std::memory_order_acquire); }
+
+    // Add before the row is inserted, so a concurrent reader never sees a row
+    // the filter denies
+    void add(std::string_view accountNumber) {
+        if (isLoaded()) {
+            filter_->add(accountNumber);
+        }
+    }
+
+    // Remove only once the delete is committed; a number left behind merely
+    // costs one query later
+    void remove(std::string_view accountNumber) {
+        if (isLoaded()) {
+            filter_->remove(accountNumber);
+        }
+    }
+
+    // False means the number is certainly not in use
+    bool mightExist(std::string_view accountNumber) const {
+        if (!isLoaded() || filter_->mightContain(accountNumber)) {
+            return true;
+        }
+        Metrics::getInstance().increment(Counter::AccountLookupsSkipped);
+        return false;
+    }
+
+private:
+    AccountNumberFilter() = default;
+
+    // Room for growth before the false positive rate starts to climb
+    static constexpr size_t kMinCapacity = 1 << 20;
+    static constexpr double kFalsePositiveRate = 0.01;
+
+    std::unique_ptr<CountingBloomFilter> filter_;
+    std::atomic<bool> loaded_{false};
+};
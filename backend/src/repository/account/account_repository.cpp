@@ -1,11 +1,15 @@
 #include "repository/account/account_repository.h"
-#include <iostream>
+#include "repository/account/account_number_filter.h"
+#include "domain/account/account_number.h"
+#include "db/read_snapshot.h"
+#include "logging/logger.h"
+#include <algorithm>
 
 AccountRepository::AccountRepository(std::shared_ptr<Database> db) : db_(db) {}
 
 std::optional<Account> AccountRepository::create(const Account& account) {
     if (!account.isValid()) {
-        std::cerr << "Invalid account: " << account.getValidationError() << std::endl;
+        LOG_WARN("Invalid account", "reason", account.getValidationError());
         return std::nullopt;
     }
     
@@ -16,13 +20,15 @@ std::optional<Account> AccountRepository::create(const Account& account) {
         return std::nullopt;
     }
     
+    AccountNumberFilter::getInstance().add(account.getAccountNumber());
+    
     sqlite3_bind_int(stmt.get(), 1, account.getUserId());
     sqlite3_bind_text(stmt.get(), 2, account.getAccountNumber().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt.get(), 3, accountTypeToString(account.getAccountType()).c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 3, kAccountTypeCodec.code(account.getAccountType()));
     sqlite3_bind_double(stmt.get(), 4, account.getBalance());
     
     if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
-        std::cerr << "Failed to create account: " << db_->getLastError() << std::endl;
+        LOG_ERROR("Failed to create account", "error", db_->getLastError());
         return std::nullopt;
     }
     
@@ -31,8 +37,17 @@ std::optional<Account> AccountRepository::create(const Account& account) {
 }
 
 std::optional<Account> AccountRepository::findById(int id) {
+    return findByIdOn(*db_, id);
+}
+
+std::optional<Account> AccountRepository::findById(ReadSnapshot& snapshot, int id) {
+    return findByIdOn(snapshot, id);
+}
+
+template <typename Connection>
+std::optional<Account> AccountRepository::findByIdOn(Connection& connection, int id) {
     const std::string sql = "SELECT id, user_id, account_number, account_type, balance, created_at, updated_at FROM accounts WHERE id = ?";
-    auto stmt = db_->prepare(sql);
+    auto stmt = connection.prepare(sql);
     
     if (!stmt) {
         return std::nullopt;
@@ -41,13 +56,64 @@ std::optional<Account> AccountRepository::findById(int id) {
     sqlite3_bind_int(stmt.get(), 1, id);
     
     if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        return accountFromStatement(stmt.get());
+        return accountFromStatement(RowView(stmt.get()));
     }
     
     return std::nullopt;
 }
 
+std::pmr::vector<Account> AccountRepository::findByIds(const std::pmr::vector<int>& ids,
+                                                       std::pmr::memory_resource* resource) {
+    return findByIdsOn(*db_, ids, resource);
+}
+
+std::pmr::vector<Account> AccountRepository::findByIds(ReadSnapshot& snapshot, const std::pmr::vector<int>& ids,
+                                                       std::pmr::memory_resource* resource) {
+    return findByIdsOn(snapshot, ids, resource);
+}
+
+template <typename Connection>
+std::pmr::vector<Account> AccountRepository::findByIdsOn(Connection& connection, const std::pmr::vector<int>& ids,
+                                                         std::pmr::memory_resource* resource) {
+    std::pmr::vector<Account> accounts(resource);
+    accounts.reserve(ids.size());
+
+    // Stay well below SQLite's bound parameter limit
+    const size_t chunkSize = 500;
+    for (size_t start = 0; start < ids.size(); start += chunkSize) {
+        size_t count = std::min(chunkSize, ids.size() - start);
+
+        std::string sql = "SELECT id, user_id, account_number, account_type, balance, created_at, updated_at FROM accounts WHERE id IN (";
+        for (size_t i = 0; i < count; ++i) {
+            sql += i == 0 ? "?" : ", ?";
+        }
+        sql += ")";
+
+        auto stmt = connection.prepare(sql);
+        if (!stmt) {
+            return accounts;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            sqlite3_bind_int(stmt.get(), static_cast<int>(i + 1), ids[start + i]);
+        }
+
+        while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+            accounts.push_back(accountFromStatement(RowView(stmt.get())));
+        }
+    }
+
+    return accounts;
+}
+
 std::optional<Account> AccountRepository::findByAccountNumber(const std::string& accountNumber) {
+    // Malformed input (typos, other banks' formats) never reaches the filter
+    // or the database
+    if (!AccountNumber::isWellFormed(accountNumber) ||
+        !AccountNumberFilter::getInstance().mightExist(accountNumber)) {
+        return std::nullopt;
+    }
+    
     const std::string sql = "SELECT id, user_id, account_number, account_type, balance, created_at, updated_at FROM accounts WHERE account_number = ?";
     auto stmt = db_->prepare(sql);
     
@@ -58,17 +124,68 @@ std::optional<Account> AccountRepository::findByAccountNumber(const std::string&
     sqlite3_bind_text(stmt.get(), 1, accountNumber.c_str(), -1, SQLITE_TRANSIENT);
     
     if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        return accountFromStatement(stmt.get());
+        return accountFromStatement(RowView(stmt.get()));
     }
     
     return std::nullopt;
 }
 
+std::vector<Account> AccountRepository::findByAccountNumbers(const std::vector<std::string>& requested) {
+    std::vector<Account> accounts;
+    
+    // Only query well-formed numbers that might exist
+    std::vector<std::string> accountNumbers;
+    accountNumbers.reserve(requested.size());
+    auto& filter = AccountNumberFilter::getInstance();
+    for (const auto& accountNumber : requested) {
+        if (AccountNumber::isWellFormed(accountNumber) && filter.mightExist(accountNumber)) {
+            accountNumbers.push_back(accountNumber);
+        }
+    }
+    
+    // Stay well below SQLite's bound parameter limit
+    const size_t chunkSize = 500;
+    for (size_t start = 0; start < accountNumbers.size(); start += chunkSize) {
+        size_t count = std::min(chunkSize, accountNumbers.size() - start);
+        
+        std::string sql = "SELECT id, user_id, account_number, account_type, balance, created_at, updated_at FROM accounts WHERE account_number IN (";
+        for (size_t i = 0; i < count; ++i) {
+            sql += i == 0 ? "?" : ", ?";
+        }
+        sql += ")";
+        
+        auto stmt = db_->prepare(sql);
+        if (!stmt) {
+            return accounts;
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            const std::string& accountNumber = accountNumbers[start + i];
+            sqlite3_bind_text(stmt.get(), static_cast<int>(i + 1), accountNumber.c_str(), -1, SQLITE_STATIC);
+        }
+        
+        while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+            accounts.push_back(accountFromStatement(RowView(stmt.get())));
+        }
+    }
+    
+    return accounts;
+}
+
 std::vector<Account> AccountRepository::findByUserId(int userId) {
+    return findByUserIdOn(*db_, userId);
+}
+
+std::vector<Account> AccountRepository::findByUserId(ReadSnapshot& snapshot, int userId) {
+    return findByUserIdOn(snapshot, userId);
+}
+
+template <typename Connection>
+std::vector<Account> AccountRepository::findByUserIdOn(Connection& connection, int userId) {
     std::vector<Account> accounts;
     const std::string sql = "SELECT id, user_id, account_number, account_type, balance, created_at, updated_at FROM accounts WHERE user_id = ? ORDER BY created_at";
     
-    auto stmt = db_->prepare(sql);
+    auto stmt = connection.prepare(sql);
     if (!stmt) {
         return accounts;
     }
@@ -76,26 +193,99 @@ std::vector<Account> AccountRepository::findByUserId(int userId) {
     sqlite3_bind_int(stmt.get(), 1, userId);
     
     while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        accounts.push_back(accountFromStatement(stmt.get()));
+        accounts.push_back(accountFromStatement(RowView(stmt.get())));
     }
     
     return accounts;
 }
 
+std::vector<Account> AccountRepository::findChangedByUserId(ReadSnapshot& snapshot, int userId, int64_t since,
+                                                           int64_t upTo) {
+    std::vector<Account> accounts;
+    const std::string sql = "SELECT id, user_id, account_number, account_type, balance, created_at, updated_at "
+                           "FROM accounts WHERE user_id = ? AND change_seq > ? AND change_seq <= ? ORDER BY change_seq";
+    
+    auto stmt = snapshot.prepare(sql);
+    if (!stmt) {
+        return accounts;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, userId);
+    sqlite3_bind_int64(stmt.get(), 2, since);
+    sqlite3_bind_int64(stmt.get(), 3, upTo);
+    
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        accounts.push_back(accountFromStatement(RowView(stmt.get())));
+    }
+    
+    return accounts;
+}
+
+bool AccountRepository::forEachAccountNumber(const std::function<void(std::string_view)>& visit) {
+    auto stmt = db_->prepare("SELECT account_number FROM accounts");
+    if (!stmt) {
+        return false;
+    }
+    
+    return forEachRow(stmt.get(), [&visit](const RowView& row) {
+        visit(row.getText(0));
+    });
+}
+
+int AccountRepository::count() {
+    int total = 0;
+    db_->query("SELECT COUNT(*) FROM accounts", [&total](sqlite3_stmt* stmt) {
+        total = sqlite3_column_int(stmt, 0);
+    });
+    return total;
+}
+
+std::vector<int> AccountRepository::findIdsByUserId(int userId) {
+    std::vector<int> ids;
+    const std::string sql = "SELECT id FROM accounts WHERE user_id = ?";
+    
+    auto stmt = db_->prepare(sql);
+    if (!stmt) {
+        return ids;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, userId);
+    
+    forEachRow(stmt.get(), [&ids](const RowView& row) {
+        ids.push_back(row.getInt(0));
+    });
+    
+    return ids;
+}
+
 std::vector<Account> AccountRepository::findAll() {
+    return findAllOn(*db_);
+}
+
+std::vector<Account> AccountRepository::findAll(ReadSnapshot& snapshot) {
+    return findAllOn(snapshot);
+}
+
+template <typename Connection>
+std::vector<Account> AccountRepository::findAllOn(Connection& connection) {
     std::vector<Account> accounts;
     const std::string sql = "SELECT id, user_id, account_number, account_type, balance, created_at, updated_at FROM accounts ORDER BY user_id, created_at";
     
-    db_->query(sql, [&accounts, this](sqlite3_stmt* stmt) {
-        accounts.push_back(accountFromStatement(stmt));
-    });
+    auto stmt = connection.prepare(sql);
+    if (!stmt) {
+        return accounts;
+    }
+    
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        accounts.push_back(accountFromStatement(RowView(stmt.get())));
+    }
     
     return accounts;
 }
 
 bool AccountRepository::update(const Account& account) {
     if (!account.isValid() || account.getId() <= 0) {
-        std::cerr << "Invalid account for update" << std::endl;
+        LOG_WARN("Invalid account for update", "account_id", account.getId());
         return false;
     }
     
@@ -103,7 +293,7 @@ bool AccountRepository::update(const Account& account) {
     auto stmt = db_->prepare(sql);
     
     if (!stmt) {
-        std::cerr << "Failed to prepare account update statement" << std::endl;
+        LOG_ERROR("Failed to prepare account update statement");
         return false;
     }
     
@@ -112,14 +302,71 @@ bool AccountRepository::update(const Account& account) {
     
     int rc = sqlite3_step(stmt.get());
     if (rc != SQLITE_DONE) {
-        std::cerr << "Failed to execute account update: " << sqlite3_errmsg(sqlite3_db_handle(stmt.get())) << std::endl;
+        LOG_ERROR("Failed to execute account update", "error", sqlite3_errmsg(sqlite3_db_handle(stmt.get())));
         return false;
     }
     
     return true;
 }
 
+bool AccountRepository::updateBalances(const std::vector<Account>& accounts) {
+    const std::string sql = "UPDATE accounts SET balance = ? WHERE id = ?";
+    auto stmt = db_->prepare(sql);
+    
+    if (!stmt) {
+        LOG_ERROR("Failed to prepare account update statement");
+        return false;
+    }
+    
+    for (const auto& account : accounts) {
+        if (!account.isValid() || account.getId() <= 0) {
+            LOG_WARN("Invalid account for update", "account_id", account.getId());
+            return false;
+        }
+        
+        sqlite3_bind_double(stmt.get(), 1, account.getBalance());
+        sqlite3_bind_int(stmt.get(), 2, account.getId());
+        
+        if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+            LOG_ERROR("Failed to execute account update", "error", db_->getLastError());
+            return false;
+        }
+        sqlite3_reset(stmt.get());
+    }
+    
+    return true;
+}
+
+bool AccountRepository::adjustBalances(const std::vector<std::pair<int, double>>& deltas) {
+    const std::string sql = "UPDATE accounts SET balance = balance + ? WHERE id = ?";
+    auto stmt = db_->prepare(sql);
+    
+    if (!stmt) {
+        LOG_ERROR("Failed to prepare account balance adjustment statement");
+        return false;
+    }
+    
+    for (const auto& [accountId, delta] : deltas) {
+        sqlite3_bind_double(stmt.get(), 1, delta);
+        sqlite3_bind_int(stmt.get(), 2, accountId);
+        
+        if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+            LOG_ERROR("Failed to adjust balance", "account_id", accountId, "error", db_->getLastError());
+            return false;
+        }
+        if (sqlite3_changes(db_->getHandle()) != 1) {
+            LOG_WARN("Failed to adjust balance: account not found", "account_id", accountId);
+            return false;
+        }
+        sqlite3_reset(stmt.get());
+    }
+    
+    return true;
+}
+
 bool AccountRepository::deleteById(int id) {
+    auto account = findById(id);
+    
     const std::string sql = "DELETE FROM accounts WHERE id = ?";
     auto stmt = db_->prepare(sql);
     
@@ -128,10 +375,23 @@ bool AccountRepository::deleteById(int id) {
     }
     
     sqlite3_bind_int(stmt.get(), 1, id);
-    return sqlite3_step(stmt.get()) == SQLITE_DONE;
+    if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+        return false;
+    }
+    
+    // Inside an open transaction the delete may still be rolled back, so the
+    // number stays in the filter
+    if (account && sqlite3_get_autocommit(db_->getHandle())) {
+        AccountNumberFilter::getInstance().remove(account->getAccountNumber());
+    }
+    return true;
 }
 
 bool AccountRepository::existsByAccountNumber(const std::string& accountNumber) {
+    if (!AccountNumberFilter::getInstance().mightExist(accountNumber)) {
+        return false;
+    }
+    
     const std::string sql = "SELECT COUNT(*) FROM accounts WHERE account_number = ?";
     auto stmt = db_->prepare(sql);
     
@@ -165,16 +425,8 @@ double AccountRepository::getTotalBalanceForUser(int userId) {
     return 0.0;
 }
 
-Account AccountRepository::accountFromStatement(sqlite3_stmt* stmt) {
-    int id = sqlite3_column_int(stmt, 0);
-    int userId = sqlite3_column_int(stmt, 1);
-    std::string accountNumber = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-    std::string accountTypeStr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
-    double balance = sqlite3_column_double(stmt, 4);
-    std::string createdAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
-    std::string updatedAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
-    
-    AccountType accountType = stringToAccountType(accountTypeStr);
-    
-    return Account(id, userId, accountNumber, accountType, balance, createdAt, updatedAt);
+Account AccountRepository::accountFromStatement(const RowView& row) {
+    return Account(row.getInt(0), row.getInt(1), row.getText(2),
+                   accountTypeFromCode(row.getInt(3)), row.getDouble(4),
+                   row.getText(5), row.getText(6));
 }
@@ -2,6 +2,7 @@
 
 #include "repository/account/account_repository_interface.h"
 #include "db/db.h"
+#include "db/row_view.h"
 #include <memory>
 
 class AccountRepository : public IAccountRepository {
@@ -11,10 +12,25 @@ public:
     // IAccountRepository implementation
     std::optional<Account> create(const Account& account) override;
     std::optional<Account> findById(int id) override;
+    std::optional<Account> findById(ReadSnapshot& snapshot, int id) override;
+    std::pmr::vector<Account> findByIds(const std::pmr::vector<int>& ids,
+                                        std::pmr::memory_resource* resource) override;
+    std::pmr::vector<Account> findByIds(ReadSnapshot& snapshot, const std::pmr::vector<int>& ids,
+                                        std::pmr::memory_resource* resource) override;
     std::optional<Account> findByAccountNumber(const std::string& accountNumber) override;
+    std::vector<Account> findByAccountNumbers(const std::vector<std::string>& accountNumbers) override;
+    bool forEachAccountNumber(const std::function<void(std::string_view)>& visit) override;
+    int count() override;
     std::vector<Account> findByUserId(int userId) override;
+    std::vector<Account> findByUserId(ReadSnapshot& snapshot, int userId) override;
+    std::vector<Account> findChangedByUserId(ReadSnapshot& snapshot, int userId, int64_t since,
+                                             int64_t upTo) override;
+    std::vector<int> findIdsByUserId(int userId) override;
     std::vector<Account> findAll() override;
+    std::vector<Account> findAll(ReadSnapshot& snapshot) override;
     bool update(const Account& account) override;
+    bool updateBalances(const std::vector<Account>& accounts) override;
+    bool adjustBalances(const std::vector<std::pair<int, double>>& deltas) override;
     bool deleteById(int id) override;
     bool existsByAccountNumber(const std::string& accountNumber) override;
     double getTotalBalanceForUser(int userId) override;
@@ -23,5 +39,17 @@ private:
     std::shared_ptr<Database> db_;
     
     // Helper method to create Account from query result
-    Account accountFromStatement(sqlite3_stmt* stmt);
+    static Account accountFromStatement(const RowView& row);
+    
+    // Lookups against the shared connection or a snapshot (anything with
+    // prepare())
+    template <typename Connection>
+    static std::optional<Account> findByIdOn(Connection& connection, int id);
+    template <typename Connection>
+    static std::pmr::vector<Account> findByIdsOn(Connection& connection, const std::pmr::vector<int>& ids,
+                                                 std::pmr::memory_resource* resource);
+    template <typename Connection>
+    static std::vector<Account> findByUserIdOn(Connection& connection, int userId);
+    template <typename Connection>
+    static std::vector<Account> findAllOn(Connection& connection);
 };
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <string_view>
 #include <vector>
 #include <optional>
+#include <utility>
 #include "domain/account/account.h"
 
+class ReadSnapshot;
+
 class IAccountRepository {
 public:
     virtual ~IAccountRepository() = default;
@@ -15,18 +22,60 @@ public:
     // Find account by ID
     virtual std::optional<Account> findById(int id) = 0;
     
+    // Same, as committed in the snapshot
+    virtual std::optional<Account> findById(ReadSnapshot& snapshot, int id) = 0;
+    
+    // Find several accounts by ID in one query (missing IDs are omitted);
+    // the result is allocated from resource
+    virtual std::pmr::vector<Account> findByIds(const std::pmr::vector<int>& ids,
+                                                std::pmr::memory_resource* resource) = 0;
+    
+    // Same, as committed in the snapshot
+    virtual std::pmr::vector<Account> findByIds(ReadSnapshot& snapshot, const std::pmr::vector<int>& ids,
+                                                std::pmr::memory_resource* resource) = 0;
+    
     // Find account by account number
     virtual std::optional<Account> findByAccountNumber(const std::string& accountNumber) = 0;
     
+    // Find several accounts by account number in one query (missing numbers are omitted)
+    virtual std::vector<Account> findByAccountNumbers(const std::vector<std::string>& accountNumbers) = 0;
+    
+    // Visit every account number in use without building Account objects;
+    // the view is only valid during the call
+    virtual bool forEachAccountNumber(const std::function<void(std::string_view)>& visit) = 0;
+    
+    // Number of accounts
+    virtual int count() = 0;
+    
     // Find all accounts for a user
     virtual std::vector<Account> findByUserId(int userId) = 0;
     
+    // Same, as committed in the snapshot
+    virtual std::vector<Account> findByUserId(ReadSnapshot& snapshot, int userId) = 0;
+    
+    // A user's accounts whose change sequence is in (since, upTo], in
+    // sequence order, as committed in the snapshot
+    virtual std::vector<Account> findChangedByUserId(ReadSnapshot& snapshot, int userId, int64_t since,
+                                                     int64_t upTo) = 0;
+    
+    // IDs of all accounts owned by a user
+    virtual std::vector<int> findIdsByUserId(int userId) = 0;
+    
     // Get all accounts (admin only)
     virtual std::vector<Account> findAll() = 0;
     
+    // Same, as committed in the snapshot
+    virtual std::vector<Account> findAll(ReadSnapshot& snapshot) = 0;
+    
     // Update account (mainly for balance updates)
     virtual bool update(const Account& account) = 0;
     
+    // Write the balances of several accounts, reusing one prepared statement
+    virtual bool updateBalances(const std::vector<Account>& accounts) = 0;
+    
+    // Add a signed amount to each account's balance in place (id, delta)
+    virtual bool adjustBalances(const std::vector<std::pair<int, double>>& deltas) = 0;
+    
     // Delete account
     virtual bool deleteById(int id) = 0;
     
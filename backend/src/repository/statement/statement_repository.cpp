@@ -0,0 +1,276 @@
+#include "repository/statement/statement_repository.h"
+#include "db/read_snapshot.h"
+#include "domain/account/account_utils.h"
+#include "logging/logger.h"
+
+StatementRepository::StatementRepository(std::shared_ptr<Database> db) : db_(db) {}
+
+std::optional<Statement> StatementRepository::build(ReadSnapshot& snapshot, int accountId, const std::string& period) {
+    const std::string periodStart = StatementPeriod::startOf(period);
+    const std::string periodEnd = StatementPeriod::endOf(period);
+    
+    auto accountStmt = snapshot.prepare("SELECT account_number, balance FROM accounts WHERE id = ? AND created_at < ?");
+    if (!accountStmt) {
+        return std::nullopt;
+    }
+    
+    sqlite3_bind_int(accountStmt.get(), 1, accountId);
+    sqlite3_bind_text(accountStmt.get(), 2, periodEnd.c_str(), -1, SQLITE_TRANSIENT);
+    
+    // Accounts opened after the period have no statement for it
+    if (sqlite3_step(accountStmt.get()) != SQLITE_ROW) {
+        return std::nullopt;
+    }
+    
+    Statement statement;
+    statement.accountId = accountId;
+    statement.accountNumber = reinterpret_cast<const char*>(sqlite3_column_text(accountStmt.get(), 0));
+    statement.period = period;
+    double currentBalance = sqlite3_column_double(accountStmt.get(), 1);
+    accountStmt.reset();
+    
+    auto opening = openingBalance(snapshot, accountId, period, currentBalance);
+    if (!opening) {
+        return std::nullopt;
+    }
+    statement.openingBalanceCents = *opening;
+    
+    const std::string sql = R"(
+        SELECT t.id, t.transaction_type, t.status, t.from_account_id, t.amount,
+               t.description, t.created_at,
+               CASE WHEN t.from_account_id = ?1 THEN ta.account_number ELSE fa.account_number END
+        FROM transactions t
+        LEFT JOIN accounts fa ON fa.id = t.from_account_id
+        LEFT JOIN accounts ta ON ta.id = t.to_account_id
+        WHERE (t.from_account_id = ?1 OR t.to_account_id = ?1)
+          AND t.created_at >= ?2 AND t.created_at < ?3
+        ORDER BY t.created_at, t.id
+    )";
+    auto stmt = snapshot.prepare(sql);
+    if (!stmt) {
+        return std::nullopt;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, accountId);
+    sqlite3_bind_text(stmt.get(), 2, periodStart.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt.get(), 3, periodEnd.c_str(), -1, SQLITE_TRANSIENT);
+    
+    int64_t balance = statement.openingBalanceCents;
+    int rc;
+    while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+        StatementEntry entry;
+        entry.transactionId = sqlite3_column_int(stmt.get(), 0);
+        entry.type = transactionTypeFromCode(sqlite3_column_int(stmt.get(), 1));
+        entry.status = transactionStatusFromCode(sqlite3_column_int(stmt.get(), 2));
+        entry.credit = sqlite3_column_type(stmt.get(), 3) == SQLITE_NULL ||
+                       sqlite3_column_int(stmt.get(), 3) != accountId;
+        entry.amountCents = AccountUtils::toCents(sqlite3_column_double(stmt.get(), 4));
+        
+        const char* description = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 5));
+        entry.description = description ? description : "";
+        entry.createdAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 6));
+        const char* counterparty = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 7));
+        entry.counterpartyAccountNumber = counterparty ? counterparty : "";
+        
+        if (entry.status == TransactionStatus::Completed) {
+            balance += entry.credit ? entry.amountCents : -entry.amountCents;
+            
+            switch (entry.type) {
+                case TransactionType::Deposit:
+                    statement.depositsCents += entry.amountCents;
+                    break;
+                case TransactionType::Withdrawal:
+                    statement.withdrawalsCents += entry.amountCents;
+                    break;
+                case TransactionType::Transfer:
+                    (entry.credit ? statement.transfersInCents : statement.transfersOutCents) += entry.amountCents;
+                    break;
+            }
+        }
+        entry.balanceAfterCents = balance;
+        
+        statement.entries.push_back(std::move(entry));
+    }
+    
+    if (rc != SQLITE_DONE) {
+        LOG_ERROR("Failed to build statement", "account_id", accountId, "error", snapshot.getLastError());
+        return std::nullopt;
+    }
+    
+    statement.closingBalanceCents = balance;
+    statement.entryCount = static_cast<int>(statement.entries.size());
+    return statement;
+}
+
+std::optional<int64_t> StatementRepository::openingBalance(ReadSnapshot& snapshot, int accountId, const std::string& period,
+                                                          double currentBalance) {
+    auto previousStmt = snapshot.prepare("SELECT closing_balance_cents FROM account_statements WHERE account_id = ? AND period = ?");
+    if (!previousStmt) {
+        return std::nullopt;
+    }
+    
+    const std::string previousPeriod = StatementPeriod::previous(period);
+    sqlite3_bind_int(previousStmt.get(), 1, accountId);
+    sqlite3_bind_text(previousStmt.get(), 2, previousPeriod.c_str(), -1, SQLITE_TRANSIENT);
+    
+    if (sqlite3_step(previousStmt.get()) == SQLITE_ROW) {
+        return sqlite3_column_int64(previousStmt.get(), 0);
+    }
+    previousStmt.reset();
+    
+    const std::string sql = R"(
+        SELECT COALESCE(SUM(CASE WHEN to_account_id = ?1 THEN 1 ELSE 0 END * CAST(ROUND(amount * 100) AS INTEGER))
+                      - SUM(CASE WHEN from_account_id = ?1 THEN 1 ELSE 0 END * CAST(ROUND(amount * 100) AS INTEGER)), 0)
+        FROM transactions
+        WHERE (from_account_id = ?1 OR to_account_id = ?1)
+          AND status = ?3 AND created_at >= ?2
+    )";
+    auto stmt = snapshot.prepare(sql);
+    if (!stmt) {
+        return std::nullopt;
+    }
+    
+    const std::string periodStart = StatementPeriod::startOf(period);
+    sqlite3_bind_int(stmt.get(), 1, accountId);
+    sqlite3_bind_text(stmt.get(), 2, periodStart.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 3, kTransactionStatusCodec.code(TransactionStatus::Completed));
+    
+    if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+        LOG_ERROR("Failed to compute opening balance", "account_id", accountId, "error", snapshot.getLastError());
+        return std::nullopt;
+    }
+    
+    return AccountUtils::toCents(currentBalance) - sqlite3_column_int64(stmt.get(), 0);
+}
+
+bool StatementRepository::save(const Statement& statement, const std::string& body) {
+    const std::string sql = R"(
+        INSERT INTO account_statements (account_id, period, opening_balance_cents, closing_balance_cents,
+                                        deposits_cents, withdrawals_cents, transfers_in_cents,
+                                        transfers_out_cents, entry_count, body)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+        ON CONFLICT (account_id, period) DO NOTHING
+    )";
+    auto stmt = db_->prepare(sql);
+    
+    if (!stmt) {
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, statement.accountId);
+    sqlite3_bind_text(stmt.get(), 2, statement.period.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt.get(), 3, statement.openingBalanceCents);
+    sqlite3_bind_int64(stmt.get(), 4, statement.closingBalanceCents);
+    sqlite3_bind_int64(stmt.get(), 5, statement.depositsCents);
+    sqlite3_bind_int64(stmt.get(), 6, statement.withdrawalsCents);
+    sqlite3_bind_int64(stmt.get(), 7, statement.transfersInCents);
+    sqlite3_bind_int64(stmt.get(), 8, statement.transfersOutCents);
+    sqlite3_bind_int(stmt.get(), 9, statement.entryCount);
+    sqlite3_bind_text(stmt.get(), 10, body.c_str(), static_cast<int>(body.size()), SQLITE_TRANSIENT);
+    
+    if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+        LOG_ERROR("Failed to save statement", "error", db_->getLastError());
+        return false;
+    }
+    
+    return true;
+}
+
+std::optional<std::string> StatementRepository::findBody(int accountId, const std::string& period) {
+    auto stmt = db_->prepare("SELECT body FROM account_statements WHERE account_id = ? AND period = ?");
+    
+    if (!stmt) {
+        return std::nullopt;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, accountId);
+    sqlite3_bind_text(stmt.get(), 2, period.c_str(), -1, SQLITE_TRANSIENT);
+    
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        const char* body = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+        return std::string(body, sqlite3_column_bytes(stmt.get(), 0));
+    }
+    
+    return std::nullopt;
+}
+
+std::vector<Statement> StatementRepository::findByAccountId(int accountId) {
+    std::vector<Statement> statements;
+    const std::string sql = R"(
+        SELECT s.period, s.opening_balance_cents, s.closing_balance_cents, s.deposits_cents,
+               s.withdrawals_cents, s.transfers_in_cents, s.transfers_out_cents, s.entry_count,
+               s.generated_at, a.account_number
+        FROM account_statements s
+        JOIN accounts a ON a.id = s.account_id
+        WHERE s.account_id = ?
+        ORDER BY s.period DESC
+    )";
+    auto stmt = db_->prepare(sql);
+    
+    if (!stmt) {
+        return statements;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, accountId);
+    
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        Statement statement;
+        statement.accountId = accountId;
+        statement.period = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+        statement.openingBalanceCents = sqlite3_column_int64(stmt.get(), 1);
+        statement.closingBalanceCents = sqlite3_column_int64(stmt.get(), 2);
+        statement.depositsCents = sqlite3_column_int64(stmt.get(), 3);
+        statement.withdrawalsCents = sqlite3_column_int64(stmt.get(), 4);
+        statement.transfersInCents = sqlite3_column_int64(stmt.get(), 5);
+        statement.transfersOutCents = sqlite3_column_int64(stmt.get(), 6);
+        statement.entryCount = sqlite3_column_int(stmt.get(), 7);
+        statement.generatedAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 8));
+        statement.accountNumber = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 9));
+        statements.push_back(std::move(statement));
+    }
+    
+    return statements;
+}
+
+bool StatementRepository::deleteFromPeriod(int accountId, const std::string& period) {
+    auto stmt = db_->prepare("DELETE FROM account_statements WHERE account_id = ? AND period >= ?");
+    
+    if (!stmt) {
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, accountId);
+    sqlite3_bind_text(stmt.get(), 2, period.c_str(), -1, SQLITE_TRANSIENT);
+    
+    if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+        LOG_ERROR("Failed to delete statements", "account_id", accountId, "error", db_->getLastError());
+        return false;
+    }
+    
+    return true;
+}
+
+std::vector<int> StatementRepository::findAccountsWithoutStatement(const std::string& period) {
+    std::vector<int> accountIds;
+    const std::string sql = R"(
+        SELECT a.id FROM accounts a
+        WHERE a.created_at < ?
+          AND NOT EXISTS (SELECT 1 FROM account_statements s WHERE s.account_id = a.id AND s.period = ?)
+        ORDER BY a.id
+    )";
+    auto stmt = db_->prepare(sql);
+    
+    if (!stmt) {
+        return accountIds;
+    }
+    
+    const std::string periodEnd = StatementPeriod::endOf(period);
+    sqlite3_bind_text(stmt.get(), 1, periodEnd.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt.get(), 2, period.c_str(), -1, SQLITE_TRANSIENT);
+    
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        accountIds.push_back(sqlite3_column_int(stmt.get(), 0));
+    }
+    
+    return accountIds;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "repository/statement/statement_repository_interface.h"
+#include "db/db.h"
+#include <memory>
+
+class StatementRepository : public IStatementRepository {
+public:
+    explicit StatementRepository(std::shared_ptr<Database> db);
+    
+    // IStatementRepository implementation
+    std::optional<Statement> build(ReadSnapshot& snapshot, int accountId, const std::string& period) override;
+    bool save(const Statement& statement, const std::string& body) override;
+    std::optional<std::string> findBody(int accountId, const std::string& period) override;
+    std::vector<Statement> findByAccountId(int accountId) override;
+    bool deleteFromPeriod(int accountId, const std::string& period) override;
+    std::vector<int> findAccountsWithoutStatement(const std::string& period) override;
+    
+private:
+    std::shared_ptr<Database> db_;
+    
+    // Balance at the start of the period: the previous statement's closing
+    // balance when there is one, otherwise the current balance minus every
+    // completed movement since the period began
+    std::optional<int64_t> openingBalance(ReadSnapshot& snapshot, int accountId, const std::string& period,
+                                          double currentBalance);
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+#include "domain/statement/statement.h"
+
+class ReadSnapshot;
+
+class IStatementRepository {
+public:
+    virtual ~IStatementRepository() = default;
+    
+    // Compute an account's statement for a period from the ledger. Every
+    // read goes through the snapshot, so the balances and entries come from
+    // one committed state.
+    virtual std::optional<Statement> build(ReadSnapshot& snapshot, int accountId, const std::string& period) = 0;
+    
+    // Store a statement with its rendered body; an existing one is kept
+    virtual bool save(const Statement& statement, const std::string& body) = 0;
+    
+    // Rendered body of a stored statement
+    virtual std::optional<std::string> findBody(int accountId, const std::string& period) = 0;
+    
+    // Stored statements for an account, newest first, without entries
+    virtual std::vector<Statement> findByAccountId(int accountId) = 0;
+    
+    // Delete an account's stored statements for the period and every later
+    // one (history inside them changed); they are built again when next
+    // requested or at month close
+    virtual bool deleteFromPeriod(int accountId, const std::string& period) = 0;
+    
+    // Accounts open during the period that have no stored statement for it
+    virtual std::vector<int> findAccountsWithoutStatement(const std::string& period) = 0;
+};
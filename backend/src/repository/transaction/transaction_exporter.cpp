@@ -0,0 +1,178 @@
+#include "repository/transaction/transaction_exporter.h"
+#include "db/read_snapshot.h"
+#include "domain/transaction/transaction_status.h"
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+const char* columnText(sqlite3_stmt* stmt, int column) {
+    const unsigned char* text = sqlite3_column_text(stmt, column);
+    return text ? reinterpret_cast<const char*>(text) : "";
+}
+
+void writeCsvField(std::ostream& out, const char* value) {
+    bool needsQuotes = false;
+    for (const char* p = value; *p; ++p) {
+        if (*p == ',' || *p == '"' || *p == '\n' || *p == '\r') {
+            needsQuotes = true;
+            break;
+        }
+    }
+    if (!needsQuotes) {
+        out << value;
+        return;
+    }
+
+    out << '"';
+    for (const char* p = value; *p; ++p) {
+        if (*p == '"') {
+            out << '"';
+        }
+        out << *p;
+    }
+    out << '"';
+}
+
+void writeJsonString(std::ostream& out, const char* value) {
+    out << '"';
+    for (const char* p = value; *p; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                } else {
+                    out << *p;
+                }
+        }
+    }
+    out << '"';
+}
+
+}
+
+TransactionExporter::TransactionExporter(std::shared_ptr<Database> db) : db_(db) {}
+
+ExportResult TransactionExporter::run(std::ostream& out, TransactionFileFormat format, const ExportFilter& filter) {
+    ExportResult result;
+
+    std::unique_ptr<ReadSnapshot> snapshot;
+    try {
+        snapshot = db_->openReadSnapshot();
+    } catch (const std::exception& e) {
+        result.error = e.what();
+        return result;
+    }
+
+    // Ordered by id so SQLite walks the table in rowid order without sorting
+    std::string sql = "SELECT t.id, t.created_at, t.transaction_type, fa.account_number, ta.account_number, "
+                      "t.amount, t.description, t.status "
+                      "FROM transactions t "
+                      "LEFT JOIN accounts fa ON fa.id = t.from_account_id "
+                      "LEFT JOIN accounts ta ON ta.id = t.to_account_id "
+                      "WHERE 1=1";
+    if (filter.userId) {
+        sql += " AND (t.from_account_id IN (SELECT id FROM accounts WHERE user_id = :user)"
+               " OR t.to_account_id IN (SELECT id FROM accounts WHERE user_id = :user))";
+    }
+    if (filter.accountId) {
+        sql += " AND (t.from_account_id = :account OR t.to_account_id = :account)";
+    }
+    if (filter.startDate) {
+        sql += " AND t.created_at >= :start";
+    }
+    if (filter.endDate) {
+        sql += " AND t.created_at <= :end || ' 23:59:59'";
+    }
+    sql += " ORDER BY t.id";
+
+    {
+        auto stmt = snapshot->prepare(sql);
+        if (!stmt) {
+            result.error = "Failed to prepare export query";
+            return result;
+        }
+
+        auto bindIndex = [&stmt](const char* name) {
+            return sqlite3_bind_parameter_index(stmt.get(), name);
+        };
+        if (filter.userId) {
+            sqlite3_bind_int(stmt.get(), bindIndex(":user"), *filter.userId);
+        }
+        if (filter.accountId) {
+            sqlite3_bind_int(stmt.get(), bindIndex(":account"), *filter.accountId);
+        }
+        if (filter.startDate) {
+            sqlite3_bind_text(stmt.get(), bindIndex(":start"), filter.startDate->c_str(), -1, SQLITE_STATIC);
+        }
+        if (filter.endDate) {
+            sqlite3_bind_text(stmt.get(), bindIndex(":end"), filter.endDate->c_str(), -1, SQLITE_STATIC);
+        }
+
+        if (format == TransactionFileFormat::Csv) {
+            out << "id,created_at,type,from_account,to_account,amount,description,status\n";
+        }
+
+        char amount[32];
+        int rc;
+        while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+            std::snprintf(amount, sizeof(amount), "%.2f", sqlite3_column_double(stmt.get(), 5));
+            std::string_view type = kTransactionTypeCodec.name(transactionTypeFromCode(sqlite3_column_int(stmt.get(), 2)));
+            std::string_view status = kTransactionStatusCodec.name(transactionStatusFromCode(sqlite3_column_int(stmt.get(), 7)));
+
+            if (format == TransactionFileFormat::Csv) {
+                out << sqlite3_column_int64(stmt.get(), 0) << ',';
+                writeCsvField(out, columnText(stmt.get(), 1));
+                out << ',' << type << ',';
+                writeCsvField(out, columnText(stmt.get(), 3));
+                out << ',';
+                writeCsvField(out, columnText(stmt.get(), 4));
+                out << ',' << amount << ',';
+                writeCsvField(out, columnText(stmt.get(), 6));
+                out << ',' << status << '\n';
+            } else {
+                out << "{\"id\":" << sqlite3_column_int64(stmt.get(), 0) << ",\"created_at\":";
+                writeJsonString(out, columnText(stmt.get(), 1));
+                out << ",\"type\":\"" << type << "\",\"from_account\":";
+                if (sqlite3_column_type(stmt.get(), 3) == SQLITE_NULL) {
+                    out << "null";
+                } else {
+                    writeJsonString(out, columnText(stmt.get(), 3));
+                }
+                out << ",\"to_account\":";
+                if (sqlite3_column_type(stmt.get(), 4) == SQLITE_NULL) {
+                    out << "null";
+                } else {
+                    writeJsonString(out, columnText(stmt.get(), 4));
+                }
+                out << ",\"amount\":" << amount << ",\"description\":";
+                writeJsonString(out, columnText(stmt.get(), 6));
+                out << ",\"status\":\"" << status << "\"}\n";
+            }
+
+            ++result.rows;
+        }
+
+        if (rc != SQLITE_DONE) {
+            result.error = "Export query failed: " + snapshot->getLastError();
+            return result;
+        }
+    }
+
+    out.flush();
+    if (!out) {
+        result.error = "Failed to write export";
+        return result;
+    }
+
+    result.success = true;
+    return result;
+}
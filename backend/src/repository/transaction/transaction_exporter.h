@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+#include <ostream>
+#include <memory>
+#include <string>
+#include "db/db.h"
+#include "repository/transaction/transaction_file_format.h"
+
+struct ExportFilter {
+    std::optional<int> userId;              // only transactions touching this user's accounts
+    std::optional<int> accountId;
+    std::optional<std::string> startDate;   // YYYY-MM-DD, inclusive
+    std::optional<std::string> endDate;     // YYYY-MM-DD, inclusive
+};
+
+struct ExportResult {
+    bool success = false;
+    std::string error;
+    size_t rows = 0;
+};
+
+// Writes transactions as CSV or NDJSON straight from a SQLite cursor, one
+// row at a time, so memory use is independent of the result size. Reads run
+// on a ReadSnapshot: the export is consistent as of its start and does not
+// hold up writers. Columns match what TransactionImporter accepts.
+class TransactionExporter {
+public:
+    explicit TransactionExporter(std::shared_ptr<Database> db);
+
+    ExportResult run(std::ostream& out, TransactionFileFormat format, const ExportFilter& filter);
+
+private:
+    std::shared_ptr<Database> db_;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+// Interchange formats for bulk transaction import and export. Both use the
+// same column names, so an export can be imported again.
+enum class TransactionFileFormat {
+    Csv,
+    Ndjson
+};
+
+inline std::optional<TransactionFileFormat> stringToTransactionFileFormat(const std::string& str) {
+    if (str == "csv") {
+        return TransactionFileFormat::Csv;
+    } else if (str == "ndjson") {
+        return TransactionFileFormat::Ndjson;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,456 @@
+#include "repository/transaction/transaction_importer.h"
+#include "domain/account/account_type.h"
+#include "domain/account/account_utils.h"
+#include "logging/logger.h"
+#include "utils/timestamp.h"
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+
+namespace {
+
+// Minimal RFC 4180 reader: quoted fields may contain commas, doubled quotes
+// and line breaks. Reads one record at a time from the stream.
+class CsvReader {
+public:
+    explicit CsvReader(std::istream& in) : in_(in) {}
+
+    bool next(std::vector<std::string>& fields) {
+        fields.clear();
+        std::string line;
+        if (!std::getline(in_, line)) {
+            return false;
+        }
+        recordLine_ = ++line_;
+
+        std::string field;
+        bool quoted = false;
+        size_t i = 0;
+        while (true) {
+            if (i == line.size()) {
+                // A quoted field continues on the next physical line
+                if (quoted && std::getline(in_, line)) {
+                    ++line_;
+                    field += '\n';
+                    i = 0;
+                    continue;
+                }
+                break;
+            }
+
+            char c = line[i++];
+            if (quoted) {
+                if (c != '"') {
+                    field += c;
+                } else if (i < line.size() && line[i] == '"') {
+                    field += '"';
+                    ++i;
+                } else {
+                    quoted = false;
+                }
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                fields.push_back(std::move(field));
+                field.clear();
+            } else if (c != '\r' || i != line.size()) {
+                field += c;
+            }
+        }
+        fields.push_back(std::move(field));
+        return true;
+    }
+
+    size_t recordLine() const { return recordLine_; }
+
+private:
+    std::istream& in_;
+    size_t line_ = 0;
+    size_t recordLine_ = 0;
+};
+
+// Savings accounts keep this much, as in Account::canWithdraw
+constexpr int64_t kMinSavingsBalanceCents = 2500;
+
+bool isBlank(const std::vector<std::string>& fields) {
+    return fields.size() == 1 && fields[0].empty();
+}
+
+// Accepts YYYY-MM-DD, YYYY-MM-DD HH:MM:SS and YYYY-MM-DDTHH:MM:SS[Z] and
+// rewrites them to the YYYY-MM-DD HH:MM:SS form stored by SQLite
+bool normalizeTimestamp(std::string& ts) {
+    if (ts.empty()) {
+        return true;
+    }
+    if (ts.size() == 20 && ts.back() == 'Z') {
+        ts.pop_back();
+    }
+    if (ts.size() == 19 && ts[10] == 'T') {
+        ts[10] = ' ';
+    }
+    if (ts.size() == 10) {
+        ts += " 00:00:00";
+    }
+
+    // The row is stored with this exact text, so it must also be a real
+    // date and time; a row that fails here is rejected rather than stamped
+    // with the import time
+    return ts.size() == 19 && Timestamp::parse(ts).has_value();
+}
+
+std::string jsonField(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    if (it == object.end() || it->is_null()) {
+        return "";
+    }
+    return it->is_string() ? it->get<std::string>() : it->dump();
+}
+
+}
+
+TransactionImporter::TransactionImporter(std::shared_ptr<Database> db, ImportOptions options)
+    : db_(db),
+      options_(options),
+      accountRepository_(db),
+      transactionRepository_(db),
+      statementRepository_(db) {
+    if (options_.batchSize == 0) {
+        options_.batchSize = 1;
+    }
+}
+
+ImportResult TransactionImporter::run(std::istream& input) {
+    ImportResult result;
+    if (!loadAccounts()) {
+        result.error = "Failed to load accounts";
+        return result;
+    }
+
+    // Row source for the chosen format; returns false at end of input
+    CsvReader csv(input);
+    std::vector<std::string> fields;
+    std::unordered_map<std::string, size_t> columns;
+    std::string line;
+    size_t lineNumber = 0;
+
+    if (options_.format == TransactionFileFormat::Csv) {
+        while (csv.next(fields) && isBlank(fields)) {
+        }
+        for (size_t i = 0; i < fields.size(); ++i) {
+            columns[fields[i]] = i;
+        }
+        if (!columns.count("amount") || !columns.count("type")) {
+            result.error = "CSV header must include at least 'amount' and 'type' columns";
+            return result;
+        }
+    }
+
+    auto nextRow = [&](Row& row, std::string& parseError) -> bool {
+        parseError.clear();
+        row = Row{};
+        if (options_.format == TransactionFileFormat::Csv) {
+            do {
+                if (!csv.next(fields)) {
+                    return false;
+                }
+            } while (isBlank(fields));
+            lineNumber = csv.recordLine();
+
+            auto get = [&](const char* key) -> std::string {
+                auto it = columns.find(key);
+                return it != columns.end() && it->second < fields.size() ? fields[it->second] : "";
+            };
+            row = Row{ get("from_account"), get("to_account"), get("amount"), get("type"),
+                       get("description"), get("status"), get("created_at") };
+            return true;
+        }
+
+        do {
+            if (!std::getline(input, line)) {
+                return false;
+            }
+            ++lineNumber;
+        } while (line.find_first_not_of(" \t\r") == std::string::npos);
+
+        auto object = nlohmann::json::parse(line, nullptr, false);
+        if (object.is_discarded() || !object.is_object()) {
+            parseError = "Invalid JSON object";
+            return true;
+        }
+        row = Row{ jsonField(object, "from_account"), jsonField(object, "to_account"), jsonField(object, "amount"),
+                   jsonField(object, "type"), jsonField(object, "description"), jsonField(object, "status"),
+                   jsonField(object, "created_at") };
+        return true;
+    };
+
+    // Atomic imports drop indexes inside the transaction so a rollback also
+    // restores them; batched imports drop them once, outside any batch
+    std::vector<std::string> droppedIndexes;
+    if (options_.atomic && !db_->beginTransaction()) {
+        result.error = "Failed to begin transaction";
+        return result;
+    }
+    if (options_.deferIndexes) {
+        droppedIndexes = db_->dropIndexes("transactions");
+    }
+    if (!options_.atomic && !db_->beginTransaction()) {
+        db_->restoreIndexes(droppedIndexes);
+        result.error = "Failed to begin transaction";
+        return result;
+    }
+
+    size_t uncommitted = 0;
+    bool ok = true;
+    Row row;
+    std::string reason;
+    while (nextRow(row, reason)) {
+        ++result.rowsRead;
+        if (!reason.empty()) {
+            reject(result, lineNumber, reason);
+            continue;
+        }
+
+        auto transaction = toTransaction(row, reason);
+        if (!transaction || !addRow(*transaction, reason)) {
+            reject(result, lineNumber, reason);
+            continue;
+        }
+
+        // An atomic import with a rejected row will be rolled back; the rest
+        // of the input is only validated, to report every bad row at once
+        if (options_.atomic && result.rowsRejected > 0) {
+            pending_.clear();
+            pendingDeltas_.clear();
+            pendingPeriods_.clear();
+            continue;
+        }
+
+        if (pending_.size() >= options_.batchSize) {
+            uncommitted += pending_.size();
+            if (!flush()) {
+                ok = false;
+                break;
+            }
+            if (!options_.atomic) {
+                if (!db_->commit() || !db_->beginTransaction()) {
+                    ok = false;
+                    break;
+                }
+                result.rowsImported += uncommitted;
+                uncommitted = 0;
+            }
+        }
+    }
+
+    bool rejected = options_.atomic && result.rowsRejected > 0;
+    if (ok && !rejected) {
+        uncommitted += pending_.size();
+        ok = flush();
+    }
+    if (ok && !rejected && options_.atomic) {
+        ok = db_->restoreIndexes(droppedIndexes) && rebuildBalancesAfter();
+    }
+    if (ok && !rejected) {
+        ok = db_->commit();
+    }
+
+    if (rejected) {
+        db_->rollback();
+        ok = false;
+        result.error = "Some rows were rejected; nothing was imported";
+    } else if (!ok) {
+        db_->rollback();
+        result.error = "Failed to write imported transactions: " + db_->getLastError();
+    } else {
+        result.rowsImported += uncommitted;
+    }
+
+    if (!options_.atomic && !db_->restoreIndexes(droppedIndexes)) {
+        LOG_ERROR("Failed to rebuild transaction indexes after import");
+        ok = false;
+        result.error = "Failed to rebuild transaction indexes";
+    }
+    
+    // Imported history lands among existing rows, so the touched accounts'
+    // balance-after values are recomputed once the rows are committed
+    if (ok && !options_.atomic) {
+        if (!db_->beginTransaction() || !rebuildBalancesAfter() || !db_->commit()) {
+            db_->rollback();
+            ok = false;
+            result.error = "Failed to recompute balances after imported rows";
+        }
+    }
+
+    result.success = ok;
+    result.accountsUpdated = rejected ? 0 : touchedAccounts_.size();
+    return result;
+}
+
+bool TransactionImporter::rebuildBalancesAfter() {
+    for (int accountId : touchedAccounts_) {
+        if (!transactionRepository_.rebuildBalancesAfter(accountId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TransactionImporter::loadAccounts() {
+    accountIds_.clear();
+    funds_.clear();
+    auto stmt = db_->prepare("SELECT id, account_number, balance, account_type FROM accounts");
+    if (!stmt) {
+        return false;
+    }
+
+    return forEachRow(stmt.get(), [this](const RowView& row) {
+        int id = row.getInt(0);
+        accountIds_.emplace(row.getText(1), id);
+
+        AccountFunds& funds = funds_[id];
+        funds.balanceCents = AccountUtils::toCents(row.getDouble(2));
+        funds.floorCents = accountTypeFromCode(row.getInt(3)) == AccountType::Savings ? kMinSavingsBalanceCents : 0;
+    });
+}
+
+std::optional<Transaction> TransactionImporter::toTransaction(const Row& row, std::string& reason) const {
+    TransactionType type;
+    if (row.type == "deposit") {
+        type = TransactionType::Deposit;
+    } else if (row.type == "withdrawal" || row.type == "withdraw") {
+        type = TransactionType::Withdrawal;
+    } else if (row.type == "transfer") {
+        type = TransactionType::Transfer;
+    } else {
+        reason = "Unknown type '" + row.type + "'";
+        return std::nullopt;
+    }
+
+    TransactionStatus status = TransactionStatus::Completed;
+    if (row.status == "pending") {
+        status = TransactionStatus::Pending;
+    } else if (row.status == "failed") {
+        status = TransactionStatus::Failed;
+    } else if (!row.status.empty() && row.status != "completed") {
+        reason = "Unknown status '" + row.status + "'";
+        return std::nullopt;
+    }
+
+    char* end = nullptr;
+    double amount = std::strtod(row.amount.c_str(), &end);
+    if (row.amount.empty() || *end != '\0' || !AccountUtils::isValidAmount(amount)) {
+        reason = "Invalid amount '" + row.amount + "'";
+        return std::nullopt;
+    }
+    amount = AccountUtils::roundToTwoDecimals(amount);
+
+    auto resolve = [this, &reason](const std::string& number, std::optional<int>& id) {
+        if (number.empty()) {
+            return true;
+        }
+        auto it = accountIds_.find(number);
+        if (it == accountIds_.end()) {
+            reason = "Unknown account " + number;
+            return false;
+        }
+        id = it->second;
+        return true;
+    };
+
+    std::optional<int> fromAccountId;
+    std::optional<int> toAccountId;
+    if (!resolve(row.fromAccount, fromAccountId) || !resolve(row.toAccount, toAccountId)) {
+        return std::nullopt;
+    }
+
+    std::string createdAt = row.createdAt;
+    if (!normalizeTimestamp(createdAt)) {
+        reason = "Invalid created_at '" + row.createdAt + "'";
+        return std::nullopt;
+    }
+
+    std::string description = row.description;
+    if (description.empty()) {
+        description = transactionTypeToString(type);
+    }
+
+    Transaction transaction(0, fromAccountId, toAccountId, amount, type, description, status, createdAt);
+    if (!transaction.isValid()) {
+        reason = transaction.getValidationError();
+        return std::nullopt;
+    }
+    return transaction;
+}
+
+bool TransactionImporter::addRow(const Transaction& transaction, std::string& reason) {
+    // Only completed rows moved money
+    if (transaction.getStatus() == TransactionStatus::Completed) {
+        int64_t cents = AccountUtils::toCents(transaction.getAmount());
+        if (auto fromId = transaction.getFromAccountId()) {
+            AccountFunds& from = funds_[*fromId];
+            if (from.balanceCents - cents < from.floorCents) {
+                reason = "Insufficient funds in the source account";
+                return false;
+            }
+            from.balanceCents -= cents;
+            pendingDeltas_[*fromId] -= cents;
+        }
+        if (auto toId = transaction.getToAccountId()) {
+            funds_[*toId].balanceCents += cents;
+            pendingDeltas_[*toId] += cents;
+        }
+    }
+    
+    // Every row shows on its accounts' statements, whatever its status; rows
+    // stamped with the import time land in the open month
+    if (!transaction.getCreatedAt().empty()) {
+        std::string period = transaction.getCreatedAt().substr(0, 7);
+        for (auto accountId : { transaction.getFromAccountId(), transaction.getToAccountId() }) {
+            if (!accountId) {
+                continue;
+            }
+            auto [it, inserted] = pendingPeriods_.emplace(*accountId, period);
+            if (!inserted && period < it->second) {
+                it->second = period;
+            }
+        }
+    }
+    pending_.push_back(transaction);
+    return true;
+}
+
+bool TransactionImporter::flush() {
+    if (!pending_.empty() && !transactionRepository_.createBatch(pending_, true)) {
+        return false;
+    }
+
+    std::vector<std::pair<int, double>> deltas;
+    deltas.reserve(pendingDeltas_.size());
+    for (const auto& [accountId, cents] : pendingDeltas_) {
+        if (cents != 0) {
+            deltas.emplace_back(accountId, AccountUtils::fromCents(cents));
+        }
+        touchedAccounts_.insert(accountId);
+    }
+    if (!accountRepository_.adjustBalances(deltas)) {
+        return false;
+    }
+
+    
+    for (const auto& [accountId, period] : pendingPeriods_) {
+        if (!statementRepository_.deleteFromPeriod(accountId, period)) {
+            return false;
+        }
+    }
+    
+    pending_.clear();
+    pendingDeltas_.clear();
+    pendingPeriods_.clear();
+    return true;
+}
+
+void TransactionImporter::reject(ImportResult& result, size_t line, const std::string& reason) const {
+    ++result.rowsRejected;
+    if (result.rejections.size() < options_.maxReportedRejections) {
+        result.rejections.push_back("line " + std::to_string(line) + ": " + reason);
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "db/db.h"
+#include "repository/account/account_repository.h"
+#include "repository/statement/statement_repository.h"
+#include "repository/transaction/transaction_file_format.h"
+#include "repository/transaction/transaction_repository.h"
+
+struct ImportOptions {
+    TransactionFileFormat format = TransactionFileFormat::Csv;
+    size_t batchSize = 100000;       // rows per DB transaction when not atomic
+    bool atomic = false;             // all rows in one DB transaction, nothing kept on failure
+                                     // or when any row is rejected
+    bool deferIndexes = true;        // drop transaction indexes for the load, rebuild at the end
+    size_t maxReportedRejections = 100;
+};
+
+struct ImportResult {
+    bool success = false;
+    std::string error;               // set when success is false
+    size_t rowsRead = 0;
+    size_t rowsImported = 0;
+    size_t rowsRejected = 0;
+    size_t accountsUpdated = 0;
+    std::vector<std::string> rejections;  // "line N: reason", capped at maxReportedRejections
+};
+
+// Streams historical transactions from CSV or NDJSON into the database.
+//
+// Rows are parsed one at a time, validated with Transaction::isValid and
+// written with multi-row inserts, so memory use does not grow with the input.
+// Account numbers are resolved through a map loaded once up front. Each
+// account's balance is moved by the net amount of its completed imported
+// rows, applied in the same DB transaction as the rows themselves, so every
+// committed batch leaves balances consistent with the ledger. Balance-after
+// values of the touched accounts are recomputed once at the end. Stored
+// statements of a touched account from the month of its earliest imported
+// row onwards no longer match the ledger and are deleted with the batch;
+// they are built again on request or at the next month close.
+//
+// Like the live write paths, a completed row may not take an account below
+// what Account::canWithdraw allows; balances are followed in file order
+// from their values at the start of the import, and offending rows are
+// rejected.
+//
+// CSV input needs a header row naming its columns; NDJSON objects use the
+// same keys: from_account, to_account, amount, type, description, status,
+// created_at. Only amount and type are required.
+class TransactionImporter {
+public:
+    TransactionImporter(std::shared_ptr<Database> db, ImportOptions options);
+
+    ImportResult run(std::istream& input);
+
+private:
+    struct Row {
+        std::string fromAccount;
+        std::string toAccount;
+        std::string amount;
+        std::string type;
+        std::string description;
+        std::string status;
+        std::string createdAt;
+    };
+
+    std::shared_ptr<Database> db_;
+    ImportOptions options_;
+    AccountRepository accountRepository_;
+    TransactionRepository transactionRepository_;
+    StatementRepository statementRepository_;
+
+    // Running balance of an account during the import, and the lowest
+    // balance a debit may leave (the savings minimum)
+    struct AccountFunds {
+        int64_t balanceCents = 0;
+        int64_t floorCents = 0;
+    };
+
+    std::unordered_map<std::string, int> accountIds_;
+    std::unordered_map<int, AccountFunds> funds_;
+    std::vector<Transaction> pending_;
+    std::unordered_map<int, int64_t> pendingDeltas_;   // account id -> cents
+    std::unordered_map<int, std::string> pendingPeriods_;  // account id -> earliest YYYY-MM
+    std::unordered_set<int> touchedAccounts_;
+
+    bool loadAccounts();
+
+    // Convert a parsed row into a transaction, or explain why it is rejected
+    std::optional<Transaction> toTransaction(const Row& row, std::string& reason) const;
+    // Queue a valid row, or explain why it would overdraw its account
+    bool addRow(const Transaction& transaction, std::string& reason);
+
+    // Write pending rows and balance deltas, and drop the statements they
+    // invalidate, inside the current DB transaction
+    bool flush();
+    
+    // Recompute balance-after values of every account the import touched
+    bool rebuildBalancesAfter();
+
+    void reject(ImportResult& result, size_t line, const std::string& reason) const;
+};
@@ -1,21 +1,28 @@
 #include "repository/transaction/transaction_repository.h"
-#include <iostream>
+#include "db/read_snapshot.h"
+#include "domain/account/account_utils.h"
+#include "logging/logger.h"
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
 
 TransactionRepository::TransactionRepository(std::shared_ptr<Database> db) : db_(db) {}
 
 std::optional<Transaction> TransactionRepository::create(const Transaction& transaction) {
     if (!transaction.isValid()) {
-        std::cerr << "Invalid transaction: " << transaction.getValidationError() << std::endl;
+        LOG_WARN("Invalid transaction", "reason", transaction.getValidationError());
         return std::nullopt;
     }
     
     const std::string sql = "INSERT INTO transactions (from_account_id, to_account_id, amount, "
-                           "transaction_type, description, status) VALUES (?, ?, ?, ?, ?, ?)";
+                           "transaction_type, description, status, from_balance_after, to_balance_after, "
+                           "from_user_id, to_user_id) VALUES (?, ?, ?, ?, ?, ?, ?, ?, "
+                           "(SELECT user_id FROM accounts WHERE id = ?1), "
+                           "(SELECT user_id FROM accounts WHERE id = ?2))";
     auto stmt = db_->prepare(sql);
     
     if (!stmt) {
-        std::cerr << "Failed to prepare transaction insert statement" << std::endl;
+        LOG_ERROR("Failed to prepare transaction insert statement");
         return std::nullopt;
     }
     
@@ -34,26 +41,127 @@ std::optional<Transaction> TransactionRepository::create(const Transaction& tran
     }
     
     sqlite3_bind_double(stmt.get(), 3, transaction.getAmount());
-    sqlite3_bind_text(stmt.get(), 4, transactionTypeToString(transaction.getTransactionType()).c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 4, kTransactionTypeCodec.code(transaction.getTransactionType()));
     sqlite3_bind_text(stmt.get(), 5, transaction.getDescription().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt.get(), 6, transactionStatusToString(transaction.getStatus()).c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 6, kTransactionStatusCodec.code(transaction.getStatus()));
+    bindBalancesAfter(stmt.get(), 7, transaction);
     
     int rc = sqlite3_step(stmt.get());
     if (rc != SQLITE_DONE) {
-        std::cerr << "Failed to create transaction: " << db_->getLastError() 
-                  << " (rc=" << rc << ")" << std::endl;
+        LOG_ERROR("Failed to create transaction", "error", db_->getLastError(), "rc", rc);
         return std::nullopt;
     }
     
     int64_t newId = db_->getLastInsertId();
-    std::cout << "Transaction created with ID: " << newId << std::endl;
+    LOG_DEBUG("Transaction created", "id", newId);
     
     return findById(newId);
 }
 
+std::optional<std::vector<int>> TransactionRepository::createBatch(const std::vector<Transaction>& transactions,
+                                                                   bool keepCreatedAt) {
+    // Multi-row INSERTs of up to kRowsPerInsert rows; the full-size statement
+    // is prepared once and reused, only the final partial chunk needs its own
+    std::shared_ptr<sqlite3_stmt> fullChunk;
+    std::vector<int> ids;
+    ids.reserve(transactions.size());
+    const int columns = keepCreatedAt ? 9 : 8;
+    
+    for (size_t start = 0; start < transactions.size(); start += kRowsPerInsert) {
+        size_t count = std::min(kRowsPerInsert, transactions.size() - start);
+        
+        std::shared_ptr<sqlite3_stmt> stmt;
+        if (count == kRowsPerInsert) {
+            if (!fullChunk) {
+                fullChunk = db_->prepare(multiRowInsertSql(count, keepCreatedAt));
+            }
+            stmt = fullChunk;
+        } else {
+            stmt = db_->prepare(multiRowInsertSql(count, keepCreatedAt));
+        }
+        
+        if (!stmt) {
+            LOG_ERROR("Failed to prepare transaction insert statement");
+            return std::nullopt;
+        }
+        
+        for (size_t row = 0; row < count; ++row) {
+            const Transaction& transaction = transactions[start + row];
+            if (!transaction.isValid()) {
+                LOG_WARN("Invalid transaction", "reason", transaction.getValidationError());
+                return std::nullopt;
+            }
+            
+            int base = static_cast<int>(row) * columns;
+            if (transaction.getFromAccountId().has_value()) {
+                sqlite3_bind_int(stmt.get(), base + 1, transaction.getFromAccountId().value());
+            } else {
+                sqlite3_bind_null(stmt.get(), base + 1);
+            }
+            
+            if (transaction.getToAccountId().has_value()) {
+                sqlite3_bind_int(stmt.get(), base + 2, transaction.getToAccountId().value());
+            } else {
+                sqlite3_bind_null(stmt.get(), base + 2);
+            }
+            
+            sqlite3_bind_double(stmt.get(), base + 3, transaction.getAmount());
+            sqlite3_bind_int(stmt.get(), base + 4, kTransactionTypeCodec.code(transaction.getTransactionType()));
+            sqlite3_bind_text(stmt.get(), base + 5, transaction.getDescription().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt.get(), base + 6, kTransactionStatusCodec.code(transaction.getStatus()));
+            bindBalancesAfter(stmt.get(), base + 7, transaction);
+            if (keepCreatedAt) {
+                if (transaction.getCreatedAtSeconds() == Timestamp::kUnset) {
+                    sqlite3_bind_null(stmt.get(), base + 9);
+                } else {
+                    sqlite3_bind_text(stmt.get(), base + 9, transaction.getCreatedAt().c_str(), -1, SQLITE_TRANSIENT);
+                }
+            }
+        }
+        
+        int rc = sqlite3_step(stmt.get());
+        if (rc != SQLITE_DONE) {
+            LOG_ERROR("Failed to create transactions", "error", db_->getLastError(), "rc", rc);
+            return std::nullopt;
+        }
+        
+        // Rows of one INSERT get consecutive ids: AUTOINCREMENT hands out
+        // max + 1 per row and we hold the write lock for the whole statement
+        int64_t lastId = db_->getLastInsertId();
+        for (size_t row = 0; row < count; ++row) {
+            ids.push_back(static_cast<int>(lastId - static_cast<int64_t>(count - 1 - row)));
+        }
+        sqlite3_reset(stmt.get());
+    }
+    
+    return ids;
+}
+
+std::string TransactionRepository::multiRowInsertSql(size_t rows, bool withCreatedAt) {
+    std::string sql = "INSERT INTO transactions (from_account_id, to_account_id, amount, "
+                      "transaction_type, description, status, from_balance_after, to_balance_after, "
+                      "from_user_id, to_user_id";
+    sql += withCreatedAt ? ", created_at) VALUES " : ") VALUES ";
+    
+    // Owners are looked up from the row's own account parameters; plain "?"
+    // placeholders keep numbering on from the highest index used so far
+    const size_t columns = withCreatedAt ? 9 : 8;
+    for (size_t i = 0; i < rows; ++i) {
+        std::string from = std::to_string(i * columns + 1);
+        std::string to = std::to_string(i * columns + 2);
+        if (i > 0) {
+            sql += ", ";
+        }
+        sql += "(?, ?, ?, ?, ?, ?, ?, ?, (SELECT user_id FROM accounts WHERE id = ?" + from + "), "
+               "(SELECT user_id FROM accounts WHERE id = ?" + to + ")";
+        sql += withCreatedAt ? ", COALESCE(?, CURRENT_TIMESTAMP))" : ")";
+    }
+    return sql;
+}
+
 std::optional<Transaction> TransactionRepository::findById(int id) {
     const std::string sql = "SELECT id, from_account_id, to_account_id, amount, "
-                           "transaction_type, description, status, created_at "
+                           "transaction_type, description, status, created_at, from_balance_after, to_balance_after "
                            "FROM transactions WHERE id = ?";
     auto stmt = db_->prepare(sql);
     
@@ -64,16 +172,50 @@ std::optional<Transaction> TransactionRepository::findById(int id) {
     sqlite3_bind_int(stmt.get(), 1, id);
     
     if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        return transactionFromStatement(stmt.get());
+        return transactionFromStatement(RowView(stmt.get()));
     }
     
     return std::nullopt;
 }
 
+std::vector<Transaction> TransactionRepository::findByIds(ReadSnapshot& snapshot, const std::vector<int>& ids) {
+    std::vector<Transaction> transactions;
+    transactions.reserve(ids.size());
+    
+    // Stay well below SQLite's bound parameter limit
+    const size_t chunkSize = 500;
+    for (size_t start = 0; start < ids.size(); start += chunkSize) {
+        size_t count = std::min(chunkSize, ids.size() - start);
+        
+        std::string sql = "SELECT id, from_account_id, to_account_id, amount, "
+                          "transaction_type, description, status, created_at, from_balance_after, to_balance_after "
+                          "FROM transactions WHERE id IN (";
+        for (size_t i = 0; i < count; ++i) {
+            sql += i == 0 ? "?" : ", ?";
+        }
+        sql += ")";
+        
+        auto stmt = snapshot.prepare(sql);
+        if (!stmt) {
+            return transactions;
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            sqlite3_bind_int(stmt.get(), static_cast<int>(i + 1), ids[start + i]);
+        }
+        
+        while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+            transactions.push_back(transactionFromStatement(RowView(stmt.get())));
+        }
+    }
+    
+    return transactions;
+}
+
 std::vector<Transaction> TransactionRepository::findByAccountId(int accountId) {
     std::vector<Transaction> transactions;
     const std::string sql = "SELECT id, from_account_id, to_account_id, amount, "
-                           "transaction_type, description, status, created_at "
+                           "transaction_type, description, status, created_at, from_balance_after, to_balance_after "
                            "FROM transactions "
                            "WHERE from_account_id = ? OR to_account_id = ? "
                            "ORDER BY created_at DESC";
@@ -87,62 +229,157 @@ std::vector<Transaction> TransactionRepository::findByAccountId(int accountId) {
     sqlite3_bind_int(stmt.get(), 2, accountId);
     
     while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        transactions.push_back(transactionFromStatement(stmt.get()));
+        transactions.push_back(transactionFromStatement(RowView(stmt.get())));
     }
     
     return transactions;
 }
 
-std::vector<Transaction> TransactionRepository::findByUserId(int userId) {
-    std::vector<Transaction> transactions;
-    const std::string sql = "SELECT DISTINCT t.id, t.from_account_id, t.to_account_id, t.amount, "
-                           "t.transaction_type, t.description, t.status, t.created_at "
-                           "FROM transactions t "
-                           "LEFT JOIN accounts a1 ON t.from_account_id = a1.id "
-                           "LEFT JOIN accounts a2 ON t.to_account_id = a2.id "
-                           "WHERE a1.user_id = ? OR a2.user_id = ? "
-                           "ORDER BY t.created_at DESC";
+TransactionBatch TransactionRepository::findByUserId(ReadSnapshot& snapshot, int userId, int limit,
+                                                    const std::optional<TransactionCursor>& after,
+                                                    std::pmr::memory_resource* resource) {
+    TransactionBatch transactions(resource);
+    transactions.reserve(static_cast<size_t>(std::max(limit, 0)));
+    
+    // Newest first across both sides of the user's accounts. Each branch is
+    // a backward range scan on a (user, created_at) index that stops after
+    // `limit` rows; UNION drops transfers between the user's own accounts
+    // showing up twice.
+    const std::string sql = R"(
+        SELECT id, from_account_id, to_account_id, amount, transaction_type, description, status,
+               created_at, from_balance_after, to_balance_after
+        FROM transactions WHERE id IN (
+            SELECT id FROM (
+                SELECT id FROM transactions
+                WHERE from_user_id = ?1 AND created_at <= ?2 AND (created_at < ?2 OR id < ?3)
+                ORDER BY created_at DESC, id DESC LIMIT ?4)
+            UNION
+            SELECT id FROM (
+                SELECT id FROM transactions
+                WHERE to_user_id = ?1 AND created_at <= ?2 AND (created_at < ?2 OR id < ?3)
+                ORDER BY created_at DESC, id DESC LIMIT ?4)
+        )
+        ORDER BY created_at DESC, id DESC LIMIT ?4
+    )";
+    
+    auto stmt = snapshot.prepare(sql);
+    if (!stmt) {
+        return transactions;
+    }
     
-    auto stmt = db_->prepare(sql);
+    const std::string createdAt = after ? after->createdAt : "9999-12-31 23:59:59";
+    sqlite3_bind_int(stmt.get(), 1, userId);
+    sqlite3_bind_text(stmt.get(), 2, createdAt.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt.get(), 3, after ? after->id : INT64_MAX);
+    sqlite3_bind_int(stmt.get(), 4, limit);
+    
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        transactions.push_back(transactionFromStatement(RowView(stmt.get())));
+    }
+    
+    return transactions;
+}
+
+int TransactionRepository::countByUserId(ReadSnapshot& snapshot, int userId) {
+    // Index-only counts; own-account transfers are on both sides once
+    const std::string sql = "SELECT (SELECT COUNT(*) FROM transactions WHERE from_user_id = ?1) "
+                           "+ (SELECT COUNT(*) FROM transactions WHERE to_user_id = ?1) "
+                           "- (SELECT COUNT(*) FROM transactions WHERE from_user_id = ?1 AND to_user_id = ?1)";
+    auto stmt = snapshot.prepare(sql);
+    if (!stmt) {
+        return 0;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, userId);
+    
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        return sqlite3_column_int(stmt.get(), 0);
+    }
+    
+    return 0;
+}
+
+TransactionBatch TransactionRepository::findChangedByUserId(ReadSnapshot& snapshot, int userId, int64_t since,
+                                                           int64_t upTo, int limit,
+                                                           std::pmr::vector<int64_t>& sequences,
+                                                           std::pmr::memory_resource* resource) {
+    TransactionBatch transactions(resource);
+    transactions.reserve(static_cast<size_t>(std::max(limit, 0)));
+    sequences.clear();
+    
+    // Same shape as findByUserId, as forward range scans on the
+    // (user, change_seq) indexes
+    const std::string sql = R"(
+        SELECT id, from_account_id, to_account_id, amount, transaction_type, description, status,
+               created_at, from_balance_after, to_balance_after, change_seq
+        FROM transactions WHERE id IN (
+            SELECT id FROM (
+                SELECT id FROM transactions
+                WHERE from_user_id = ?1 AND change_seq > ?2 AND change_seq <= ?3
+                ORDER BY change_seq LIMIT ?4)
+            UNION
+            SELECT id FROM (
+                SELECT id FROM transactions
+                WHERE to_user_id = ?1 AND change_seq > ?2 AND change_seq <= ?3
+                ORDER BY change_seq LIMIT ?4)
+        )
+        ORDER BY change_seq LIMIT ?4
+    )";
+    
+    auto stmt = snapshot.prepare(sql);
     if (!stmt) {
         return transactions;
     }
     
     sqlite3_bind_int(stmt.get(), 1, userId);
-    sqlite3_bind_int(stmt.get(), 2, userId);
+    sqlite3_bind_int64(stmt.get(), 2, since);
+    sqlite3_bind_int64(stmt.get(), 3, upTo);
+    sqlite3_bind_int(stmt.get(), 4, limit);
     
     while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        transactions.push_back(transactionFromStatement(stmt.get()));
+        transactions.push_back(transactionFromStatement(RowView(stmt.get())));
+        sequences.push_back(sqlite3_column_int64(stmt.get(), 10));
     }
     
     return transactions;
 }
 
+int64_t TransactionRepository::latestChangeSequence(ReadSnapshot& snapshot) {
+    auto stmt = snapshot.prepare("SELECT value FROM change_sequence WHERE id = 1");
+    if (!stmt || sqlite3_step(stmt.get()) != SQLITE_ROW) {
+        return 0;
+    }
+    return sqlite3_column_int64(stmt.get(), 0);
+}
+
 std::vector<Transaction> TransactionRepository::findAll() {
     std::vector<Transaction> transactions;
     const std::string sql = "SELECT id, from_account_id, to_account_id, amount, "
-                           "transaction_type, description, status, created_at "
+                           "transaction_type, description, status, created_at, from_balance_after, to_balance_after "
                            "FROM transactions ORDER BY created_at DESC";
     
-    db_->query(sql, [&transactions, this](sqlite3_stmt* stmt) {
-        transactions.push_back(transactionFromStatement(stmt));
+    db_->query(sql, [&transactions](sqlite3_stmt* stmt) {
+        transactions.push_back(transactionFromStatement(RowView(stmt)));
     });
     
     return transactions;
 }
 
-std::vector<Transaction> TransactionRepository::findWithFilters(
+TransactionBatch TransactionRepository::findWithFilters(
+    ReadSnapshot& snapshot,
     std::optional<int> accountId,
     std::optional<TransactionType> type,
     std::optional<std::string> startDate,
     std::optional<std::string> endDate,
     int limit,
-    int offset) {
+    int offset,
+    std::pmr::memory_resource* resource) {
     
-    std::vector<Transaction> transactions;
+    TransactionBatch transactions(resource);
+    transactions.reserve(static_cast<size_t>(std::max(limit, 0)));
     std::stringstream sql;
     sql << "SELECT id, from_account_id, to_account_id, amount, "
-        << "transaction_type, description, status, created_at "
+        << "transaction_type, description, status, created_at, from_balance_after, to_balance_after "
         << "FROM transactions WHERE 1=1";
     
     // Build dynamic WHERE clause
@@ -152,7 +389,7 @@ std::vector<Transaction> TransactionRepository::findWithFilters(
     }
     
     if (type.has_value()) {
-        sql << " AND transaction_type = '" << transactionTypeToString(type.value()) << "'";
+        sql << " AND transaction_type = " << kTransactionTypeCodec.code(type.value());
     }
     
     if (startDate.has_value()) {
@@ -166,9 +403,14 @@ std::vector<Transaction> TransactionRepository::findWithFilters(
     sql << " ORDER BY created_at DESC";
     sql << " LIMIT " << limit << " OFFSET " << offset;
     
-    db_->query(sql.str(), [&transactions, this](sqlite3_stmt* stmt) {
-        transactions.push_back(transactionFromStatement(stmt));
-    });
+    auto stmt = snapshot.prepare(sql.str());
+    if (!stmt) {
+        return transactions;
+    }
+    
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        transactions.push_back(transactionFromStatement(RowView(stmt.get())));
+    }
     
     return transactions;
 }
@@ -181,13 +423,122 @@ bool TransactionRepository::updateStatus(int id, TransactionStatus status) {
         return false;
     }
     
-    sqlite3_bind_text(stmt.get(), 1, transactionStatusToString(status).c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 1, kTransactionStatusCodec.code(status));
     sqlite3_bind_int(stmt.get(), 2, id);
     
     return sqlite3_step(stmt.get()) == SQLITE_DONE;
 }
 
-int TransactionRepository::getTransactionCount(std::optional<int> accountId) {
+std::optional<double> TransactionRepository::findBalanceAt(int accountId, const std::string& timestamp) {
+    // Newest movement at or before the timestamp, on either side of the
+    // account. Each branch is one backward seek on an (account, created_at) index.
+    const std::string atOrBeforeSql = R"(
+        SELECT balance_after, created_at, id FROM (
+            SELECT from_balance_after AS balance_after, created_at, id FROM transactions
+            WHERE from_account_id = ?1 AND created_at <= ?2 AND from_balance_after IS NOT NULL
+            ORDER BY created_at DESC, id DESC LIMIT 1)
+        UNION ALL
+        SELECT balance_after, created_at, id FROM (
+            SELECT to_balance_after AS balance_after, created_at, id FROM transactions
+            WHERE to_account_id = ?1 AND created_at <= ?2 AND to_balance_after IS NOT NULL
+            ORDER BY created_at DESC, id DESC LIMIT 1)
+        ORDER BY 2 DESC, 3 DESC LIMIT 1
+    )";
+    
+    // Otherwise the oldest movement after it, wound back by its own amount
+    const std::string afterSql = R"(
+        SELECT balance_before, created_at, id FROM (
+            SELECT from_balance_after + amount AS balance_before, created_at, id FROM transactions
+            WHERE from_account_id = ?1 AND created_at > ?2 AND from_balance_after IS NOT NULL
+            ORDER BY created_at, id LIMIT 1)
+        UNION ALL
+        SELECT balance_before, created_at, id FROM (
+            SELECT to_balance_after - amount AS balance_before, created_at, id FROM transactions
+            WHERE to_account_id = ?1 AND created_at > ?2 AND to_balance_after IS NOT NULL
+            ORDER BY created_at, id LIMIT 1)
+        ORDER BY 2, 3 LIMIT 1
+    )";
+    
+    for (const std::string* sql : { &atOrBeforeSql, &afterSql }) {
+        auto stmt = db_->prepare(*sql);
+        if (!stmt) {
+            return std::nullopt;
+        }
+        
+        sqlite3_bind_int(stmt.get(), 1, accountId);
+        sqlite3_bind_text(stmt.get(), 2, timestamp.c_str(), -1, SQLITE_TRANSIENT);
+        
+        if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+            return AccountUtils::roundToTwoDecimals(sqlite3_column_double(stmt.get(), 0));
+        }
+    }
+    
+    return std::nullopt;
+}
+
+bool TransactionRepository::rebuildBalancesAfter(int accountId) {
+    auto balanceStmt = db_->prepare("SELECT balance FROM accounts WHERE id = ?");
+    if (!balanceStmt) {
+        return false;
+    }
+    
+    sqlite3_bind_int(balanceStmt.get(), 1, accountId);
+    if (sqlite3_step(balanceStmt.get()) != SQLITE_ROW) {
+        return false;
+    }
+    int64_t balanceCents = AccountUtils::toCents(sqlite3_column_double(balanceStmt.get(), 0));
+    balanceStmt.reset();
+    
+    // Newest first: each row's balance-after is the current balance minus
+    // everything that happened after it
+    const std::string sql = "SELECT id, from_account_id = ?1, amount FROM transactions "
+                           "WHERE (from_account_id = ?1 OR to_account_id = ?1) AND status = ?2 "
+                           "ORDER BY created_at DESC, id DESC";
+    auto stmt = db_->prepare(sql);
+    auto fromStmt = db_->prepare("UPDATE transactions SET from_balance_after = ? WHERE id = ?");
+    auto toStmt = db_->prepare("UPDATE transactions SET to_balance_after = ? WHERE id = ?");
+    if (!stmt || !fromStmt || !toStmt) {
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt.get(), 1, accountId);
+    sqlite3_bind_int(stmt.get(), 2, kTransactionStatusCodec.code(TransactionStatus::Completed));
+    
+    // Collect first so the updates never run under an open cursor on the same rows
+    struct Movement {
+        int id;
+        bool debit;
+        int64_t amountCents;
+    };
+    std::vector<Movement> movements;
+    int rc;
+    while ((rc = sqlite3_step(stmt.get())) == SQLITE_ROW) {
+        movements.push_back({ sqlite3_column_int(stmt.get(), 0),
+                              sqlite3_column_int(stmt.get(), 1) != 0,
+                              AccountUtils::toCents(sqlite3_column_double(stmt.get(), 2)) });
+    }
+    if (rc != SQLITE_DONE) {
+        return false;
+    }
+    stmt.reset();
+    
+    for (const auto& movement : movements) {
+        sqlite3_stmt* update = movement.debit ? fromStmt.get() : toStmt.get();
+        sqlite3_bind_double(update, 1, AccountUtils::fromCents(balanceCents));
+        sqlite3_bind_int(update, 2, movement.id);
+        if (sqlite3_step(update) != SQLITE_DONE) {
+            LOG_ERROR("Failed to update balance after", "account_id", accountId, "error", db_->getLastError());
+            return false;
+        }
+        sqlite3_reset(update);
+        
+        balanceCents += movement.debit ? movement.amountCents : -movement.amountCents;
+    }
+    
+    return true;
+}
+
+int TransactionRepository::getTransactionCount(ReadSnapshot& snapshot, std::optional<int> accountId) {
     std::stringstream sql;
     sql << "SELECT COUNT(*) FROM transactions WHERE 1=1";
     
@@ -196,7 +547,7 @@ int TransactionRepository::getTransactionCount(std::optional<int> accountId) {
             << " OR to_account_id = " << accountId.value() << ")";
     }
     
-    auto stmt = db_->prepare(sql.str());
+    auto stmt = snapshot.prepare(sql.str());
     if (!stmt) {
         return 0;
     }
@@ -208,29 +559,32 @@ int TransactionRepository::getTransactionCount(std::optional<int> accountId) {
     return 0;
 }
 
-Transaction TransactionRepository::transactionFromStatement(sqlite3_stmt* stmt) {
-    int id = sqlite3_column_int(stmt, 0);
-    
-    // Handle nullable from_account_id
-    std::optional<int> fromAccountId;
-    if (sqlite3_column_type(stmt, 1) != SQLITE_NULL) {
-        fromAccountId = sqlite3_column_int(stmt, 1);
+Transaction TransactionRepository::transactionFromStatement(const RowView& row) {
+    Transaction transaction(row.getInt(0), row.getOptionalInt(1), row.getOptionalInt(2),
+                            row.getDouble(3),
+                            transactionTypeFromCode(row.getInt(4)),
+                            row.getText(5),
+                            transactionStatusFromCode(row.getInt(6)),
+                            row.getText(7));
+    
+    // Rows written before balances were recorded, or by imports, have none
+    if (row.columnCount() > 9) {
+        transaction.setBalancesAfter(row.getOptionalDouble(8), row.getOptionalDouble(9));
     }
     
-    // Handle nullable to_account_id
-    std::optional<int> toAccountId;
-    if (sqlite3_column_type(stmt, 2) != SQLITE_NULL) {
-        toAccountId = sqlite3_column_int(stmt, 2);
+    return transaction;
+}
+
+void TransactionRepository::bindBalancesAfter(sqlite3_stmt* stmt, int index, const Transaction& transaction) {
+    if (transaction.getFromBalanceAfter().has_value()) {
+        sqlite3_bind_double(stmt, index, transaction.getFromBalanceAfter().value());
+    } else {
+        sqlite3_bind_null(stmt, index);
     }
     
-    double amount = sqlite3_column_double(stmt, 3);
-    std::string typeStr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
-    std::string description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
-    std::string statusStr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
-    std::string createdAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
-    
-    TransactionType type = stringToTransactionType(typeStr);
-    TransactionStatus status = stringToTransactionStatus(statusStr);
-    
-    return Transaction(id, fromAccountId, toAccountId, amount, type, description, status, createdAt);
+    if (transaction.getToBalanceAfter().has_value()) {
+        sqlite3_bind_double(stmt, index + 1, transaction.getToBalanceAfter().value());
+    } else {
+        sqlite3_bind_null(stmt, index + 1);
+    }
 }
@@ -2,6 +2,7 @@
 
 #include "repository/transaction/transaction_repository_interface.h"
 #include "db/db.h"
+#include "db/row_view.h"
 #include <memory>
 
 class TransactionRepository : public ITransactionRepository {
@@ -10,24 +11,46 @@ public:
     
     // ITransactionRepository implementation
     std::optional<Transaction> create(const Transaction& transaction) override;
+    std::optional<std::vector<int>> createBatch(const std::vector<Transaction>& transactions,
+                                                bool keepCreatedAt = false) override;
     std::optional<Transaction> findById(int id) override;
+    std::vector<Transaction> findByIds(ReadSnapshot& snapshot, const std::vector<int>& ids) override;
     std::vector<Transaction> findByAccountId(int accountId) override;
-    std::vector<Transaction> findByUserId(int userId) override;
+    TransactionBatch findByUserId(ReadSnapshot& snapshot, int userId, int limit,
+                                 const std::optional<TransactionCursor>& after = std::nullopt,
+                                 std::pmr::memory_resource* resource = std::pmr::get_default_resource()) override;
+    int countByUserId(ReadSnapshot& snapshot, int userId) override;
+    TransactionBatch findChangedByUserId(ReadSnapshot& snapshot, int userId, int64_t since, int64_t upTo,
+                                        int limit, std::pmr::vector<int64_t>& sequences,
+                                        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) override;
+    int64_t latestChangeSequence(ReadSnapshot& snapshot) override;
     std::vector<Transaction> findAll() override;
-    std::vector<Transaction> findWithFilters(
+    TransactionBatch findWithFilters(
+        ReadSnapshot& snapshot,
         std::optional<int> accountId,
         std::optional<TransactionType> type,
         std::optional<std::string> startDate,
         std::optional<std::string> endDate,
         int limit = 100,
-        int offset = 0
+        int offset = 0,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) override;
     bool updateStatus(int id, TransactionStatus status) override;
-    int getTransactionCount(std::optional<int> accountId = std::nullopt) override;
+    std::optional<double> findBalanceAt(int accountId, const std::string& timestamp) override;
+    bool rebuildBalancesAfter(int accountId) override;
+    int getTransactionCount(ReadSnapshot& snapshot, std::optional<int> accountId = std::nullopt) override;
     
 private:
     std::shared_ptr<Database> db_;
     
+    // Rows per multi-row INSERT in createBatch (at most 9 parameters each,
+    // well below SQLite's bound parameter limit)
+    static constexpr size_t kRowsPerInsert = 100;
+    static std::string multiRowInsertSql(size_t rows, bool withCreatedAt);
+    
     // Helper method to create Transaction from query result
-    Transaction transactionFromStatement(sqlite3_stmt* stmt);
+    static Transaction transactionFromStatement(const RowView& row);
+    
+    // Bind from/to balance-after (nullable) at index and index + 1
+    static void bindBalancesAfter(sqlite3_stmt* stmt, int index, const Transaction& transaction);
 };
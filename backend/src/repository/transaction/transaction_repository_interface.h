@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <optional>
 #include "domain/transaction/transaction.h"
+#include "domain/transaction/transaction_batch.h"
+#include "domain/transaction/transaction_cursor.h"
+
+class ReadSnapshot;
 
 class ITransactionRepository {
 public:
@@ -12,31 +18,72 @@ public:
     // Create a new transaction
     virtual std::optional<Transaction> create(const Transaction& transaction) = 0;
     
+    // Insert several transactions with multi-row statements; returns their
+    // IDs in input order, or nullopt if any insert failed. With keepCreatedAt
+    // each row's createdAt is stored instead of the current time (imports).
+    virtual std::optional<std::vector<int>> createBatch(const std::vector<Transaction>& transactions,
+                                                        bool keepCreatedAt = false) = 0;
+    
     // Find transaction by ID
     virtual std::optional<Transaction> findById(int id) = 0;
     
+    // Find several transactions by ID as committed in the snapshot (missing
+    // IDs are omitted)
+    virtual std::vector<Transaction> findByIds(ReadSnapshot& snapshot, const std::vector<int>& ids) = 0;
+    
     // Find all transactions for an account
     virtual std::vector<Transaction> findByAccountId(int accountId) = 0;
     
-    // Find all transactions for a user (across all their accounts)
-    virtual std::vector<Transaction> findByUserId(int userId) = 0;
+    // One page of a user's transactions across all their accounts, newest
+    // first, starting after the cursor (from the newest when absent), as
+    // committed in the snapshot. The batch is allocated from resource.
+    virtual TransactionBatch findByUserId(ReadSnapshot& snapshot, int userId, int limit,
+                                         const std::optional<TransactionCursor>& after = std::nullopt,
+                                         std::pmr::memory_resource* resource = std::pmr::get_default_resource()) = 0;
+    
+    // Number of transactions touching any of a user's accounts, as committed
+    // in the snapshot
+    virtual int countByUserId(ReadSnapshot& snapshot, int userId) = 0;
+    
+    // A user's transactions whose change sequence is in (since, upTo], in
+    // sequence order, at most limit; sequences receives each row's value.
+    // Read from the snapshot, so only committed rows are seen. The batch is
+    // allocated from resource.
+    virtual TransactionBatch findChangedByUserId(ReadSnapshot& snapshot, int userId, int64_t since, int64_t upTo,
+                                                int limit, std::pmr::vector<int64_t>& sequences,
+                                                std::pmr::memory_resource* resource = std::pmr::get_default_resource()) = 0;
+    
+    // Highest change sequence committed as of the snapshot (shared with
+    // accounts)
+    virtual int64_t latestChangeSequence(ReadSnapshot& snapshot) = 0;
     
     // Find all transactions (admin only)
     virtual std::vector<Transaction> findAll() = 0;
     
-    // Find transactions with filters
-    virtual std::vector<Transaction> findWithFilters(
+    // Find transactions with filters as committed in the snapshot; the batch
+    // is allocated from resource
+    virtual TransactionBatch findWithFilters(
+        ReadSnapshot& snapshot,
         std::optional<int> accountId,
         std::optional<TransactionType> type,
         std::optional<std::string> startDate,
         std::optional<std::string> endDate,
         int limit = 100,
-        int offset = 0
+        int offset = 0,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) = 0;
     
     // Update transaction status
     virtual bool updateStatus(int id, TransactionStatus status) = 0;
     
-    // Get transaction count for pagination
-    virtual int getTransactionCount(std::optional<int> accountId = std::nullopt) = 0;
+    // Balance of an account as of a timestamp, read from the balance-after
+    // columns; nullopt when no recorded movement brackets the timestamp
+    virtual std::optional<double> findBalanceAt(int accountId, const std::string& timestamp) = 0;
+    
+    // Recompute an account's balance-after values from its current balance,
+    // walking completed rows back from the newest (after importing history)
+    virtual bool rebuildBalancesAfter(int accountId) = 0;
+    
+    // Get transaction count for pagination, as committed in the snapshot
+    virtual int getTransactionCount(ReadSnapshot& snapshot, std::optional<int> accountId = std::nullopt) = 0;
 };
@@ -1,11 +1,11 @@
 #include "repository/user/user_repository.h"
-#include <iostream>
+#include "logging/logger.h"
 
 UserRepository::UserRepository(std::shared_ptr<Database> db) : db_(db) {}
 
 std::optional<User> UserRepository::create(const User& user) {
     if (!user.isValid()) {
-        std::cerr << "Invalid user: " << user.getValidationError() << std::endl;
+        LOG_WARN("Invalid user", "reason", user.getValidationError());
         return std::nullopt;
     }
     
@@ -18,10 +18,10 @@ std::optional<User> UserRepository::create(const User& user) {
     
     sqlite3_bind_text(stmt.get(), 1, user.getUsername().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt.get(), 2, user.getPinHash().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt.get(), 3, userTypeToString(user.getUserType()).c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 3, kUserTypeCodec.code(user.getUserType()));
     
     if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
-        std::cerr << "Failed to create user: " << db_->getLastError() << std::endl;
+        LOG_ERROR("Failed to create user", "error", db_->getLastError());
         return std::nullopt;
     }
     
@@ -40,7 +40,7 @@ std::optional<User> UserRepository::findById(int id) {
     sqlite3_bind_int(stmt.get(), 1, id);
     
     if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        return userFromStatement(stmt.get());
+        return userFromStatement(RowView(stmt.get()));
     }
     
     return std::nullopt;
@@ -57,7 +57,7 @@ std::optional<User> UserRepository::findByUsername(const std::string& username)
     sqlite3_bind_text(stmt.get(), 1, username.c_str(), -1, SQLITE_TRANSIENT);
     
     if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-        return userFromStatement(stmt.get());
+        return userFromStatement(RowView(stmt.get()));
     }
     
     return std::nullopt;
@@ -67,8 +67,8 @@ std::vector<User> UserRepository::findAll() {
     std::vector<User> users;
     const std::string sql = "SELECT id, username, pin_hash, user_type, created_at, updated_at FROM users ORDER BY id";
     
-    db_->query(sql, [&users, this](sqlite3_stmt* stmt) {
-        users.push_back(userFromStatement(stmt));
+    db_->query(sql, [&users](sqlite3_stmt* stmt) {
+        users.push_back(userFromStatement(RowView(stmt)));
     });
     
     return users;
@@ -87,7 +87,7 @@ bool UserRepository::update(const User& user) {
     }
     
     sqlite3_bind_text(stmt.get(), 1, user.getPinHash().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt.get(), 2, userTypeToString(user.getUserType()).c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 2, kUserTypeCodec.code(user.getUserType()));
     sqlite3_bind_int(stmt.get(), 3, user.getId());
     
     return sqlite3_step(stmt.get()) == SQLITE_DONE;
@@ -122,15 +122,8 @@ bool UserRepository::existsByUsername(const std::string& username) {
     return false;
 }
 
-User UserRepository::userFromStatement(sqlite3_stmt* stmt) {
-    int id = sqlite3_column_int(stmt, 0);
-    std::string username = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-    std::string pinHash = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-    std::string userTypeStr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
-    std::string createdAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
-    std::string updatedAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
-    
-    UserType userType = stringToUserType(userTypeStr);
-    
-    return User(id, username, pinHash, userType, createdAt, updatedAt);
+User UserRepository::userFromStatement(const RowView& row) {
+    // The strings are the user's own copies, moved into place
+    return User(row.getInt(0), row.getString(1), row.getString(2),
+                userTypeFromCode(row.getInt(3)), row.getString(4), row.getString(5));
 }
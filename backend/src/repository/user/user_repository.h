@@ -2,6 +2,7 @@
 
 #include "repository/user/user_repository_interface.h"
 #include "db/db.h"
+#include "db/row_view.h"
 #include <memory>
 
 class UserRepository : public IUserRepository {
@@ -21,5 +22,5 @@ private:
     std::shared_ptr<Database> db_;
     
     // Helper method to create User from query result
-    User userFromStatement(sqlite3_stmt* stmt);
+    static User userFromStatement(const RowView& row);
 };
@@ -0,0 +1,565 @@
+// NovaBank synthetic dataset generator
+//
+// Bulk-loads users, accounts and a large transaction ledger into a NovaBank
+// SQLite database for scale testing. Activity is skewed the way real ledgers
+// are: a Zipf distribution over accounts produces a handful of very hot
+// accounts and a long tail of quiet ones, and transactions are spread over a
+// multi-year window in chronological order.
+//
+// Output is a pure function of the flags: the same --seed and --end-date
+// always produce the same rows. Balances are tracked while generating, so no
+// withdrawal ever overdraws an account, and each ledger batch commits with
+// the balances of the accounts it moved: a run that stops part way leaves
+// balances that equal the ledger written so far.
+//
+// Usage:
+//   novabank_datagen [--db novabank.db] [--seed 42] [--users 10000]
+//                    [--transactions 1000000] [--years 3] [--end-date YYYY-MM-DD]
+//                    [--zipf 1.1] [--batch 100000]
+
+#include "db/db.h"
+#include "domain/account/account_number.h"
+#include "domain/account/account_type.h"
+#include "domain/transaction/transaction_status.h"
+#include "domain/user/user_type.h"
+#include "domain/user/user_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+struct DatagenOptions {
+    std::string dbPath = "novabank.db";
+    uint64_t seed = 42;
+    int users = 10000;
+    int64_t transactions = 1000000;
+    int years = 3;
+    std::string endDate;        // defaults to today (UTC)
+    double zipfExponent = 1.1;
+    int batchSize = 100000;
+};
+
+// xoshiro256** seeded through splitmix64. Implemented here rather than using
+// <random> distributions so the generated data is identical across standard
+// library implementations.
+class DeterministicRng {
+public:
+    explicit DeterministicRng(uint64_t seed) {
+        for (auto& word : state_) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // Uniform double in [0, 1)
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    // Uniform integer in [0, bound)
+    uint64_t below(uint64_t bound) {
+        return static_cast<uint64_t>(uniform() * static_cast<double>(bound));
+    }
+
+    double normal() {
+        double u1 = std::max(uniform(), 1e-300);
+        double u2 = uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+    }
+
+private:
+    uint64_t state_[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+// Inverse-CDF Zipf sampler over [0, n). Ranks are mapped through a random
+// permutation so the hot accounts are scattered across the id space.
+class ZipfSampler {
+public:
+    ZipfSampler(size_t n, double exponent, DeterministicRng& rng) : cdf_(n), rankToIndex_(n) {
+        double total = 0.0;
+        for (size_t rank = 0; rank < n; ++rank) {
+            total += 1.0 / std::pow(static_cast<double>(rank + 1), exponent);
+            cdf_[rank] = total;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            rankToIndex_[i] = i;
+        }
+        for (size_t i = n; i > 1; --i) {
+            std::swap(rankToIndex_[i - 1], rankToIndex_[rng.below(i)]);
+        }
+    }
+
+    size_t sample(DeterministicRng& rng) const {
+        double target = rng.uniform() * cdf_.back();
+        size_t rank = static_cast<size_t>(std::upper_bound(cdf_.begin(), cdf_.end(), target) - cdf_.begin());
+        return rankToIndex_[std::min(rank, cdf_.size() - 1)];
+    }
+
+private:
+    std::vector<double> cdf_;
+    std::vector<size_t> rankToIndex_;
+};
+
+struct GeneratedAccount {
+    int id = 0;
+    bool savings = false;
+    int64_t balanceCents = 0;
+};
+
+const char* const kDepositDescriptions[] = { "Salary", "Cash deposit", "Refund", "Check deposit", "Interest" };
+const char* const kWithdrawalDescriptions[] = { "ATM withdrawal", "Groceries", "Utilities", "Card payment", "Rent" };
+const char* const kTransferDescriptions[] = { "Transfer", "Rent share", "Savings", "Loan repayment", "Gift" };
+
+constexpr int64_t kMinSavingsBalanceCents = 2500;
+
+void printUsage() {
+    std::cerr << "Usage: novabank_datagen [--db PATH] [--seed N] [--users N] [--transactions N]\n"
+              << "                        [--years N] [--end-date YYYY-MM-DD] [--zipf S] [--batch N]" << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], DatagenOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--db") {
+            options.dbPath = value;
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--users") {
+            options.users = std::atoi(value.c_str());
+        } else if (arg == "--transactions") {
+            options.transactions = std::atoll(value.c_str());
+        } else if (arg == "--years") {
+            options.years = std::atoi(value.c_str());
+        } else if (arg == "--end-date") {
+            options.endDate = value;
+        } else if (arg == "--zipf") {
+            options.zipfExponent = std::atof(value.c_str());
+        } else if (arg == "--batch") {
+            options.batchSize = std::atoi(value.c_str());
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return options.users > 0 && options.transactions >= 0 && options.years > 0 && options.batchSize > 0;
+}
+
+// Parse YYYY-MM-DD as midnight UTC
+bool parseDate(const std::string& date, time_t& out) {
+    std::tm tm{};
+    if (std::sscanf(date.c_str(), "%d-%d-%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday) != 3) {
+        return false;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    out = timegm(&tm);
+    return true;
+}
+
+void formatTimestamp(time_t t, char* buffer, size_t size) {
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    std::strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &tm);
+}
+
+bool step(Database& db, sqlite3_stmt* stmt) {
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Insert failed: " << db.getLastError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Indexes dropped for the ledger load. They are put back on every way out
+// of main: a failed run would otherwise leave the table without them, and
+// the seed check refuses to run the same load again.
+class DeferredIndexes {
+public:
+    DeferredIndexes(Database& db, const std::string& table)
+        : db_(db), statements_(db.dropIndexes(table)) {}
+
+    ~DeferredIndexes() {
+        restore();
+    }
+
+    DeferredIndexes(const DeferredIndexes&) = delete;
+    DeferredIndexes& operator=(const DeferredIndexes&) = delete;
+
+    bool restore() {
+        if (restored_) {
+            return true;
+        }
+        restored_ = true;
+        return db_.restoreIndexes(statements_);
+    }
+
+private:
+    Database& db_;
+    std::vector<std::string> statements_;
+    bool restored_ = false;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    DatagenOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    if (options.endDate.empty()) {
+        char today[16];
+        time_t now = std::time(nullptr);
+        std::tm tm{};
+        gmtime_r(&now, &tm);
+        std::strftime(today, sizeof(today), "%Y-%m-%d", &tm);
+        options.endDate = today;
+    }
+
+    time_t endTime;
+    if (!parseDate(options.endDate, endTime)) {
+        std::cerr << "Invalid --end-date: " << options.endDate << std::endl;
+        return 1;
+    }
+    time_t startTime = endTime - static_cast<time_t>(options.years) * 365 * 86400;
+
+    std::cout << "🏦 NovaBank dataset generator: seed=" << options.seed << " users=" << options.users
+              << " transactions=" << options.transactions << " years=" << options.years
+              << " end-date=" << options.endDate << " zipf=" << options.zipfExponent << std::endl;
+
+    std::unique_ptr<Database> dbPtr;
+    try {
+        dbPtr = std::make_unique<Database>(options.dbPath);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Failed to open database: " << e.what() << std::endl;
+        return 1;
+    }
+    Database& db = *dbPtr;
+
+    std::string userPrefix = "seed" + std::to_string(options.seed) + "_u";
+    bool alreadyGenerated = false;
+    db.query("SELECT 1 FROM users WHERE username = '" + userPrefix + "0' LIMIT 1",
+             [&alreadyGenerated](sqlite3_stmt*) { alreadyGenerated = true; });
+    if (alreadyGenerated) {
+        std::cerr << "❌ This database already contains data for seed " << options.seed << std::endl;
+        return 1;
+    }
+
+    // Trade durability for load speed: a crashed process keeps every
+    // committed batch, an OS crash may lose the latest ones
+    db.execute("PRAGMA synchronous = OFF");
+    db.execute("PRAGMA temp_store = MEMORY");
+    db.execute("PRAGMA cache_size = -262144");
+
+    DeterministicRng rng(options.seed);
+    auto started = std::chrono::steady_clock::now();
+
+    std::unordered_set<std::string> usedNumbers;
+    db.query("SELECT account_number FROM accounts", [&usedNumbers](sqlite3_stmt* stmt) {
+        usedNumbers.insert(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+    });
+
+    // Account numbers continue the database's allocator sequence. On a fresh
+    // database the permutation key is derived from the seed instead of the
+    // random one, so the numbers are reproducible too.
+    {
+        auto keyStmt = db.prepare("UPDATE account_number_allocator SET secret_key = ? "
+                                  "WHERE id = 1 AND next_sequence = 0");
+        if (!keyStmt) {
+            return 1;
+        }
+        sqlite3_bind_int64(keyStmt.get(), 1, static_cast<int64_t>(DeterministicRng(options.seed ^ 0xacc0u).next()));
+        if (!step(db, keyStmt.get())) {
+            return 1;
+        }
+    }
+    int64_t nextSequence = 0;
+    uint64_t numberKey = 0;
+    db.query("SELECT next_sequence, secret_key FROM account_number_allocator WHERE id = 1",
+             [&nextSequence, &numberKey](sqlite3_stmt* stmt) {
+        nextSequence = sqlite3_column_int64(stmt, 0);
+        numberKey = static_cast<uint64_t>(sqlite3_column_int64(stmt, 1));
+    });
+
+    // Users and accounts
+    std::vector<GeneratedAccount> accounts;
+    {
+        std::string pinHash = UserUtils::hashPin("1234");
+        char createdAt[32];
+        formatTimestamp(startTime, createdAt, sizeof(createdAt));
+
+        auto userStmt = db.prepare("INSERT INTO users (username, pin_hash, user_type, created_at, updated_at) "
+                                   "VALUES (?, ?, ?, ?, ?)");
+        auto accountStmt = db.prepare("INSERT INTO accounts (user_id, account_number, account_type, balance, "
+                                      "created_at, updated_at) VALUES (?, ?, ?, 0.0, ?, ?)");
+        if (!userStmt || !accountStmt || !db.beginTransaction()) {
+            return 1;
+        }
+
+        for (int u = 0; u < options.users; ++u) {
+            std::string username = userPrefix + std::to_string(u);
+            sqlite3_bind_text(userStmt.get(), 1, username.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(userStmt.get(), 2, pinHash.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(userStmt.get(), 3, kUserTypeCodec.code(UserType::Standard));
+            sqlite3_bind_text(userStmt.get(), 4, createdAt, -1, SQLITE_STATIC);
+            sqlite3_bind_text(userStmt.get(), 5, createdAt, -1, SQLITE_STATIC);
+            if (!step(db, userStmt.get())) {
+                db.rollback();
+                return 1;
+            }
+            int userId = static_cast<int>(db.getLastInsertId());
+
+            // 60% one account, 30% two, 10% three
+            double roll = rng.uniform();
+            int accountCount = roll < 0.6 ? 1 : (roll < 0.9 ? 2 : 3);
+            for (int a = 0; a < accountCount; ++a) {
+                // Existing numbers can only clash if drawn before the allocator
+                std::string number;
+                do {
+                    if (nextSequence >= AccountNumber::kCapacity) {
+                        std::cerr << "Account number space exhausted" << std::endl;
+                        db.rollback();
+                        return 1;
+                    }
+                    number = AccountNumber::fromSequence(static_cast<uint32_t>(nextSequence++), numberKey);
+                } while (!usedNumbers.insert(number).second);
+
+                bool savings = a > 0 && rng.uniform() < 0.7;
+                sqlite3_bind_int(accountStmt.get(), 1, userId);
+                sqlite3_bind_text(accountStmt.get(), 2, number.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(accountStmt.get(), 3, kAccountTypeCodec.code(savings ? AccountType::Savings : AccountType::Checking));
+                sqlite3_bind_text(accountStmt.get(), 4, createdAt, -1, SQLITE_STATIC);
+                sqlite3_bind_text(accountStmt.get(), 5, createdAt, -1, SQLITE_STATIC);
+                if (!step(db, accountStmt.get())) {
+                    db.rollback();
+                    return 1;
+                }
+                accounts.push_back(GeneratedAccount{ static_cast<int>(db.getLastInsertId()), savings, 0 });
+            }
+        }
+
+        auto sequenceStmt = db.prepare("UPDATE account_number_allocator SET next_sequence = ? WHERE id = 1");
+        if (!sequenceStmt) {
+            db.rollback();
+            return 1;
+        }
+        sqlite3_bind_int64(sequenceStmt.get(), 1, nextSequence);
+        if (!step(db, sequenceStmt.get())) {
+            db.rollback();
+            return 1;
+        }
+
+        if (!db.commit()) {
+            return 1;
+        }
+    }
+    std::cout << "👥 Created " << options.users << " users with " << accounts.size() << " accounts" << std::endl;
+
+    // Ledger
+    ZipfSampler sampler(accounts.size(), options.zipfExponent, rng);
+    DeferredIndexes deferredIndexes(db, "transactions");
+
+    auto txStmt = db.prepare("INSERT INTO transactions (from_account_id, to_account_id, amount, "
+                             "transaction_type, description, status, created_at, from_balance_after, "
+                             "to_balance_after, from_user_id, to_user_id) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                             "(SELECT user_id FROM accounts WHERE id = ?1), "
+                             "(SELECT user_id FROM accounts WHERE id = ?2))");
+    auto balanceStmt = db.prepare("UPDATE accounts SET balance = ? WHERE id = ?");
+    if (!txStmt || !balanceStmt) {
+        return 1;
+    }
+
+    // Accounts whose balance moved in the current batch
+    std::vector<GeneratedAccount*> moved;
+    std::vector<bool> isMoved(accounts.size(), false);
+    auto markMoved = [&](GeneratedAccount* account) {
+        size_t index = static_cast<size_t>(account - accounts.data());
+        if (!isMoved[index]) {
+            isMoved[index] = true;
+            moved.push_back(account);
+        }
+    };
+
+    double span = static_cast<double>(endTime - startTime);
+    double stepSeconds = options.transactions > 0 ? span / static_cast<double>(options.transactions) : 0.0;
+    char createdAt[32];
+    int64_t written = 0;
+
+    while (written < options.transactions) {
+        if (!db.beginTransaction()) {
+            return 1;
+        }
+
+        int64_t batchEnd = std::min<int64_t>(written + options.batchSize, options.transactions);
+        for (; written < batchEnd; ++written) {
+            time_t t = startTime + static_cast<time_t>(static_cast<double>(written) * stepSeconds +
+                                                        rng.uniform() * stepSeconds);
+            formatTimestamp(t, createdAt, sizeof(createdAt));
+
+            GeneratedAccount& from = accounts[sampler.sample(rng)];
+            double kind = rng.uniform();
+
+            // Log-normal amounts: deposits are salary-sized, spending is smaller
+            int64_t amountCents;
+            TransactionType type;
+            const char* description;
+            GeneratedAccount* debit = nullptr;
+            GeneratedAccount* credit = nullptr;
+
+            if (kind < 0.30) {
+                amountCents = static_cast<int64_t>(std::exp(10.5 + 0.8 * rng.normal()));
+                type = TransactionType::Deposit;
+                description = kDepositDescriptions[rng.below(5)];
+                credit = &from;
+            } else if (kind < 0.55) {
+                amountCents = static_cast<int64_t>(std::exp(8.5 + 1.0 * rng.normal()));
+                type = TransactionType::Withdrawal;
+                description = kWithdrawalDescriptions[rng.below(5)];
+                debit = &from;
+            } else {
+                amountCents = static_cast<int64_t>(std::exp(9.0 + 1.1 * rng.normal()));
+                type = TransactionType::Transfer;
+                description = kTransferDescriptions[rng.below(5)];
+                debit = &from;
+                credit = &accounts[sampler.sample(rng)];
+                if (credit == debit) {
+                    credit = &accounts[(static_cast<size_t>(credit - accounts.data()) + 1) % accounts.size()];
+                }
+                if (credit == debit) {
+                    credit = nullptr;
+                    type = TransactionType::Withdrawal;
+                }
+            }
+            amountCents = std::max<int64_t>(amountCents, 1);
+
+            // Never overdraw: spending the account cannot afford becomes a deposit
+            if (debit) {
+                int64_t floor = debit->savings ? kMinSavingsBalanceCents : 0;
+                if (debit->balanceCents - amountCents < floor) {
+                    credit = debit;
+                    debit = nullptr;
+                    type = TransactionType::Deposit;
+                    description = kDepositDescriptions[rng.below(5)];
+                }
+            }
+
+            double statusRoll = rng.uniform();
+            TransactionStatus status = statusRoll < 0.005 ? TransactionStatus::Failed
+                                     : (statusRoll < 0.007 ? TransactionStatus::Pending : TransactionStatus::Completed);
+            bool completed = status == TransactionStatus::Completed;
+            if (completed) {
+                if (debit) {
+                    debit->balanceCents -= amountCents;
+                    markMoved(debit);
+                }
+                if (credit) {
+                    credit->balanceCents += amountCents;
+                    markMoved(credit);
+                }
+            }
+
+            sqlite3_stmt* stmt = txStmt.get();
+            if (debit) {
+                sqlite3_bind_int(stmt, 1, debit->id);
+            } else {
+                sqlite3_bind_null(stmt, 1);
+            }
+            if (credit) {
+                sqlite3_bind_int(stmt, 2, credit->id);
+            } else {
+                sqlite3_bind_null(stmt, 2);
+            }
+            sqlite3_bind_double(stmt, 3, static_cast<double>(amountCents) / 100.0);
+            sqlite3_bind_int(stmt, 4, kTransactionTypeCodec.code(type));
+            sqlite3_bind_text(stmt, 5, description, -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt, 6, kTransactionStatusCodec.code(status));
+            sqlite3_bind_text(stmt, 7, createdAt, -1, SQLITE_TRANSIENT);
+
+            // Rows are generated in time order, so running balances are exact
+            if (completed && debit) {
+                sqlite3_bind_double(stmt, 8, static_cast<double>(debit->balanceCents) / 100.0);
+            } else {
+                sqlite3_bind_null(stmt, 8);
+            }
+            if (completed && credit) {
+                sqlite3_bind_double(stmt, 9, static_cast<double>(credit->balanceCents) / 100.0);
+            } else {
+                sqlite3_bind_null(stmt, 9);
+            }
+
+            if (!step(db, stmt)) {
+                db.rollback();
+                return 1;
+            }
+        }
+
+        // Balances commit with the rows that moved them
+        for (GeneratedAccount* account : moved) {
+            sqlite3_bind_double(balanceStmt.get(), 1, static_cast<double>(account->balanceCents) / 100.0);
+            sqlite3_bind_int(balanceStmt.get(), 2, account->id);
+            if (!step(db, balanceStmt.get())) {
+                db.rollback();
+                return 1;
+            }
+            isMoved[static_cast<size_t>(account - accounts.data())] = false;
+        }
+        moved.clear();
+
+        if (!db.commit()) {
+            db.rollback();
+            return 1;
+        }
+        std::cout << "\r💸 " << written << " / " << options.transactions << " transactions" << std::flush;
+    }
+    std::cout << std::endl;
+
+    std::cout << "🗂️  Rebuilding transaction indexes..." << std::endl;
+    if (!deferredIndexes.restore()) {
+        std::cerr << "❌ Failed to rebuild indexes" << std::endl;
+        return 1;
+    }
+
+    db.execute("ANALYZE");
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "✅ Done in " << elapsed << "s ("
+              << static_cast<int64_t>(static_cast<double>(options.transactions) / std::max(elapsed, 1e-9))
+              << " transactions/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,127 @@
+// NovaBank historical transaction importer
+//
+// Streams a CSV or NDJSON file of legacy transactions into a NovaBank SQLite
+// database. Rows are validated, inserted in large batched DB transactions
+// with the transaction indexes dropped for the duration of the load, and
+// account balances are moved by each account's net imported amount. See
+// TransactionImporter for the accepted columns. Indexes left dropped by an
+// interrupted run are rebuilt the next time the database is opened; use
+// --keep-indexes when a server is running against the same file.
+//
+// Usage:
+//   novabank_import [--db novabank.db] [--format csv|ndjson] [--batch 100000]
+//                   [--keep-indexes] FILE|-
+
+#include "db/db.h"
+#include "repository/transaction/transaction_importer.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct ImportCliOptions {
+    std::string dbPath = "novabank.db";
+    std::string inputPath;
+    ImportOptions import;
+};
+
+void printUsage() {
+    std::cerr << "Usage: novabank_import [--db PATH] [--format csv|ndjson] [--batch N]\n"
+              << "                       [--keep-indexes] FILE|-" << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], ImportCliOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (arg == "--keep-indexes") {
+            options.import.deferIndexes = false;
+            continue;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            options.inputPath = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--db") {
+            options.dbPath = value;
+        } else if (arg == "--format") {
+            auto format = stringToTransactionFileFormat(value);
+            if (!format) {
+                std::cerr << "Unknown format: " << value << std::endl;
+                return false;
+            }
+            options.import.format = *format;
+        } else if (arg == "--batch") {
+            options.import.batchSize = static_cast<size_t>(std::atol(value.c_str()));
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return !options.inputPath.empty() && options.import.batchSize > 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    ImportCliOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::ifstream file;
+    if (options.inputPath != "-") {
+        file.open(options.inputPath, std::ios::binary);
+        if (!file) {
+            std::cerr << "❌ Cannot open " << options.inputPath << std::endl;
+            return 1;
+        }
+    }
+    std::istream& input = options.inputPath == "-" ? std::cin : file;
+
+    std::shared_ptr<Database> db;
+    try {
+        db = std::make_shared<Database>(options.dbPath);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Failed to open database: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "📥 Importing " << options.inputPath << " into " << options.dbPath << std::endl;
+    auto start = std::chrono::steady_clock::now();
+
+    TransactionImporter importer(db, options.import);
+    ImportResult result = importer.run(input);
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& rejection : result.rejections) {
+        std::cerr << "⚠️  " << rejection << std::endl;
+    }
+    if (result.rowsRejected > result.rejections.size()) {
+        std::cerr << "⚠️  ... and " << (result.rowsRejected - result.rejections.size()) << " more rejected rows" << std::endl;
+    }
+
+    std::cout << "📊 Read " << result.rowsRead << " rows, imported " << result.rowsImported
+              << ", rejected " << result.rowsRejected << ", updated " << result.accountsUpdated << " accounts" << std::endl;
+
+    if (!result.success) {
+        std::cerr << "❌ " << result.error << std::endl;
+        return 1;
+    }
+
+    std::cout << "✅ Done in " << elapsed << "s ("
+              << static_cast<long long>(elapsed > 0 ? result.rowsImported / elapsed : 0) << " rows/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,223 @@
+#include "tools/loadgen/http_client.h"
+#include <sys/socket.h>
+#include <poll.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+HttpClient::HttpClient(const std::string& host, int port, int timeoutMs)
+    : host_(host), port_(port), timeoutMs_(timeoutMs) {}
+
+HttpClient::~HttpClient() {
+    disconnect();
+}
+
+HttpResponse HttpClient::get(const std::string& path, const std::string& token) {
+    return request("GET", path, "", token);
+}
+
+HttpResponse HttpClient::post(const std::string& path, const std::string& body, const std::string& token) {
+    return request("POST", path, body, token);
+}
+
+HttpResponse HttpClient::request(const std::string& method, const std::string& path,
+                                 const std::string& body, const std::string& token) {
+    std::string req;
+    req.reserve(256 + body.size());
+    req += method + " " + path + " HTTP/1.1\r\n";
+    req += "Host: " + host_ + ":" + std::to_string(port_) + "\r\n";
+    req += "Connection: keep-alive\r\n";
+    if (!token.empty()) {
+        req += "Authorization: Bearer " + token + "\r\n";
+    }
+    if (!body.empty() || method == "POST") {
+        req += "Content-Type: application/json\r\n";
+        req += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    req += "\r\n";
+    req += body;
+
+    HttpResponse response;
+
+    // A kept-alive connection the server closed while idle is replaced
+    // before sending. If a reused connection still fails, only GETs are
+    // retried on a fresh one: a POST may already have been applied, and
+    // sending it again would move money twice.
+    if (fd_ >= 0 && isClosedByPeer()) {
+        disconnect();
+    }
+    bool idempotent = method == "GET" || method == "HEAD";
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        bool reused = fd_ >= 0;
+        if (fd_ < 0 && !connect(response.error)) {
+            return response;
+        }
+
+        bool keepAlive = true;
+        if (sendAll(req, response.error) && readResponse(response, keepAlive)) {
+            if (!keepAlive) {
+                disconnect();
+            }
+            return response;
+        }
+
+        disconnect();
+        if (!reused || !idempotent) {
+            break;
+        }
+        response = HttpResponse{};
+    }
+
+    response.status = 0;
+    return response;
+}
+
+bool HttpClient::connect(std::string& error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* result = nullptr;
+    int rc = getaddrinfo(host_.c_str(), std::to_string(port_).c_str(), &hints, &result);
+    if (rc != 0) {
+        error = std::string("resolve failed: ") + gai_strerror(rc);
+        return false;
+    }
+
+    for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            timeval tv{};
+            tv.tv_sec = timeoutMs_ / 1000;
+            tv.tv_usec = (timeoutMs_ % 1000) * 1000;
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+            fd_ = fd;
+            break;
+        }
+        ::close(fd);
+    }
+    freeaddrinfo(result);
+
+    if (fd_ < 0) {
+        error = std::string("connect failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    readBuffer_.clear();
+    return true;
+}
+
+bool HttpClient::isClosedByPeer() {
+    // An idle keep-alive connection has nothing to read; readable means the
+    // server closed it (or sent something unsolicited, equally unusable)
+    pollfd pfd{ fd_, POLLIN, 0 };
+    return ::poll(&pfd, 1, 0) != 0;
+}
+
+void HttpClient::disconnect() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    readBuffer_.clear();
+}
+
+bool HttpClient::sendAll(const std::string& data, std::string& error) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            error = std::string("send failed: ") + std::strerror(errno);
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool HttpClient::readResponse(HttpResponse& response, bool& keepAlive) {
+    char chunk[16384];
+
+    auto fill = [&]() -> bool {
+        ssize_t n;
+        do {
+            n = ::recv(fd_, chunk, sizeof(chunk), 0);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) {
+            response.error = n == 0 ? "connection closed" : std::string("recv failed: ") + std::strerror(errno);
+            return false;
+        }
+        readBuffer_.append(chunk, static_cast<size_t>(n));
+        return true;
+    };
+
+    size_t headerEnd;
+    while ((headerEnd = readBuffer_.find("\r\n\r\n")) == std::string::npos) {
+        if (!fill()) {
+            return false;
+        }
+    }
+
+    // Status line: HTTP/1.1 200 OK
+    size_t lineEnd = readBuffer_.find("\r\n");
+    size_t space = readBuffer_.find(' ');
+    if (space == std::string::npos || space > lineEnd) {
+        response.error = "malformed status line";
+        return false;
+    }
+    response.status = std::atoi(readBuffer_.c_str() + space + 1);
+
+    size_t contentLength = 0;
+    keepAlive = true;
+    size_t pos = lineEnd + 2;
+    while (pos < headerEnd) {
+        size_t next = readBuffer_.find("\r\n", pos);
+        std::string line = readBuffer_.substr(pos, next - pos);
+        pos = next + 2;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        std::string value = line.substr(colon + 1);
+        value.erase(0, value.find_first_not_of(' '));
+
+        if (name == "content-length") {
+            contentLength = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+        } else if (name == "connection" && (value == "close" || value == "Close")) {
+            keepAlive = false;
+        }
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    while (readBuffer_.size() - bodyStart < contentLength) {
+        if (!fill()) {
+            return false;
+        }
+    }
+
+    response.body = readBuffer_.substr(bodyStart, contentLength);
+    readBuffer_.erase(0, bodyStart + contentLength);
+    return true;
+}
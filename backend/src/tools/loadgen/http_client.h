@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+struct HttpResponse {
+    int status = 0;          // 0 means the request never got a response (connect/IO error)
+    std::string body;
+    std::string error;
+
+    bool ok() const { return status >= 200 && status < 300; }
+};
+
+// Minimal blocking HTTP/1.1 client with keep-alive, good enough to drive
+// the NovaBank API from the load generator. One instance = one connection.
+class HttpClient {
+public:
+    HttpClient(const std::string& host, int port, int timeoutMs = 10000);
+    ~HttpClient();
+
+    // Prevent copying
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    HttpResponse get(const std::string& path, const std::string& token = "");
+    HttpResponse post(const std::string& path, const std::string& body, const std::string& token = "");
+
+    HttpResponse request(const std::string& method, const std::string& path,
+                         const std::string& body, const std::string& token);
+
+private:
+    std::string host_;
+    int port_;
+    int timeoutMs_;
+    int fd_ = -1;
+    std::string readBuffer_;
+
+    bool connect(std::string& error);
+    void disconnect();
+    // True when the idle connection can no longer be used
+    bool isClosedByPeer();
+    bool sendAll(const std::string& data, std::string& error);
+    bool readResponse(HttpResponse& response, bool& keepAlive);
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+// Log-linear latency histogram (HdrHistogram-style). Values are recorded in
+// microseconds with ~1.5% relative precision: 64 linear sub-buckets per
+// power of two. Fixed size, no allocation on record, cheap to merge.
+class LatencyHistogram {
+public:
+    void record(uint64_t micros) {
+        ++counts_[indexFor(std::min(micros, kMaxValue))];
+        ++total_;
+        max_ = std::max(max_, micros);
+        min_ = std::min(min_, micros);
+        sum_ += micros;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+        min_ = std::min(min_, other.min_);
+        sum_ += other.sum_;
+    }
+
+    // Value at the given percentile (0-100), in microseconds
+    uint64_t percentile(double p) const {
+        if (total_ == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total_) + 0.5);
+        target = std::max<uint64_t>(1, std::min(target, total_));
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += counts_[i];
+            if (seen >= target) {
+                return std::min(valueFor(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return total_; }
+    uint64_t max() const { return total_ ? max_ : 0; }
+    uint64_t min() const { return total_ ? min_ : 0; }
+    double mean() const { return total_ ? static_cast<double>(sum_) / static_cast<double>(total_) : 0.0; }
+
+private:
+    static constexpr int kSubBucketBits = 6;
+    static constexpr uint64_t kSubBucketCount = 1ULL << kSubBucketBits;
+    static constexpr uint64_t kMaxValue = (1ULL << 40) - 1;  // ~12 days, plenty
+    static constexpr size_t kBucketCount = (40 - kSubBucketBits + 1) * kSubBucketCount;
+
+    std::array<uint64_t, kBucketCount> counts_{};
+    uint64_t total_ = 0;
+    uint64_t max_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t sum_ = 0;
+
+    static size_t indexFor(uint64_t value) {
+        if (value < kSubBucketCount) {
+            return static_cast<size_t>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - kSubBucketBits;
+        uint64_t sub = (value >> shift) & (kSubBucketCount - 1);
+        return static_cast<size_t>((static_cast<uint64_t>(shift) + 1) * kSubBucketCount + sub);
+    }
+
+    // Upper edge of the bucket, so percentiles are never under-reported
+    static uint64_t valueFor(size_t index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        uint64_t shift = index / kSubBucketCount - 1;
+        uint64_t sub = index % kSubBucketCount;
+        return ((kSubBucketCount + sub + 1) << shift) - 1;
+    }
+};
@@ -0,0 +1,500 @@
+// NovaBank load generator
+//
+// Logs in a population of synthetic users, gives each one a funded checking
+// account and then drives a weighted mix of banking operations against a
+// running novabank server at a fixed target rate.
+//
+// Every connection follows a request schedule (start + k * interval) and
+// latency is measured from the *intended* start time, so a stalled server is
+// charged for the requests it delayed (coordinated-omission correction).
+// Service time (actual send -> response) is reported alongside.
+//
+// Usage:
+//   novabank_loadgen [--host 127.0.0.1] [--port 8080] [--users 100]
+//                    [--connections 8] [--rate 500] [--duration 30]
+//                    [--warmup 5] [--seed 42]
+//                    [--mix deposit=30,withdraw=15,transfer=30,history=20,admin=5]
+//                    [--fail-below-rps N] [--max-p99-ms N]
+
+#include "tools/loadgen/http_client.h"
+#include "tools/loadgen/latency_histogram.h"
+#include <nlohmann/json.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+namespace {
+
+enum class OpType { Deposit, Withdraw, Transfer, History, Admin, Count };
+
+constexpr size_t kOpCount = static_cast<size_t>(OpType::Count);
+const char* const kOpNames[kOpCount] = { "deposit", "withdraw", "transfer", "history", "admin" };
+
+struct LoadgenOptions {
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    int users = 100;
+    int connections = 8;
+    double rate = 500.0;        // total requests per second across all connections
+    int durationSec = 30;
+    int warmupSec = 5;
+    uint64_t seed = 42;
+    std::array<int, kOpCount> mix = { 30, 15, 30, 20, 5 };
+    double failBelowRps = 0.0;
+    double maxP99Ms = 0.0;
+};
+
+struct SyntheticUser {
+    int userId = 0;
+    std::string username;
+    std::string token;
+    int accountId = 0;
+    std::string accountNumber;
+};
+
+struct OpStats {
+    LatencyHistogram latency;   // intended start -> response (CO-corrected)
+    LatencyHistogram service;   // actual send -> response
+    uint64_t errors = 0;
+    std::map<int, uint64_t> statusCounts;
+
+    void merge(const OpStats& other) {
+        latency.merge(other.latency);
+        service.merge(other.service);
+        errors += other.errors;
+        for (const auto& [status, count] : other.statusCounts) {
+            statusCounts[status] += count;
+        }
+    }
+};
+
+const std::string kApi = "/api/v1";
+const std::string kUserPin = "1234";
+
+void printUsage() {
+    std::cerr << "Usage: novabank_loadgen [--host H] [--port P] [--users N] [--connections N]\n"
+              << "                        [--rate RPS] [--duration SEC] [--warmup SEC] [--seed N]\n"
+              << "                        [--mix deposit=30,withdraw=15,transfer=30,history=20,admin=5]\n"
+              << "                        [--fail-below-rps RPS] [--max-p99-ms MS]" << std::endl;
+}
+
+bool parseMix(const std::string& spec, std::array<int, kOpCount>& mix) {
+    std::array<int, kOpCount> parsed{};
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            return false;
+        }
+        std::string name = item.substr(0, eq);
+        int weight = std::atoi(item.c_str() + eq + 1);
+        bool known = false;
+        for (size_t i = 0; i < kOpCount; ++i) {
+            if (name == kOpNames[i]) {
+                parsed[i] = weight;
+                known = true;
+            }
+        }
+        if (!known || weight < 0) {
+            return false;
+        }
+    }
+    int total = 0;
+    for (int w : parsed) {
+        total += w;
+    }
+    if (total <= 0) {
+        return false;
+    }
+    mix = parsed;
+    return true;
+}
+
+bool parseArgs(int argc, char* argv[], LoadgenOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--host") {
+            options.host = value;
+        } else if (arg == "--port") {
+            options.port = std::atoi(value.c_str());
+        } else if (arg == "--users") {
+            options.users = std::atoi(value.c_str());
+        } else if (arg == "--connections") {
+            options.connections = std::atoi(value.c_str());
+        } else if (arg == "--rate") {
+            options.rate = std::atof(value.c_str());
+        } else if (arg == "--duration") {
+            options.durationSec = std::atoi(value.c_str());
+        } else if (arg == "--warmup") {
+            options.warmupSec = std::atoi(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--mix") {
+            if (!parseMix(value, options.mix)) {
+                std::cerr << "Invalid --mix specification: " << value << std::endl;
+                return false;
+            }
+        } else if (arg == "--fail-below-rps") {
+            options.failBelowRps = std::atof(value.c_str());
+        } else if (arg == "--max-p99-ms") {
+            options.maxP99Ms = std::atof(value.c_str());
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (options.users <= 0 || options.connections <= 0 || options.rate <= 0 || options.durationSec <= 0) {
+        std::cerr << "users, connections, rate and duration must be positive" << std::endl;
+        return false;
+    }
+    if (options.connections > options.users) {
+        options.connections = options.users;
+    }
+    return true;
+}
+
+std::string login(HttpClient& client, const std::string& username, const std::string& pin) {
+    json body = { {"username", username}, {"pin", pin} };
+    auto response = client.post(kApi + "/auth/login", body.dump());
+    if (!response.ok()) {
+        return "";
+    }
+    auto parsed = json::parse(response.body, nullptr, false);
+    if (parsed.is_discarded() || !parsed.contains("token")) {
+        return "";
+    }
+    return parsed["token"].get<std::string>();
+}
+
+// Create, log in and fund one synthetic user. Account creation goes through
+// the admin so the account can be opened with an initial balance.
+bool createSyntheticUser(HttpClient& client, const std::string& adminToken,
+                         const std::string& username, SyntheticUser& user) {
+    json createBody = { {"username", username}, {"pin", kUserPin}, {"userType", "standard"} };
+    auto created = client.post(kApi + "/users", createBody.dump(), adminToken);
+    if (!created.ok()) {
+        std::cerr << "Failed to create user " << username << " (status " << created.status << ") "
+                  << created.body << created.error << std::endl;
+        return false;
+    }
+    auto createdJson = json::parse(created.body, nullptr, false);
+    if (createdJson.is_discarded()) {
+        return false;
+    }
+    user.userId = createdJson["id"].get<int>();
+    user.username = username;
+
+    json accountBody = { {"userId", user.userId}, {"accountType", "checking"}, {"initialBalance", 1000000.0} };
+    auto account = client.post(kApi + "/accounts", accountBody.dump(), adminToken);
+    if (!account.ok()) {
+        std::cerr << "Failed to create account for " << username << " (status " << account.status << ")" << std::endl;
+        return false;
+    }
+    auto accountJson = json::parse(account.body, nullptr, false);
+    if (accountJson.is_discarded()) {
+        return false;
+    }
+    user.accountId = accountJson["id"].get<int>();
+    user.accountNumber = accountJson["accountNumber"].get<std::string>();
+
+    user.token = login(client, username, kUserPin);
+    return !user.token.empty();
+}
+
+std::string formatAmount(double amount) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.2f", amount);
+    return buffer;
+}
+
+class Worker {
+public:
+    Worker(const LoadgenOptions& options, int index, std::vector<SyntheticUser> users)
+        : options_(options), index_(index), users_(std::move(users)),
+          client_(options.host, options.port), rng_(options.seed * 1000003ULL + static_cast<uint64_t>(index)) {
+        int total = 0;
+        for (size_t i = 0; i < kOpCount; ++i) {
+            total += options_.mix[i];
+            cumulativeMix_[i] = total;
+        }
+    }
+
+    void run(const std::vector<std::string>* allAccounts, const std::string* adminToken,
+             Clock::time_point start, Clock::time_point measureFrom, Clock::time_point end) {
+        allAccounts_ = allAccounts;
+        adminToken_ = adminToken;
+
+        auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(options_.connections) / options_.rate));
+        // Stagger connections so they don't all fire on the same tick
+        auto intended = start + interval * index_ / options_.connections;
+
+        while (intended < end) {
+            std::this_thread::sleep_until(intended);
+
+            OpType op = pickOp();
+            auto sendTime = Clock::now();
+            int status = execute(op);
+            auto done = Clock::now();
+
+            if (intended >= measureFrom) {
+                auto& stats = stats_[static_cast<size_t>(op)];
+                stats.latency.record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(done - intended).count()));
+                stats.service.record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(done - sendTime).count()));
+                stats.statusCounts[status]++;
+                if (status < 200 || status >= 300) {
+                    stats.errors++;
+                }
+            }
+
+            intended += interval;
+        }
+    }
+
+    const std::array<OpStats, kOpCount>& stats() const { return stats_; }
+
+private:
+    const LoadgenOptions& options_;
+    int index_;
+    std::vector<SyntheticUser> users_;
+    HttpClient client_;
+    std::mt19937_64 rng_;
+    std::array<int, kOpCount> cumulativeMix_{};
+    std::array<OpStats, kOpCount> stats_;
+    const std::vector<std::string>* allAccounts_ = nullptr;
+    const std::string* adminToken_ = nullptr;
+
+    OpType pickOp() {
+        std::uniform_int_distribution<int> dist(1, cumulativeMix_[kOpCount - 1]);
+        int roll = dist(rng_);
+        for (size_t i = 0; i < kOpCount; ++i) {
+            if (roll <= cumulativeMix_[i]) {
+                return static_cast<OpType>(i);
+            }
+        }
+        return OpType::History;
+    }
+
+    double randomAmount(double maxAmount) {
+        std::uniform_int_distribution<int> cents(100, static_cast<int>(maxAmount * 100));
+        return cents(rng_) / 100.0;
+    }
+
+    int execute(OpType op) {
+        std::uniform_int_distribution<size_t> pickUser(0, users_.size() - 1);
+        const SyntheticUser& user = users_[pickUser(rng_)];
+
+        switch (op) {
+            case OpType::Deposit: {
+                std::string body = "{\"accountNumber\":\"" + user.accountNumber +
+                                   "\",\"amount\":" + formatAmount(randomAmount(500.0)) +
+                                   ",\"description\":\"loadgen deposit\"}";
+                return client_.post(kApi + "/transactions/deposit", body, user.token).status;
+            }
+            case OpType::Withdraw: {
+                std::string body = "{\"accountNumber\":\"" + user.accountNumber +
+                                   "\",\"amount\":" + formatAmount(randomAmount(50.0)) +
+                                   ",\"description\":\"loadgen withdrawal\"}";
+                return client_.post(kApi + "/transactions/withdraw", body, user.token).status;
+            }
+            case OpType::Transfer: {
+                std::uniform_int_distribution<size_t> pickAccount(0, allAccounts_->size() - 1);
+                std::string to = (*allAccounts_)[pickAccount(rng_)];
+                if (to == user.accountNumber) {
+                    to = (*allAccounts_)[(pickAccount(rng_) + 1) % allAccounts_->size()];
+                }
+                if (to == user.accountNumber) {
+                    return client_.get(kApi + "/accounts", user.token).status;
+                }
+                std::string body = "{\"fromAccountNumber\":\"" + user.accountNumber +
+                                   "\",\"toAccountNumber\":\"" + to +
+                                   "\",\"amount\":" + formatAmount(randomAmount(50.0)) +
+                                   ",\"description\":\"loadgen transfer\"}";
+                return client_.post(kApi + "/transactions/transfer", body, user.token).status;
+            }
+            case OpType::History: {
+                // Half the history pages are per-account, half are the per-user view
+                std::string path = kApi + "/transactions?limit=20";
+                if (rng_() & 1) {
+                    path += "&accountId=" + std::to_string(user.accountId);
+                }
+                return client_.get(path, user.token).status;
+            }
+            case OpType::Admin: {
+                std::string path = (rng_() & 1) ? kApi + "/admin/users" : kApi + "/accounts";
+                return client_.get(path, *adminToken_).status;
+            }
+            case OpType::Count:
+                break;
+        }
+        return 0;
+    }
+};
+
+double toMs(uint64_t micros) {
+    return static_cast<double>(micros) / 1000.0;
+}
+
+void printRow(const char* name, const OpStats& stats, double seconds) {
+    uint64_t count = stats.latency.count();
+    double errorRate = count ? 100.0 * static_cast<double>(stats.errors) / static_cast<double>(count) : 0.0;
+    std::printf("%-10s %9llu %9.1f %7.2f%% %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+                name,
+                static_cast<unsigned long long>(count),
+                static_cast<double>(count) / seconds,
+                errorRate,
+                toMs(stats.latency.percentile(50)),
+                toMs(stats.latency.percentile(90)),
+                toMs(stats.latency.percentile(99)),
+                toMs(stats.latency.percentile(99.9)),
+                toMs(stats.latency.max()),
+                toMs(stats.service.percentile(99)));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadgenOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::cout << "🏦 NovaBank load generator -> " << options.host << ":" << options.port << std::endl;
+
+    HttpClient adminClient(options.host, options.port);
+    std::string adminToken = login(adminClient, "admin", "0000");
+    if (adminToken.empty()) {
+        std::cerr << "❌ Admin login failed - is novabank running?" << std::endl;
+        return 1;
+    }
+
+    // Setup: each connection creates its own share of the synthetic users
+    std::cout << "👥 Creating " << options.users << " synthetic users..." << std::endl;
+    uint64_t runId = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()) % 1000000007ULL;
+    std::vector<std::vector<SyntheticUser>> usersPerWorker(static_cast<size_t>(options.connections));
+    std::atomic<bool> setupFailed{false};
+    {
+        std::vector<std::thread> threads;
+        for (int w = 0; w < options.connections; ++w) {
+            threads.emplace_back([&, w]() {
+                HttpClient client(options.host, options.port);
+                for (int i = w; i < options.users && !setupFailed; i += options.connections) {
+                    SyntheticUser user;
+                    std::string username = "lg" + std::to_string(runId) + "_" + std::to_string(i);
+                    if (!createSyntheticUser(client, adminToken, username, user)) {
+                        setupFailed = true;
+                        return;
+                    }
+                    usersPerWorker[static_cast<size_t>(w)].push_back(std::move(user));
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    if (setupFailed) {
+        std::cerr << "❌ Setup failed" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> allAccounts;
+    for (const auto& users : usersPerWorker) {
+        for (const auto& user : users) {
+            allAccounts.push_back(user.accountNumber);
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int w = 0; w < options.connections; ++w) {
+        workers.push_back(std::make_unique<Worker>(options, w, std::move(usersPerWorker[static_cast<size_t>(w)])));
+    }
+
+    std::cout << "🚀 Running " << options.rate << " req/s over " << options.connections
+              << " connections for " << options.durationSec << "s (+" << options.warmupSec << "s warmup)" << std::endl;
+
+    auto start = Clock::now() + std::chrono::milliseconds(100);
+    auto measureFrom = start + std::chrono::seconds(options.warmupSec);
+    auto end = measureFrom + std::chrono::seconds(options.durationSec);
+    {
+        std::vector<std::thread> threads;
+        for (auto& worker : workers) {
+            threads.emplace_back([&, w = worker.get()]() {
+                w->run(&allAccounts, &adminToken, start, measureFrom, end);
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // Report
+    std::array<OpStats, kOpCount> totals;
+    OpStats overall;
+    for (const auto& worker : workers) {
+        for (size_t i = 0; i < kOpCount; ++i) {
+            totals[i].merge(worker->stats()[i]);
+            overall.merge(worker->stats()[i]);
+        }
+    }
+
+    double seconds = static_cast<double>(options.durationSec);
+    std::printf("\n%-10s %9s %9s %8s %9s %9s %9s %9s %9s %9s\n",
+                "op", "count", "rps", "errors", "p50 ms", "p90 ms", "p99 ms", "p99.9 ms", "max ms", "svc p99");
+    for (size_t i = 0; i < kOpCount; ++i) {
+        if (totals[i].latency.count() > 0) {
+            printRow(kOpNames[i], totals[i], seconds);
+        }
+    }
+    printRow("total", overall, seconds);
+
+    if (!overall.statusCounts.empty()) {
+        std::printf("\nstatus codes:");
+        for (const auto& [status, count] : overall.statusCounts) {
+            std::printf(" %d=%llu", status, static_cast<unsigned long long>(count));
+        }
+        std::printf("  (0 = connection/IO error)\n");
+    }
+
+    // Regression gates
+    int exitCode = 0;
+    double achievedRps = static_cast<double>(overall.latency.count()) / seconds;
+    if (options.failBelowRps > 0 && achievedRps < options.failBelowRps) {
+        std::cerr << "❌ Throughput " << achievedRps << " req/s below threshold " << options.failBelowRps << std::endl;
+        exitCode = 2;
+    }
+    double p99Ms = toMs(overall.latency.percentile(99));
+    if (options.maxP99Ms > 0 && p99Ms > options.maxP99Ms) {
+        std::cerr << "❌ p99 latency " << p99Ms << " ms above threshold " << options.maxP99Ms << " ms" << std::endl;
+        exitCode = 2;
+    }
+
+    return exitCode;
+}
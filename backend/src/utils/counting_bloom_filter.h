@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+// Counting Bloom filter over strings. mightContain() never gives a false
+// negative for a key that was added and not removed; it answers true for
+// absent keys at roughly the configured false positive rate while the
+// filter holds no more than its capacity.
+//
+// Each slot is an 8-bit counter so keys can be removed. Counters saturate at
+// 255 and are then never decremented, which can only leave extra positives.
+// add, remove and mightContain are safe to call concurrently.
+class CountingBloomFilter {
+public:
+    CountingBloomFilter(size_t capacity, double falsePositiveRate) {
+        capacity = capacity > 0 ? capacity : 1;
+        double ln2 = std::log(2.0);
+        double bits = -static_cast<double>(capacity) * std::log(falsePositiveRate) / (ln2 * ln2);
+        slotCount_ = static_cast<size_t>(std::ceil(bits)) | 1;
+        hashCount_ = static_cast<int>(std::lround(bits / static_cast<double>(capacity) * ln2));
+        hashCount_ = hashCount_ < 1 ? 1 : hashCount_;
+        slots_ = std::make_unique<std::atomic<uint8_t>[]>(slotCount_);
+    }
+
+    void add(std::string_view key) {
+        forEachSlot(key, [](std::atomic<uint8_t>& slot) {
+            uint8_t value = slot.load(std::memory_order_relaxed);
+            while (value < kSaturated &&
+                   !slot.compare_exchange_weak(value, value + 1, std::memory_order_relaxed)) {
+            }
+        });
+    }
+
+    void remove(std::string_view key) {
+        forEachSlot(key, [](std::atomic<uint8_t>& slot) {
+            uint8_t value = slot.load(std::memory_order_relaxed);
+            while (value > 0 && value < kSaturated &&
+                   !slot.compare_exchange_weak(value, value - 1, std::memory_order_relaxed)) {
+            }
+        });
+    }
+
+    bool mightContain(std::string_view key) const {
+        bool present = true;
+        forEachSlot(key, [&present](const std::atomic<uint8_t>& slot) {
+            present = present && slot.load(std::memory_order_relaxed) > 0;
+        });
+        return present;
+    }
+
+    size_t slotCount() const { return slotCount_; }
+    int hashCount() const { return hashCount_; }
+
+private:
+    static constexpr uint8_t kSaturated = 255;
+
+    size_t slotCount_ = 0;
+    int hashCount_ = 0;
+    std::unique_ptr<std::atomic<uint8_t>[]> slots_;
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // Double hashing: slot i is h1 + i * h2, with h2 odd so the probes differ
+    template <typename Visit>
+    void forEachSlot(std::string_view key, Visit visit) const {
+        uint64_t h1 = mix(std::hash<std::string_view>{}(key));
+        uint64_t h2 = mix(h1 ^ 0x9e3779b97f4a7c15ULL) | 1;
+        for (int i = 0; i < hashCount_; ++i) {
+            visit(slots_[(h1 + static_cast<uint64_t>(i) * h2) % slotCount_]);
+        }
+    }
+};
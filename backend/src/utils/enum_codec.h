@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+// Two-way mapping between an enum whose values run 0..N-1 and its wire
+// names. The enum value is also the integer code stored in the database, so
+// storage is a cast and only JSON and file formats go through the name table.
+// Both directions are constexpr: a codec declared constexpr costs nothing at
+// startup and can be checked with static_assert.
+template <typename Enum, size_t N>
+class EnumCodec {
+public:
+    using Code = std::underlying_type_t<Enum>;
+
+    constexpr explicit EnumCodec(std::array<std::string_view, N> names) : names_(names) {}
+
+    static constexpr size_t size() { return N; }
+
+    static constexpr int code(Enum value) { return static_cast<int>(value); }
+
+    static constexpr std::optional<Enum> fromCode(int code) {
+        if (code < 0 || static_cast<size_t>(code) >= N) {
+            return std::nullopt;
+        }
+        return static_cast<Enum>(code);
+    }
+
+    constexpr std::string_view name(Enum value) const {
+        size_t index = static_cast<size_t>(value);
+        return index < N ? names_[index] : std::string_view("unknown");
+    }
+
+    constexpr std::optional<Enum> parse(std::string_view name) const {
+        for (size_t i = 0; i < N; ++i) {
+            if (names_[i] == name) {
+                return static_cast<Enum>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    std::array<std::string_view, N> names_;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Short string stored inside the object (no heap allocation), for
+// fixed-format identifiers such as account numbers. Text longer than
+// Capacity is cut to Capacity characters, so validation of the expected
+// length still rejects it.
+template <size_t Capacity>
+class InlineString {
+    static_assert(Capacity < 256, "size is kept in one byte");
+
+public:
+    InlineString() = default;
+    InlineString(std::string_view text) { assign(text); }
+
+    void assign(std::string_view text) {
+        size_ = static_cast<uint8_t>(std::min(text.size(), Capacity));
+        std::copy_n(text.data(), size_, data_);
+        data_[size_] = '\0';
+    }
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    std::string str() const { return std::string(data_, size_); }
+    const char* c_str() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    char data_[Capacity + 1] = {};
+    uint8_t size_ = 0;
+};
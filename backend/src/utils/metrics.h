@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Process-wide operational counters, exposed via GET /api/v1/admin/metrics.
+// Add new counters before Count and give them a name in counterName().
+enum class Counter : size_t {
+    RequestsShed,            // 503: executor queue full
+    DeadlineExpiredInQueue,  // 503: deadline passed before the request started
+    DeadlineExceeded,        // 504: deadline passed while the request was running
+    QueriesAborted,          // statements interrupted by the progress handler
+    AccountLookupsSkipped,   // account number lookups answered by the in-memory filter
+    LogRecordsDropped,       // log calls lost because the thread's log ring was full
+    ArenaRequests,           // requests served with a RequestArena
+    ArenaAllocations,        // allocations taken from request arenas
+    ArenaBytes,              // bytes taken from request arenas
+    ArenaHeapBlocks,         // heap blocks requests needed beyond their thread's arena block
+    ResponseCacheHits,       // GET responses served from the response cache
+    ResponseCacheNotModified,// 304: the client's If-None-Match was still current
+    StreamMessagesSent,      // account events pushed to /api/v1/stream subscribers
+    ChangeBatchesPublished,  // committed change batches delivered to change capture subscribers
+    ChangeBatchesDropped,    // committed change batches lost because the change ring was full
+    Count
+};
+
+constexpr const char* counterName(Counter counter) {
+    switch (counter) {
+        case Counter::RequestsShed: return "requests_shed";
+        case Counter::DeadlineExpiredInQueue: return "deadline_expired_in_queue";
+        case Counter::DeadlineExceeded: return "deadline_exceeded";
+        case Counter::QueriesAborted: return "queries_aborted";
+        case Counter::AccountLookupsSkipped: return "account_lookups_skipped";
+        case Counter::LogRecordsDropped: return "log_records_dropped";
+        case Counter::ArenaRequests: return "arena_requests";
+        case Counter::ArenaAllocations: return "arena_allocations";
+        case Counter::ArenaBytes: return "arena_bytes";
+        case Counter::ArenaHeapBlocks: return "arena_heap_blocks";
+        case Counter::ResponseCacheHits: return "response_cache_hits";
+        case Counter::ResponseCacheNotModified: return "response_cache_not_modified";
+        case Counter::StreamMessagesSent: return "stream_messages_sent";
+        case Counter::ChangeBatchesPublished: return "change_batches_published";
+        case Counter::ChangeBatchesDropped: return "change_batches_dropped";
+        default: return "unknown";
+    }
+}
+
+class Metrics {
+public:
+    static Metrics& getInstance() {
+        static Metrics instance;
+        return instance;
+    }
+
+    void increment(Counter counter, uint64_t by = 1) {
+        counters_[static_cast<size_t>(counter)].fetch_add(by, std::memory_order_relaxed);
+    }
+
+    uint64_t get(Counter counter) const {
+        return counters_[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    }
+
+private:
+    Metrics() = default;
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::Count)> counters_{};
+};
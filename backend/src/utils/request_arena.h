@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include "utils/metrics.h"
+
+// Bump-pointer memory for the temporaries of one request. While an instance
+// is alive, RequestArena::current() on the same thread returns it, and code
+// that builds per-request containers (result batches, response bodies) takes
+// that resource instead of the global heap. Deallocation is a no-op; the
+// whole region goes away at once when the arena is destroyed.
+//
+// Each thread keeps one reusable block, so a request that fits in it never
+// touches the heap; larger ones continue in blocks taken from the heap and
+// freed with the arena. Totals are added to the metrics once per request
+// (arena_requests, arena_allocations, arena_bytes, arena_heap_blocks).
+class RequestArena final : public std::pmr::memory_resource {
+public:
+    RequestArena()
+        : previous_(active()), block_(acquireBlock()) {
+        if (block_) {
+            monotonic_.emplace(block_, kBlockSize, &upstream_);
+        } else {
+            monotonic_.emplace(&upstream_);
+        }
+        active() = this;
+    }
+
+    ~RequestArena() override {
+        monotonic_.reset();
+        active() = previous_;
+        if (block_) {
+            local().inUse = false;
+        }
+
+        Metrics& metrics = Metrics::getInstance();
+        metrics.increment(Counter::ArenaRequests);
+        metrics.increment(Counter::ArenaAllocations, allocations_);
+        metrics.increment(Counter::ArenaBytes, bytes_);
+        metrics.increment(Counter::ArenaHeapBlocks, upstream_.blocks);
+    }
+
+    // Prevent copying
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    // The innermost arena alive on this thread, or the default resource
+    // outside of one
+    static std::pmr::memory_resource* current() {
+        RequestArena* arena = active();
+        return arena ? static_cast<std::pmr::memory_resource*>(arena) : std::pmr::get_default_resource();
+    }
+
+    uint64_t allocations() const { return allocations_; }
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    // Covers a full history page and its JSON body
+    static constexpr size_t kBlockSize = 256 * 1024;
+
+    // Heap blocks requested by the monotonic resource once the thread's
+    // block is used up
+    struct CountingUpstream : std::pmr::memory_resource {
+        uint64_t blocks = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++blocks;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    struct LocalBlock {
+        std::unique_ptr<std::byte[]> memory;
+        bool inUse = false;
+    };
+
+    static RequestArena*& active() {
+        thread_local RequestArena* arena = nullptr;
+        return arena;
+    }
+
+    static LocalBlock& local() {
+        thread_local LocalBlock block;
+        return block;
+    }
+
+    // The thread's block, or nullptr when an outer arena already holds it
+    static std::byte* acquireBlock() {
+        LocalBlock& block = local();
+        if (block.inUse) {
+            return nullptr;
+        }
+        if (!block.memory) {
+            block.memory = std::make_unique<std::byte[]>(kBlockSize);
+        }
+        block.inUse = true;
+        return block.memory.get();
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations_;
+        bytes_ += bytes;
+        return monotonic_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    RequestArena* previous_;
+    std::byte* block_;
+    CountingUpstream upstream_;
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+    uint64_t allocations_ = 0;
+    uint64_t bytes_ = 0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer/single-consumer queue. One thread claims and
+// publishes slots, one other thread reads and releases them; neither ever
+// blocks or locks. Slots are written in place, so a producer filling a large
+// record pays for the bytes it writes and nothing else.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // Producer: slot to fill, or nullptr when the ring is full. The slot is
+    // invisible to the consumer until publish().
+    T* claim() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ == Capacity) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ == Capacity) {
+                return nullptr;
+            }
+        }
+        return &slots_[head & kMask];
+    }
+
+    void publish() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Producer: slots published but not yet released. Exact once it reaches
+    // half the capacity; below that it may overstate.
+    size_t backlog() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ >= Capacity / 2) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+        }
+        return head - cachedTail_;
+    }
+
+    // Consumer: oldest published slot, or nullptr when empty. Stays valid
+    // until release().
+    const T* front() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cachedHead_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail == cachedHead_) {
+                return nullptr;
+            }
+        }
+        return &slots_[tail & kMask];
+    }
+
+    void release() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+    static constexpr size_t kCacheLine = 64;
+
+    // Each side's index and its cached copy of the other side's index share
+    // a line that the other side only reads
+    alignas(kCacheLine) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+    alignas(kCacheLine) std::array<T, Capacity> slots_{};
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Conversions between the database's "YYYY-MM-DD HH:MM:SS" UTC timestamps
+// and seconds since the epoch, so domain objects can hold an int64 instead
+// of a heap-allocated string. Formatting and parsing are plain arithmetic
+// (no locale, no time zone database) and round-trip exactly.
+class Timestamp {
+public:
+    // Stands for "no timestamp" in int64 fields
+    static constexpr int64_t kUnset = std::numeric_limits<int64_t>::min();
+
+    // Buffer size for formatTo(), including the terminator
+    static constexpr size_t kFormattedSize = 32;
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // "YYYY-MM-DD HH:MM:SS" (a "T" separator is also accepted, and anything
+    // after the seconds is ignored). Dates that do not exist, such as
+    // 2023-02-29 or 2024-04-31, are rejected, as are leap seconds.
+    static std::optional<int64_t> parse(std::string_view text) {
+        if (text.size() < 19 || text[4] != '-' || text[7] != '-' ||
+            (text[10] != ' ' && text[10] != 'T') || text[13] != ':' || text[16] != ':') {
+            return std::nullopt;
+        }
+
+        int year, month, day, hour, minute, second;
+        if (!digits(text, 0, 4, year) || !digits(text, 5, 2, month) || !digits(text, 8, 2, day) ||
+            !digits(text, 11, 2, hour) || !digits(text, 14, 2, minute) || !digits(text, 17, 2, second) ||
+            month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) ||
+            hour > 23 || minute > 59 || second > 59) {
+            return std::nullopt;
+        }
+
+        return daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    }
+
+    static std::string format(int64_t seconds) {
+        char buffer[kFormattedSize];
+        return std::string(buffer, formatTo(seconds, buffer));
+    }
+
+    // Format into a caller's buffer of kFormattedSize bytes (no allocation);
+    // returns the length, 0 for kUnset
+    static size_t formatTo(int64_t seconds, char* buffer) {
+        if (seconds == kUnset) {
+            buffer[0] = '\0';
+            return 0;
+        }
+
+        int64_t days = seconds / 86400;
+        int64_t remainder = seconds % 86400;
+        if (remainder < 0) {
+            remainder += 86400;
+            --days;
+        }
+
+        int year, month, day;
+        civilFromDays(days, year, month, day);
+
+        int length = std::snprintf(buffer, kFormattedSize, "%04d-%02d-%02d %02d:%02d:%02d", year, month, day,
+                                   static_cast<int>(remainder / 3600), static_cast<int>(remainder % 3600 / 60),
+                                   static_cast<int>(remainder % 60));
+        return length > 0 ? std::min(static_cast<size_t>(length), kFormattedSize - 1) : 0;
+    }
+
+    // Parse, or kUnset when the text is empty or malformed
+    static int64_t parseOrUnset(std::string_view text) {
+        return parse(text).value_or(kUnset);
+    }
+
+private:
+    static bool digits(std::string_view text, size_t offset, size_t count, int& value) {
+        value = 0;
+        for (size_t i = offset; i < offset + count; ++i) {
+            if (text[i] < '0' || text[i] > '9') {
+                return false;
+            }
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    }
+
+    static int daysInMonth(int year, int month) {
+        static constexpr int kDays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        return month == 2 && leap ? 29 : kDays[month - 1];
+    }
+
+    // Days since 1970-01-01 in the proleptic Gregorian calendar (H. Hinnant)
+    static int64_t daysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        int64_t era = (year >= 0 ? year : year - 399) / 400;
+        int64_t yearOfEra = year - era * 400;
+        int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    static void civilFromDays(int64_t days, int& year, int& month, int& day) {
+        days += 719468;
+        int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        int64_t dayOfEra = days - era * 146097;
+        int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+        day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+        month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+        year = static_cast<int>(yearOfEra + era * 400 + (month <= 2));
+    }
+};
@@ -97,6 +97,13 @@ echo -e "\n1️⃣2️⃣ Checking user accounts after transfer..."
 curl -s -X GET $BASE_URL/accounts \
   -H "Authorization: Bearer $USER_TOKEN" | jq '.'
 
+echo -e "\n🔁 Polling user accounts again with the ETag (expect 304)..."
+ACCOUNTS_ETAG=$(curl -s -i -X GET $BASE_URL/accounts \
+  -H "Authorization: Bearer $USER_TOKEN" | grep -i "^etag:" | cut -d' ' -f2 | tr -d '\r')
+curl -s -i -X GET $BASE_URL/accounts \
+  -H "Authorization: Bearer $USER_TOKEN" \
+  -H "If-None-Match: $ACCOUNTS_ETAG" | grep -i -E "^(HTTP|etag)"
+
 # Test 12: Test insufficient funds
 echo -e "\n1️⃣3️⃣ Testing transfer with insufficient funds..."
 curl -s -X POST $BASE_URL/accounts/$ACCOUNT_ID/transfer \
@@ -104,4 +111,28 @@ curl -s -X POST $BASE_URL/accounts/$ACCOUNT_ID/transfer \
   -H "Authorization: Bearer $TOKEN" \
   -d '{"amount": 10000.00, "toAccountNumber": "'$USER_ACCOUNT_NUMBER'"}' | jq '.'
 
+# Test 13: Point-in-time balance
+echo -e "\n1️⃣4️⃣ Getting balance as of now and before the account existed..."
+curl -s -X GET "$BASE_URL/accounts/$ACCOUNT_ID/balance?at=$(date -u +%Y-%m-%dT%H:%M:%S)" \
+  -H "Authorization: Bearer $TOKEN" | jq '.'
+curl -s -X GET "$BASE_URL/accounts/$ACCOUNT_ID/balance?at=2000-01-01" \
+  -H "Authorization: Bearer $TOKEN" | jq '.'
+
+echo -e "\n📈 Getting monthly activity summary..."
+curl -s -X GET "$BASE_URL/accounts/$ACCOUNT_ID/summary?granularity=month" \
+  -H "Authorization: Bearer $TOKEN" | jq '.'
+
+# Test 14: Monthly statements
+echo -e "\n1️⃣5️⃣ Closing last month's statements..."
+curl -s -X POST $BASE_URL/admin/statements/close \
+  -H "Authorization: Bearer $TOKEN" | jq '.'
+
+LAST_MONTH=$(date -u -d "$(date -u +%Y-%m-01) -1 day" +%Y-%m)
+echo -e "\n1️⃣6️⃣ Getting statement for $LAST_MONTH..."
+curl -s -i -X GET $BASE_URL/accounts/$ACCOUNT_ID/statements/$LAST_MONTH \
+  -H "Authorization: Bearer $TOKEN" | grep -i -E "^(HTTP|etag|cache-control)"
+
+curl -s -X GET $BASE_URL/accounts/$ACCOUNT_ID/statements \
+  -H "Authorization: Bearer $TOKEN" | jq '.'
+
 echo -e "\n✨ Account tests complete!"
@@ -121,4 +121,27 @@ echo -e "\n1️⃣6️⃣ Getting John's transaction history..."
 curl -s -X GET $BASE_URL/transactions \
   -H "Authorization: Bearer $JOHN_TOKEN" | jq '.transactions | length as $count | "Transaction count: \($count)"'
 
+# Disbursement from John to Alice (two lines)
+echo -e "\n1️⃣7️⃣ Admin disbursing from John to Alice..."
+curl -s -X POST $BASE_URL/admin/disburse \
+  -H "Content-Type: application/json" \
+  -H "Authorization: Bearer $TOKEN" \
+  -d "{\"fromAccountNumber\": \"$JOHN_ACCOUNT_NUMBER\", \"description\": \"Test payroll\", \"credits\": [{\"accountNumber\": \"$ALICE_ACCOUNT_NUMBER\", \"amount\": 10.00}, {\"accountNumber\": \"$ALICE_ACCOUNT_NUMBER\", \"amount\": 5.25}]}" | jq '.'
+
+# Server metrics
+echo -e "\n1️⃣8️⃣ Getting server metrics..."
+curl -s -X GET $BASE_URL/admin/metrics \
+  -H "Authorization: Bearer $TOKEN" | jq '.'
+
+# Log level
+echo -e "\n1️⃣9️⃣ Raising the log level to debug and back..."
+curl -s -X PUT $BASE_URL/admin/log-level \
+  -H "Content-Type: application/json" \
+  -H "Authorization: Bearer $TOKEN" \
+  -d '{"level": "debug"}' | jq '.'
+curl -s -X PUT $BASE_URL/admin/log-level \
+  -H "Content-Type: application/json" \
+  -H "Authorization: Bearer $TOKEN" \
+  -d '{"level": "info"}' | jq '.'
+
 echo -e "\n✨ Admin tests complete!"
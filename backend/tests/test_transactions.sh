@@ -114,4 +114,44 @@ echo -e "\n1️⃣5️⃣ Getting transactions for specific account..."
 curl -s -X GET "$BASE_URL/transactions?accountId=$ACCOUNT_ID" \
   -H "Authorization: Bearer $TOKEN" | jq '.'
 
+# Batch operations
+echo -e "\n1️⃣6️⃣ Atomic batch (deposit, transfer, withdraw)..."
+curl -s -X POST $BASE_URL/transactions/batch \
+  -H "Content-Type: application/json" \
+  -H "Authorization: Bearer $TOKEN" \
+  -d "{\"mode\": \"atomic\", \"operations\": [{\"type\": \"deposit\", \"accountNumber\": \"$ACCOUNT_NUMBER\", \"amount\": 50.00}, {\"type\": \"transfer\", \"fromAccountNumber\": \"$ACCOUNT_NUMBER\", \"toAccountNumber\": \"$USER_ACCOUNT_NUMBER\", \"amount\": 20.00}, {\"type\": \"withdraw\", \"accountNumber\": \"$ACCOUNT_NUMBER\", \"amount\": 10.00}]}" | jq '.'
+
+echo -e "\n1️⃣7️⃣ Best-effort batch with one failing item..."
+curl -s -X POST $BASE_URL/transactions/batch \
+  -H "Content-Type: application/json" \
+  -H "Authorization: Bearer $TOKEN" \
+  -d "{\"mode\": \"best_effort\", \"operations\": [{\"type\": \"deposit\", \"accountNumber\": \"$ACCOUNT_NUMBER\", \"amount\": 5.00}, {\"type\": \"withdraw\", \"accountNumber\": \"$ACCOUNT_NUMBER\", \"amount\": 1000000.00}]}" | jq '.'
+
+# Export
+echo -e "\n1️⃣8️⃣ Exporting jane_doe's history as NDJSON..."
+curl -s -X GET "$BASE_URL/transactions/export?format=ndjson" \
+  -H "Authorization: Bearer $USER_TOKEN"
+
+# Keyset pagination over a customer's history
+echo -e "\n1️⃣9️⃣ Paging jane_doe's history two rows at a time..."
+PAGE=$(curl -s -X GET "$BASE_URL/transactions?limit=2" \
+  -H "Authorization: Bearer $USER_TOKEN")
+echo $PAGE | jq '{count, total, nextCursor}'
+NEXT_CURSOR=$(echo $PAGE | jq -r '.nextCursor // empty')
+if [ -n "$NEXT_CURSOR" ]; then
+  curl -s -X GET "$BASE_URL/transactions?limit=2&cursor=$NEXT_CURSOR" \
+    -H "Authorization: Bearer $USER_TOKEN" | jq '{count, total, nextCursor}'
+fi
+
+# Delta sync: a deposit after a full sync is the only change reported
+echo -e "\n2️⃣0️⃣ Syncing jane_doe's changes since a cursor..."
+SYNC_CURSOR=$(curl -s -X GET "$BASE_URL/sync" \
+  -H "Authorization: Bearer $USER_TOKEN" | jq -r '.cursor')
+curl -s -X POST $BASE_URL/transactions/deposit \
+  -H "Content-Type: application/json" \
+  -H "Authorization: Bearer $USER_TOKEN" \
+  -d "{\"accountNumber\": \"$USER_ACCOUNT_NUMBER\", \"amount\": 15.00, \"description\": \"Sync check\"}" > /dev/null
+curl -s -X GET "$BASE_URL/sync?since=$SYNC_CURSOR" \
+  -H "Authorization: Bearer $USER_TOKEN" | jq '{accounts: (.accounts | length), transactions: [.transactions[].description], cursor, hasMore}'
+
 echo -e "\n✨ Transaction tests complete!"